@@ -0,0 +1,750 @@
+#include "bt656_batch.h"
+#include <Arduino.h>
+#include <sched.h>
+#include <unistd.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+static void publish_frame(bt656_batch_stream_t* stream) {
+    frame_buffer_t* frame = stream->write_frame;
+    frame_buffer_finish_frame(frame, frame_ring_get_last_published(stream->ring));
+
+    frame->frame_number = ++stream->frames;
+    frame->timestamp = micros();
+    frame->frame_complete = true;
+    frame->frame_ready = true;
+
+    stream->write_frame = frame_ring_publish(stream->ring);
+    frame_buffer_reset(stream->write_frame);
+}
+
+// Each stream's decoder carries the stream as its user pointer
+static void batch_line_output(bt656_line_t* line, void* user) {
+    bt656_batch_stream_t* stream = (bt656_batch_stream_t*)user;
+    stream->write_frame->field = line->field ? 1 : 0;
+    frame_buffer_write_line(stream->write_frame, line->row, line->data, line->width);
+}
+
+// Vertical blanking follows every field; a woven frame is complete after field 1
+static void batch_frame_callback(void* user) {
+    bt656_batch_stream_t* stream = (bt656_batch_stream_t*)user;
+    if (stream->write_frame->lines_written > 0 && stream->write_frame->field == 1) {
+        publish_frame(stream);
+    }
+}
+
+static bool claim_stream(bt656_batch_stream_t* stream, uint8_t worker) {
+    uint32_t expected = 0;
+    return __atomic_compare_exchange_n(&stream->owner, &expected, (uint32_t)worker + 1, false,
+                                       __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+// Releasing publishes the stream's decoder state to whichever worker claims it next
+static void release_stream(bt656_batch_stream_t* stream) {
+    __atomic_store_n(&stream->owner, 0, __ATOMIC_RELEASE);
+}
+
+// One turn on a claimed stream: decode a chunk, or publish the last frame once
+// the data is used up. Returns false if the stream had to wait for its consumer.
+static bool run_turn(bt656_batch_t* batch, bt656_batch_stream_t* stream) {
+    // A chunk is shorter than a frame, so it publishes at most once
+    if (batch->config.lossless && frame_ring_has_new_frame(stream->ring)) {
+        return false;
+    }
+
+    if (stream->position < stream->length) {
+        size_t n = stream->length - stream->position;
+        if (n > batch->config.chunk_bytes) n = batch->config.chunk_bytes;
+        bt656_decoder_process_buffer(&stream->decoder, stream->data + stream->position, n);
+        stream->position += n;
+    } else {
+        // Neither an EAV nor vertical blanking follows the last field of a recording
+        bt656_decoder_flush(&stream->decoder);
+        if (stream->write_frame->lines_written > 0) {
+            publish_frame(stream);
+        }
+        __atomic_store_n(&stream->finished, true, __ATOMIC_RELAXED);
+        __atomic_sub_fetch(&batch->remaining, 1, __ATOMIC_RELEASE);
+    }
+
+    stream->chunks++;
+    return true;
+}
+
+// Own streams first, starting with the one decoded last; only when none of them
+// can run does the worker take a turn on another worker's stream
+static void* worker_main(void* arg) {
+    bt656_batch_worker_t* worker = (bt656_batch_worker_t*)arg;
+    bt656_batch_t* batch = worker->batch;
+    uint8_t count = batch->stream_count;
+    uint8_t last = worker->index % count;
+
+    while (__atomic_load_n(&batch->remaining, __ATOMIC_ACQUIRE) > 0) {
+        bool worked = false;
+
+        for (int pass = 0; pass < 2 && !worked; pass++) {
+            bool stealing = pass == 1;
+            for (uint8_t i = 0; i < count && !worked; i++) {
+                uint8_t index = (last + i) % count;
+                bt656_batch_stream_t* stream = &batch->streams[index];
+                if ((stream->home != worker->index) != stealing ||
+                    __atomic_load_n(&stream->finished, __ATOMIC_RELAXED) ||
+                    !claim_stream(stream, worker->index)) {
+                    continue;
+                }
+
+                if (!stream->finished && run_turn(batch, stream)) {
+                    worked = true;
+                    last = index;
+                    worker->stats.chunks++;
+                    if (stealing) {
+                        worker->stats.steals++;
+                        stream->stolen++;
+                    }
+                }
+                release_stream(stream);
+            }
+        }
+
+        if (!worked) {
+            worker->stats.idle_scans++;
+            sched_yield();
+        }
+    }
+    return nullptr;
+}
+
+// ============================================================================
+// Core Batch Functions
+// ============================================================================
+
+bool bt656_batch_init(bt656_batch_t* batch, const bt656_batch_config_t* config) {
+    if (!batch || !config || config->workers == 0 || config->workers > BT656_BATCH_MAX_WORKERS ||
+        config->chunk_bytes == 0) {
+        Serial.println("ERROR: Invalid batch decode configuration");
+        return false;
+    }
+
+    memset(batch, 0, sizeof(bt656_batch_t));
+    batch->config = *config;
+    for (uint8_t i = 0; i < BT656_BATCH_MAX_WORKERS; i++) {
+        batch->workers[i].batch = batch;
+        batch->workers[i].index = i;
+    }
+    return true;
+}
+
+void bt656_batch_deinit(bt656_batch_t* batch) {
+    if (!batch) return;
+
+    bt656_batch_wait(batch);
+    for (uint8_t i = 0; i < batch->stream_count; i++) {
+        bt656_decoder_deinit(&batch->streams[i].decoder);
+    }
+    memset(batch, 0, sizeof(bt656_batch_t));
+}
+
+// Decode `data` into `ring`. Streams are added before bt656_batch_start(); the
+// data must stay valid until the batch is done. Rings may share a frame pool.
+bool bt656_batch_add_stream(bt656_batch_t* batch, const uint8_t* data, size_t length,
+                            const bt656_config_t* decoder_config, frame_ring_t* ring) {
+    if (!batch || !data || !decoder_config || !ring || batch->running) {
+        Serial.println("ERROR: Invalid batch stream");
+        return false;
+    }
+    if (batch->stream_count >= BT656_BATCH_MAX_STREAMS) {
+        Serial.println("ERROR: Too many batch streams");
+        return false;
+    }
+
+    bt656_batch_stream_t* stream = &batch->streams[batch->stream_count];
+    memset(stream, 0, sizeof(bt656_batch_stream_t));
+
+    // Frames are assembled from whole lines
+    bt656_config_t config = *decoder_config;
+    config.enable_line_output = true;
+    if (!bt656_decoder_init(&stream->decoder, &config)) {
+        return false;
+    }
+    bt656_decoder_set_line_output_callback(&stream->decoder, batch_line_output);
+    bt656_decoder_set_frame_callback(&stream->decoder, batch_frame_callback);
+    bt656_decoder_set_user(&stream->decoder, stream);
+
+    stream->data = data;
+    stream->length = length;
+    stream->ring = ring;
+    stream->write_frame = frame_ring_get_write_frame(ring);
+    frame_buffer_reset(stream->write_frame);
+    stream->home = batch->stream_count % batch->config.workers;
+
+    batch->stream_count++;
+    batch->remaining++;
+    return true;
+}
+
+// ============================================================================
+// Run Control
+// ============================================================================
+
+bool bt656_batch_start(bt656_batch_t* batch) {
+    if (!batch || batch->running || batch->stream_count == 0) {
+        return false;
+    }
+
+    uint8_t started = 0;
+    for (uint8_t i = 0; i < batch->config.workers; i++) {
+        if (pthread_create(&batch->workers[i].thread, nullptr, worker_main, &batch->workers[i]) != 0) {
+            Serial.println("ERROR: Failed to start batch decode worker");
+            break;
+        }
+        started++;
+    }
+
+    // Streams homed on a missing worker are picked up by the others as steals
+    batch->config.workers = started;
+    batch->running = started > 0;
+    return batch->running;
+}
+
+bool bt656_batch_is_done(bt656_batch_t* batch) {
+    return batch ? __atomic_load_n(&batch->remaining, __ATOMIC_ACQUIRE) == 0 : true;
+}
+
+void bt656_batch_wait(bt656_batch_t* batch) {
+    if (!batch || !batch->running) return;
+
+    for (uint8_t i = 0; i < batch->config.workers; i++) {
+        pthread_join(batch->workers[i].thread, nullptr);
+    }
+    batch->running = false;
+}
+
+// ============================================================================
+// Split Decoding
+// ============================================================================
+
+// Decoder output recorded by a split part for in-order replay
+#define SPLIT_EVENT_FRAME   0
+#define SPLIT_EVENT_LINE    1    // Followed by width * 2 bytes of UYVY data
+#define SPLIT_EVENT_OUTPUT  2
+
+typedef struct {
+    uint8_t type;
+    bool field;
+    uint16_t value;                // Line number (line and output events)
+    uint16_t row;
+    uint16_t width;
+} split_event_t;
+
+// Where a part starts and the decoder state the sequential decode has there
+typedef struct {
+    size_t start;                  // First byte (an EAV inside vertical blanking)
+    uint16_t line_count;           // Lines since vertical sync
+    bt656_sync_t sync;             // Sync of the preceding SAV
+    uint32_t lines;                // EAVs in the part (line callbacks)
+    uint32_t active_lines;         // Active SAVs in the part (line outputs)
+    uint32_t fields;               // Vertical sync onsets in the part
+} split_part_t;
+
+typedef struct {
+    bt656_decoder_t decoder;       // Local state seeded from the split point
+    const uint8_t* data;
+    size_t length;
+    uint8_t* log;                  // Recorded events, replayed by the caller
+    size_t log_used;
+    pthread_t thread;
+} split_worker_t;
+
+// A part's decoder carries its worker as the user pointer, so the callbacks
+// below append to that worker's log
+static split_event_t* split_record(split_worker_t* worker, uint8_t type, size_t extra) {
+    split_event_t* event = (split_event_t*)(worker->log + worker->log_used);
+    worker->log_used += sizeof(split_event_t) + extra;
+    memset(event, 0, sizeof(split_event_t));
+    event->type = type;
+    return event;
+}
+
+static void split_frame_callback(void* user) {
+    split_record((split_worker_t*)user, SPLIT_EVENT_FRAME, 0);
+}
+
+static void split_line_callback(uint16_t line_number, void* user) {
+    split_record((split_worker_t*)user, SPLIT_EVENT_LINE, 0)->value = line_number;
+}
+
+static void split_line_output(bt656_line_t* line, void* user) {
+    size_t bytes = (size_t)line->width * 2;
+    split_event_t* event = split_record((split_worker_t*)user, SPLIT_EVENT_OUTPUT, bytes);
+    event->field = line->field;
+    event->value = line->line_number;
+    event->row = line->row;
+    event->width = line->width;
+    memcpy(event + 1, line->data, bytes);
+}
+
+// Sync signals of a timing reference control byte, as the decoder reads them
+static bt656_sync_t control_byte_sync(uint8_t control_byte) {
+    bt656_sync_t sync;
+    sync.field = (control_byte & (1 << BT656_FIELD_BIT)) != 0;
+    sync.vsync = (control_byte & (1 << BT656_VSYNC_BIT)) != 0;
+    sync.hsync = (control_byte & (1 << BT656_HSYNC_BIT)) != 0;
+    sync.sav = !sync.hsync;
+    sync.eav = sync.hsync;
+    return sync;
+}
+
+static void* split_worker_main(void* arg) {
+    split_worker_t* worker = (split_worker_t*)arg;
+    bt656_decoder_process_buffer(&worker->decoder, worker->data, worker->length);
+    return nullptr;
+}
+
+// Follow the timing references the way the decoder would and choose up to
+// `count` - 1 split points, each the first suitable EAV past an even share of
+// the buffer. A split EAV lies inside vertical blanking after an SAV with V=1,
+// where the decoder holds no line and carries nothing but its line count and
+// sync. Returns the number of parts (1 = no split point found).
+static uint8_t find_split_points(const bt656_decoder_t* decoder, const uint8_t* data, size_t length,
+                                 uint8_t count, split_part_t* parts) {
+    bt656_state_t state = decoder->state;
+    bt656_sync_t previous = decoder->sync;
+    uint16_t line_count = decoder->line_count;
+    bool blanking = false;         // In the vertical blanking after a sync onset
+    bool edge = false;             // Last EAV counted a new line
+    size_t reference = 0;          // First byte of the current timing reference
+    uint8_t found = 1;
+    size_t target = length / count;
+
+    memset(parts, 0, sizeof(split_part_t) * count);
+
+    size_t i = 0;
+    while (i < length) {
+        if (state == BT656_STATE_IDLE) {
+            const uint8_t* ff = (const uint8_t*)memchr(data + i, BT656_TR_MARKER_FF, length - i);
+            if (!ff) break;
+            i = ff - data;
+            reference = i++;
+            state = BT656_STATE_FF;
+            continue;
+        }
+
+        uint8_t byte = data[i++];
+        if (state == BT656_STATE_FF) {
+            state = byte == BT656_TR_MARKER_00 ? BT656_STATE_FF00 : BT656_STATE_IDLE;
+            continue;
+        }
+        if (state == BT656_STATE_FF00) {
+            state = byte == BT656_TR_MARKER_00 ? BT656_STATE_CONTROL_BYTE : BT656_STATE_IDLE;
+            continue;
+        }
+        if (state != BT656_STATE_CONTROL_BYTE) {
+            state = BT656_STATE_IDLE;
+            continue;
+        }
+
+        bt656_sync_t sync = control_byte_sync(byte);
+        state = BT656_STATE_IDLE;
+
+        if (found < count && reference >= target && reference > 0 && sync.eav && blanking && edge &&
+            previous.sav && previous.vsync) {
+            split_part_t* part = &parts[found++];
+            part->start = reference;
+            part->line_count = line_count;
+            part->sync = previous;
+            target = length / count * found;
+        }
+
+        // Same order as handle_sync_signals()
+        split_part_t* part = &parts[found - 1];
+        if (sync.vsync && !previous.vsync) {
+            line_count = 0;
+            blanking = true;
+            part->fields++;
+        }
+        if (!sync.vsync) {
+            blanking = false;
+        }
+        if (sync.hsync) {
+            edge = !previous.hsync;
+            if (edge) line_count++;
+            part->lines++;
+        }
+        if (sync.sav && !sync.vsync) {
+            part->active_lines++;
+        }
+        previous = sync;
+    }
+    return found;
+}
+
+static void add_stats(bt656_stats_t* total, const bt656_stats_t* part) {
+    total->frames_received += part->frames_received;
+    total->lines_received += part->lines_received;
+    total->pixels_received += part->pixels_received;
+    total->timing_errors += part->timing_errors;
+    total->sync_errors += part->sync_errors;
+    total->data_errors += part->data_errors;
+    total->lines_skipped += part->lines_skipped;
+    if (part->last_frame_time > total->last_frame_time) {
+        total->last_frame_time = part->last_frame_time;
+    }
+}
+
+// Decode `data` with up to `workers` threads, the caller's included, giving the
+// same callbacks, statistics and end state as bt656_decoder_process_buffer().
+// The buffer is cut at vertical blanking, so each part should span a few fields.
+// Later parts decode into a log that is replayed through the callbacks in order
+// once the first part is done. Per-pixel callbacks cannot be replayed cheaply;
+// with those set (or no split point) the buffer is decoded sequentially and
+// false is returned.
+bool bt656_batch_process_buffer(bt656_decoder_t* decoder, const uint8_t* data, size_t length,
+                                uint8_t workers) {
+    if (!decoder || !data) return false;
+    if (workers > BT656_BATCH_MAX_WORKERS) workers = BT656_BATCH_MAX_WORKERS;
+
+    bool per_pixel = decoder->pixel_callback ||
+                     (decoder->config.enable_rgb_conversion && decoder->rgb_callback);
+    split_part_t parts[BT656_BATCH_MAX_WORKERS];
+    uint8_t count = (workers > 1 && !per_pixel) ? find_split_points(decoder, data, length, workers, parts) : 1;
+
+    split_worker_t* splits = nullptr;
+    if (count > 1) {
+        splits = (split_worker_t*)calloc(count, sizeof(split_worker_t));
+    }
+    if (!splits) {
+        bt656_decoder_process_buffer(decoder, data, length);
+        return false;
+    }
+
+    // Parts 1.. start in the state the sequential decode reaches at their EAV
+    uint8_t started = 1;
+    for (uint8_t p = 1; p < count; p++) {
+        split_worker_t* split = &splits[p];
+        size_t end = p + 1 < count ? parts[p + 1].start : length;
+
+        split->decoder = *decoder;
+        bt656_decoder_reset(&split->decoder);
+        memset(&split->decoder.stats, 0, sizeof(bt656_stats_t));
+        split->decoder.sync = parts[p].sync;
+        split->decoder.line_count = parts[p].line_count;
+        split->decoder.frame_started = true;
+        split->decoder.line_started = true;
+        split->decoder.pixel_callback = nullptr;
+        split->decoder.rgb_callback = nullptr;
+        split->decoder.frame_callback = decoder->frame_callback ? split_frame_callback : nullptr;
+        split->decoder.line_callback = decoder->line_callback ? split_line_callback : nullptr;
+        split->decoder.line_output_callback = decoder->line_output_callback ? split_line_output : nullptr;
+        split->decoder.user = split;
+        split->data = data + parts[p].start;
+        split->length = end - parts[p].start;
+
+        size_t log_size = (size_t)(parts[p].lines + parts[p].fields) * sizeof(split_event_t) +
+                          (size_t)parts[p].active_lines * (sizeof(split_event_t) + BT656_LINE_BUFFER_SIZE);
+        split->log = (uint8_t*)malloc(log_size ? log_size : 1);
+        if (!split->log ||
+            pthread_create(&split->thread, nullptr, split_worker_main, split) != 0) {
+            break;
+        }
+        started++;
+    }
+
+    // Parts that did not start are decoded on this thread after the others
+    size_t first_end = parts[1].start;
+    bt656_decoder_process_buffer(decoder, data, first_end);
+
+    for (uint8_t p = 1; p < started; p++) {
+        split_worker_t* split = &splits[p];
+        pthread_join(split->thread, nullptr);
+
+        // Replay in order; the decoder carries on from where the part ended
+        const uint8_t* event_bytes = split->log;
+        const uint8_t* log_end = split->log + split->log_used;
+        while (event_bytes < log_end) {
+            const split_event_t* event = (const split_event_t*)event_bytes;
+            event_bytes += sizeof(split_event_t);
+            if (event->type == SPLIT_EVENT_FRAME) {
+                decoder->frame_callback(decoder->user);
+            } else if (event->type == SPLIT_EVENT_LINE) {
+                decoder->line_callback(event->value, decoder->user);
+            } else {
+                bt656_line_t line;
+                line.data = (uint8_t*)event_bytes;
+                line.width = event->width;
+                line.line_number = event->value;
+                line.row = event->row;
+                line.field = event->field;
+                decoder->line_output_callback(&line, decoder->user);
+                event_bytes += (size_t)event->width * 2;
+            }
+        }
+
+        bt656_stats_t stats = decoder->stats;
+        add_stats(&stats, &split->decoder.stats);
+        bt656_decoder_t caller = *decoder;
+        *decoder = split->decoder;
+        decoder->stats = stats;
+        decoder->pixel_callback = caller.pixel_callback;
+        decoder->rgb_callback = caller.rgb_callback;
+        decoder->frame_callback = caller.frame_callback;
+        decoder->line_callback = caller.line_callback;
+        decoder->line_output_callback = caller.line_output_callback;
+        decoder->user = caller.user;
+    }
+
+    if (started < count) {
+        Serial.println("WARNING: Split decode fell back to one thread for the rest");
+        bt656_decoder_process_buffer(decoder, data + parts[started].start, length - parts[started].start);
+    }
+
+    for (uint8_t p = 1; p < count; p++) {
+        free(splits[p].log);
+    }
+    free(splits);
+    return started == count;
+}
+
+// ============================================================================
+// Status and Statistics Functions
+// ============================================================================
+
+void bt656_batch_print_stats(bt656_batch_t* batch) {
+    if (!batch) return;
+
+    Serial.println("=== Batch Decode Statistics ===");
+    Serial.printf("Workers: %d, Streams: %d, Chunk: %lu bytes\n",
+                  batch->config.workers, batch->stream_count, batch->config.chunk_bytes);
+    for (uint8_t i = 0; i < batch->config.workers; i++) {
+        bt656_batch_worker_stats_t* stats = &batch->workers[i].stats;
+        Serial.printf("Worker %d: %lu chunks, %lu stolen, %lu idle scans\n",
+                      i, stats->chunks, stats->steals, stats->idle_scans);
+    }
+    for (uint8_t i = 0; i < batch->stream_count; i++) {
+        bt656_batch_stream_t* stream = &batch->streams[i];
+        Serial.printf("Stream %d: %lu frames, %lu chunks (%lu stolen), %s\n",
+                      i, stream->frames, stream->chunks, stream->stolen,
+                      stream->finished ? "done" : "running");
+    }
+    Serial.println("===============================");
+}
+
+// Timed runs per worker count after one untimed warm-up; the fastest is kept
+#define BATCH_BENCHMARK_RUNS 5
+
+// One benchmark pass over every ring; returns false if the workers failed to start
+static bool time_batch_pass(bt656_batch_t* batch, const bt656_batch_config_t* config,
+                            const uint8_t* recording, size_t length, const bt656_config_t* decoder_config,
+                            frame_ring_t* rings, uint8_t ready,
+                            uint32_t* elapsed_us, uint32_t* delivered, uint32_t* steals) {
+    bt656_batch_init(batch, config);
+    for (uint8_t s = 0; s < ready; s++) {
+        frame_ring_reset_stats(&rings[s]);
+        bt656_batch_add_stream(batch, recording, length, decoder_config, &rings[s]);
+    }
+
+    uint32_t start = micros();
+    if (!bt656_batch_start(batch)) {
+        bt656_batch_deinit(batch);
+        return false;
+    }
+    bt656_batch_wait(batch);
+    *elapsed_us = micros() - start;
+    if (*elapsed_us == 0) *elapsed_us = 1;
+
+    *delivered = 0;
+    *steals = 0;
+    for (uint8_t s = 0; s < ready; s++) {
+        *delivered += rings[s].stats.frames_published;
+    }
+    for (uint8_t w = 0; w < config->workers; w++) {
+        *steals += batch->workers[w].stats.steals;
+    }
+    bt656_batch_deinit(batch);
+    return true;
+}
+
+// Decode `streams` copies of a synthetic `frames`-frame PAL recording with
+// 1, 2, 4 and 8 workers and report the speedup over a single worker.
+// Each worker count gets a warm-up pass, then the fastest of
+// BATCH_BENCHMARK_RUNS timed passes is reported.
+void bt656_batch_run_benchmark(uint8_t streams, uint16_t frames) {
+    const uint16_t blanking_lines = BT656_PAL_FIELD_LINES - BT656_PAL_ACTIVE_LINES / 2;
+    const size_t frame_bytes = (size_t)(BT656_PAL_FIELD_LINES * 2 + 1) * BT656_TEST_LINE_SIZE;
+
+    if (streams == 0) streams = 1;
+    if (streams > BT656_BATCH_MAX_STREAMS) streams = BT656_BATCH_MAX_STREAMS;
+    if (frames == 0) frames = 1;
+
+    // Streams only read their data, so they all share one recording
+    uint8_t* recording = (uint8_t*)malloc(frame_bytes * frames);
+    frame_ring_t* rings = (frame_ring_t*)calloc(streams, sizeof(frame_ring_t));
+    bt656_batch_t* batch = (bt656_batch_t*)malloc(sizeof(bt656_batch_t));
+    if (!recording || !rings || !batch) {
+        Serial.println("ERROR: Failed to allocate benchmark buffers");
+        if (recording) free(recording);
+        if (rings) free(rings);
+        if (batch) free(batch);
+        return;
+    }
+
+    uint8_t* p = recording;
+    for (uint16_t f = 0; f < frames; f++) {
+        for (int field = 0; field < 2; field++) {
+            uint16_t field_lines = BT656_PAL_FIELD_LINES + field;
+            for (uint16_t l = 0; l < field_lines; l++) {
+                p += bt656_generate_test_line(p, field, l < blanking_lines + field, l);
+            }
+        }
+    }
+
+    uint8_t ready = 0;
+    while (ready < streams && frame_ring_init(&rings[ready], nullptr, FRAME_WIDTH, FRAME_HEIGHT)) {
+        ready++;
+    }
+
+    bt656_config_t decoder_config = {};
+    decoder_config.expected_width = BT656_PAL_ACTIVE_PIXELS;
+    decoder_config.expected_height = BT656_PAL_ACTIVE_LINES;
+    decoder_config.enable_line_output = true;
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1) cpus = 1;
+
+    Serial.println("=== Batch Decode Benchmark ===");
+    Serial.printf("%d streams of %d PAL frames, best of %d runs\n", ready, frames, BATCH_BENCHMARK_RUNS);
+
+    uint32_t baseline_us = 0;
+    for (uint8_t workers = 1; ready > 0 && workers <= BT656_BATCH_MAX_WORKERS; workers *= 2) {
+        // Nothing consumes the rings here, so they keep only the newest frame
+        bt656_batch_config_t config = BT656_BATCH_DEFAULT_CONFIG;
+        config.workers = workers;
+        config.lossless = false;
+
+        uint32_t elapsed = 0;
+        uint32_t delivered = 0;
+        uint32_t steals = 0;
+        uint32_t best_us = UINT32_MAX;
+        uint32_t best_delivered = 0;
+        uint32_t best_steals = 0;
+        bool started = true;
+        for (int run = 0; run <= BATCH_BENCHMARK_RUNS && started; run++) {
+            started = time_batch_pass(batch, &config, recording, p - recording, &decoder_config,
+                                      rings, ready, &elapsed, &delivered, &steals);
+            // Run 0 warms the caches and thread stacks and is not timed
+            if (started && run > 0 && elapsed < best_us) {
+                best_us = elapsed;
+                best_delivered = delivered;
+                best_steals = steals;
+            }
+        }
+        if (!started) break;
+        if (workers == 1) baseline_us = best_us;
+
+        Serial.printf("%d workers: %lu us, %.1f fps, %lu of %lu frames, %lu steals, %.2fx vs 1 worker on %ld CPUs\n",
+                      workers, best_us, best_delivered * 1000000.0f / best_us, best_delivered,
+                      (uint32_t)ready * frames, best_steals, (float)baseline_us / best_us, cpus);
+    }
+
+    Serial.println("==============================");
+    for (uint8_t s = 0; s < ready; s++) {
+        frame_ring_deinit(&rings[s]);
+    }
+    free(recording);
+    free(rings);
+    free(batch);
+}
+
+static uint32_t split_benchmark_checksum = 0;
+static uint32_t split_benchmark_events = 0;
+
+static void split_benchmark_line_output(bt656_line_t* line, void*) {
+    uint32_t sum = ((uint32_t)line->row << 16) ^ line->line_number ^ ((uint32_t)line->field << 31);
+    for (uint16_t i = 0; i < line->width * 2; i += 4) {
+        uint32_t word;
+        memcpy(&word, line->data + i, 4);
+        sum = sum * 31 + word;
+    }
+    split_benchmark_checksum = split_benchmark_checksum * 17 + sum;
+    split_benchmark_events++;
+}
+
+static void split_benchmark_frame(void*) {
+    split_benchmark_checksum = split_benchmark_checksum * 17 + 1;
+    split_benchmark_events++;
+}
+
+// Decode one synthetic `frames`-frame PAL recording sequentially and split over
+// 2, 4 and 8 threads, checking that the line output and statistics match
+void bt656_batch_run_split_benchmark(uint16_t frames) {
+    const uint16_t blanking_lines = BT656_PAL_FIELD_LINES - BT656_PAL_ACTIVE_LINES / 2;
+    const size_t frame_bytes = (size_t)(BT656_PAL_FIELD_LINES * 2 + 1) * BT656_TEST_LINE_SIZE;
+
+    if (frames == 0) frames = 1;
+
+    uint8_t* recording = (uint8_t*)malloc(frame_bytes * frames);
+    bt656_decoder_t* decoder = (bt656_decoder_t*)malloc(sizeof(bt656_decoder_t));
+    if (!recording || !decoder) {
+        Serial.println("ERROR: Failed to allocate benchmark buffers");
+        if (recording) free(recording);
+        if (decoder) free(decoder);
+        return;
+    }
+
+    uint8_t* p = recording;
+    for (uint16_t f = 0; f < frames; f++) {
+        for (int field = 0; field < 2; field++) {
+            uint16_t field_lines = BT656_PAL_FIELD_LINES + field;
+            for (uint16_t l = 0; l < field_lines; l++) {
+                p += bt656_generate_test_line(p, field, l < blanking_lines + field, l + f);
+            }
+        }
+    }
+
+    bt656_config_t config = {};
+    config.expected_width = BT656_PAL_ACTIVE_PIXELS;
+    config.expected_height = BT656_PAL_ACTIVE_LINES;
+    config.enable_line_output = true;
+
+    Serial.println("=== Split Decode Benchmark ===");
+    Serial.printf("%d PAL frames in one buffer\n", frames);
+
+    uint32_t baseline_us = 0;
+    uint32_t baseline_checksum = 0;
+    bt656_stats_t baseline_stats = {};
+    for (uint8_t workers = 1; workers <= BT656_BATCH_MAX_WORKERS; workers *= 2) {
+        bt656_decoder_init(decoder, &config);
+        bt656_decoder_set_line_output_callback(decoder, split_benchmark_line_output);
+        bt656_decoder_set_frame_callback(decoder, split_benchmark_frame);
+        split_benchmark_checksum = 0;
+        split_benchmark_events = 0;
+
+        uint32_t start = micros();
+        if (workers == 1) {
+            bt656_decoder_process_buffer(decoder, recording, p - recording);
+        } else {
+            bt656_batch_process_buffer(decoder, recording, p - recording, workers);
+        }
+        uint32_t elapsed = micros() - start;
+        if (elapsed == 0) elapsed = 1;
+
+        bt656_stats_t stats = decoder->stats;
+        stats.last_frame_time = 0;
+        if (workers == 1) {
+            baseline_us = elapsed;
+            baseline_checksum = split_benchmark_checksum;
+            baseline_stats = stats;
+        }
+        bool identical = split_benchmark_checksum == baseline_checksum &&
+                         memcmp(&stats, &baseline_stats, sizeof(bt656_stats_t)) == 0;
+
+        Serial.printf("%d threads: %lu us, %.1f fps, %lu events, output %s, %.2fx vs sequential\n",
+                      workers, elapsed, frames * 1000000.0f / elapsed, split_benchmark_events,
+                      identical ? "identical" : "DIFFERS", (float)baseline_us / elapsed);
+    }
+
+    Serial.println("==============================");
+    free(recording);
+    free(decoder);
+}
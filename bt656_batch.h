@@ -0,0 +1,110 @@
+#ifndef BT656_BATCH_H
+#define BT656_BATCH_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "bt656_decoder.h"
+#include "frame_ring.h"
+
+// ============================================================================
+// Batch Decode Configuration
+// ============================================================================
+
+#define BT656_BATCH_MAX_WORKERS    8         // Decode threads
+#define BT656_BATCH_MAX_STREAMS    16        // Recorded streams per batch
+#define BT656_BATCH_DEFAULT_CHUNK  (BT656_TEST_LINE_SIZE * 32)  // Bytes per turn (well under a frame)
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Batch decode configuration
+typedef struct {
+    uint8_t workers;               // Decode threads (1..BT656_BATCH_MAX_WORKERS)
+    uint32_t chunk_bytes;          // Bytes decoded per turn; must stay below one frame
+    bool lossless;                 // Pause streams whose ring still holds an unread frame
+} bt656_batch_config_t;
+
+// One recorded stream and the decoder that owns it
+// A stream is decoded by one worker at a time, a chunk per turn. Between turns
+// any worker may claim it, so an idle worker can take over a busy worker's
+// streams; the claim hands the decoder and write frame over with it.
+typedef struct {
+    const uint8_t* data;           // Recorded BT.656 bytes
+    size_t length;
+    size_t position;               // Next byte to decode
+    bt656_decoder_t decoder;
+    frame_ring_t* ring;            // Completed frames are published here
+    frame_buffer_t* write_frame;   // Frame being filled
+    uint8_t home;                  // Worker the stream is assigned to
+    volatile uint32_t owner;       // Worker index + 1 while claimed, 0 when free
+    bool finished;                 // All bytes decoded and the last frame published
+    uint32_t frames;               // Frames published
+    uint32_t chunks;               // Turns taken
+    uint32_t stolen;               // Turns taken by a worker other than `home`
+} bt656_batch_stream_t;
+
+// Per-worker statistics
+typedef struct {
+    uint32_t chunks;               // Turns taken
+    uint32_t steals;               // Turns taken on another worker's stream
+    uint32_t idle_scans;           // Scans that found no stream to claim
+} bt656_batch_worker_stats_t;
+
+typedef struct bt656_batch bt656_batch_t;
+
+// Worker thread context
+typedef struct {
+    bt656_batch_t* batch;
+    uint8_t index;
+    pthread_t thread;
+    bt656_batch_worker_stats_t stats;
+} bt656_batch_worker_t;
+
+// Decodes several recorded streams in parallel, one decoder per stream
+struct bt656_batch {
+    bt656_batch_config_t config;
+    bt656_batch_stream_t streams[BT656_BATCH_MAX_STREAMS];
+    uint8_t stream_count;
+    bt656_batch_worker_t workers[BT656_BATCH_MAX_WORKERS];
+    volatile uint32_t remaining;   // Streams not finished
+    bool running;                  // Workers started and not yet joined
+};
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core batch functions
+bool bt656_batch_init(bt656_batch_t* batch, const bt656_batch_config_t* config);
+void bt656_batch_deinit(bt656_batch_t* batch);
+bool bt656_batch_add_stream(bt656_batch_t* batch, const uint8_t* data, size_t length,
+                            const bt656_config_t* decoder_config, frame_ring_t* ring);
+
+// Run control (the caller consumes each stream's ring meanwhile)
+bool bt656_batch_start(bt656_batch_t* batch);
+bool bt656_batch_is_done(bt656_batch_t* batch);
+void bt656_batch_wait(bt656_batch_t* batch);
+
+// Split decoding of one stream (the caller's thread decodes the first part)
+bool bt656_batch_process_buffer(bt656_decoder_t* decoder, const uint8_t* data, size_t length,
+                                uint8_t workers);
+
+// Status and statistics functions
+void bt656_batch_print_stats(bt656_batch_t* batch);
+void bt656_batch_run_benchmark(uint8_t streams, uint16_t frames);
+void bt656_batch_run_split_benchmark(uint16_t frames);
+
+// ============================================================================
+// Default Configuration
+// ============================================================================
+
+static const bt656_batch_config_t BT656_BATCH_DEFAULT_CONFIG = {
+    .workers = 4,
+    .chunk_bytes = BT656_BATCH_DEFAULT_CHUNK,
+    .lossless = true
+};
+
+#endif // BT656_BATCH_H
@@ -44,11 +44,145 @@ static bt656_sync_t extract_sync_signals(uint8_t control_byte) {
     sync.field = (control_byte & (1 << BT656_FIELD_BIT)) != 0;
     sync.vsync = (control_byte & (1 << BT656_VSYNC_BIT)) != 0;
     sync.hsync = (control_byte & (1 << BT656_HSYNC_BIT)) != 0;
-    sync.sav = (control_byte & (1 << BT656_SAV_BIT)) != 0;
-    sync.eav = !sync.sav; // EAV is the opposite of SAV
+    sync.sav = !sync.hsync; // H=0 marks SAV, H=1 marks EAV (ITU-R BT.656)
+    sync.eav = sync.hsync;
     return sync;
 }
 
+// Derive the window limits and decimation factors from the configuration
+static void apply_config(bt656_decoder_t* decoder) {
+    const bt656_window_t* window = &decoder->config.window;
+    
+    uint32_t x0 = window->x0 & ~1;
+    uint32_t x1 = window->width ? x0 + (window->width & ~1) : BT656_PAL_ACTIVE_PIXELS;
+    if (x0 >= BT656_PAL_ACTIVE_PIXELS) x0 = 0;
+    if (x1 > BT656_PAL_ACTIVE_PIXELS) x1 = BT656_PAL_ACTIVE_PIXELS;
+    
+    uint32_t y0 = window->y0 & ~1;
+    uint32_t y1 = window->height ? y0 + window->height : 0xFFFF;
+    if (y1 > 0xFFFF) y1 = 0xFFFF;
+    
+    decoder->window_start = x0 * 2;
+    decoder->window_end = x1 * 2;
+    decoder->window_top = y0;
+    decoder->window_bottom = y1;
+    
+    uint8_t h = decoder->config.h_decimation;
+    decoder->h_decimation = (h == 2 || h == BT656_MAX_H_DECIMATION) ? h : 1;
+    decoder->v_decimation = decoder->config.v_decimation ? decoder->config.v_decimation : 1;
+    decoder->pending_pos = 0;
+}
+
+// Chroma (Cb, Cr) or luma (Y0, Y1) of a UYVY word as two 16-bit lanes
+#define UYVY_LANES     0x00FF00FF
+
+// Four UYVY words handled as one value. GCC turns the operations below into
+// SIMD instructions where the target has them and into word operations where
+// it does not, so one kernel serves both.
+typedef uint32_t uyvy_words_t __attribute__((vector_size(16)));
+
+static const uyvy_words_t EVEN_WORDS = { 0, 2, 4, 6 };
+static const uyvy_words_t ODD_WORDS = { 1, 3, 5, 7 };
+
+static inline uint32_t load_word(const uint8_t* p) {
+    uint32_t word;
+    memcpy(&word, p, 4);
+    return word;
+}
+
+static inline uyvy_words_t load_words(const uint8_t* p) {
+    uyvy_words_t words;
+    memcpy(&words, p, sizeof(words));
+    return words;
+}
+
+// Average two UYVY words (four pixels) into one. The words are regrouped so
+// that the two samples of every output byte sit in the same byte of `a` and
+// `b` (Cb0 Y0 Cr0 Y2 and Cb1 Y1 Cr1 Y3), then all four bytes are averaged at
+// once with round-up: (a | b) - ((a ^ b) >> 1) per byte equals (a + b + 1) >> 1.
+// W is a single word or a vector of words; each lane is averaged on its own.
+template <typename W>
+static inline W average_2(W w0, W w1) {
+    W a = (w0 & 0x00FFFFFF) | ((w1 & 0x0000FF00) << 16);
+    W b = (w1 & 0xFFFF00FF) | ((w0 >> 16) & 0x0000FF00);
+    return (a | b) - (((a ^ b) & 0xFEFEFEFE) >> 1);
+}
+
+// Average four UYVY words (eight pixels) into one. Cb and Cr are summed as two
+// 16-bit lanes of one register, and the luma samples are regrouped so that each
+// output Y sits in its own lane too; one add per input pixel covers both outputs.
+template <typename W>
+static inline W average_4(W w0, W w1, W w2, W w3) {
+    W chroma = (((w0 & UYVY_LANES) + (w1 & UYVY_LANES) + (w2 & UYVY_LANES) +
+                 (w3 & UYVY_LANES) + 0x00020002) >> 2) & UYVY_LANES;
+    W a = ((w0 >> 8) & 0xFF) | ((w2 << 8) & 0x00FF0000);       // Y0, Y4
+    W b = (w0 >> 24) | ((w2 >> 8) & 0x00FF0000);               // Y1, Y5
+    W c = ((w1 >> 8) & 0xFF) | ((w3 << 8) & 0x00FF0000);       // Y2, Y6
+    W d = (w1 >> 24) | ((w3 >> 8) & 0x00FF0000);               // Y3, Y7
+    W luma = ((a + b + c + d + 0x00020002) >> 2) & UYVY_LANES;
+    return chroma | (luma << 8);
+}
+
+// Average each run of `factor` pixels into one. A group is `factor` UYVY words
+// (2 * factor pixels) in and one word out. Four groups at a time are loaded
+// as vectors and split into their first, second, ... words with shuffles, so
+// every lane of the averaging above produces one output word. The remaining
+// groups go one word at a time.
+static void IRAM_ATTR decimate_groups(const uint8_t* src, uint8_t* dst, uint16_t groups, uint8_t factor) {
+    uint16_t g = 0;
+    
+    if (factor == 2) {
+        for (; g + 4 <= groups; g += 4, src += 32, dst += 16) {
+            uyvy_words_t a = load_words(src);
+            uyvy_words_t b = load_words(src + 16);
+            uyvy_words_t out = average_2(__builtin_shuffle(a, b, EVEN_WORDS), __builtin_shuffle(a, b, ODD_WORDS));
+            memcpy(dst, &out, 16);
+        }
+        for (; g < groups; g++, src += 8, dst += 4) {
+            uint32_t out = average_2(load_word(src), load_word(src + 4));
+            memcpy(dst, &out, 4);
+        }
+    } else {
+        for (; g + 4 <= groups; g += 4, src += 64, dst += 16) {
+            uyvy_words_t a = load_words(src);
+            uyvy_words_t b = load_words(src + 16);
+            uyvy_words_t c = load_words(src + 32);
+            uyvy_words_t d = load_words(src + 48);
+            
+            // Words 0, 2 and 1, 3 of each group, then split again into 0, 1, 2, 3
+            uyvy_words_t ab_even = __builtin_shuffle(a, b, EVEN_WORDS);
+            uyvy_words_t ab_odd = __builtin_shuffle(a, b, ODD_WORDS);
+            uyvy_words_t cd_even = __builtin_shuffle(c, d, EVEN_WORDS);
+            uyvy_words_t cd_odd = __builtin_shuffle(c, d, ODD_WORDS);
+            uyvy_words_t out = average_4(__builtin_shuffle(ab_even, cd_even, EVEN_WORDS),
+                                         __builtin_shuffle(ab_odd, cd_odd, EVEN_WORDS),
+                                         __builtin_shuffle(ab_even, cd_even, ODD_WORDS),
+                                         __builtin_shuffle(ab_odd, cd_odd, ODD_WORDS));
+            memcpy(dst, &out, 16);
+        }
+        for (; g < groups; g++, src += 16, dst += 4) {
+            uint32_t out = average_4(load_word(src), load_word(src + 4), load_word(src + 8), load_word(src + 12));
+            memcpy(dst, &out, 4);
+        }
+    }
+}
+
+// Hand the completed active line to the line output callback
+static void emit_line(bt656_decoder_t* decoder) {
+    if (decoder->line_output_callback && decoder->line_pos >= 4) {
+        uint16_t row = decoder->active_line * 2 + (decoder->sync.field ? 1 : 0);
+        bt656_line_t line;
+        line.data = decoder->line_buffer;
+        line.width = decoder->line_pos / 2;
+        line.line_number = decoder->active_line - decoder->window_top / 2;
+        line.row = (row - decoder->window_top) / decoder->v_decimation;
+        line.field = decoder->sync.field;
+        decoder->line_output_callback(&line, decoder->user);
+    }
+    
+    decoder->line_pos = 0;
+}
+
 // Process video data in 4:2:2 YCbCr format
 static void process_video_data(bt656_decoder_t* decoder, uint8_t data) {
     if (!decoder->in_active_video) return;
@@ -75,13 +209,13 @@ static void process_video_data(bt656_decoder_t* decoder, uint8_t data) {
             // Complete pixel pair available - call callbacks
             if (decoder->pixel_callback) {
                 decoder->pixel_callback(&decoder->current_pixel, 
-                                      decoder->pixel_count, decoder->line_count);
+                                      decoder->pixel_count, decoder->line_count, decoder->user);
             }
             
             if (decoder->config.enable_rgb_conversion && decoder->rgb_callback) {
                 decoder->current_rgb = bt656_ycbcr_to_rgb(decoder->current_pixel);
                 decoder->rgb_callback(&decoder->current_rgb, 
-                                    decoder->pixel_count, decoder->line_count);
+                                    decoder->pixel_count, decoder->line_count, decoder->user);
             }
             
             decoder->stats.pixels_received++;
@@ -91,18 +225,127 @@ static void process_video_data(bt656_decoder_t* decoder, uint8_t data) {
     }
 }
 
+// Store one active video sample, dropping samples outside the window. With
+// horizontal decimation, samples are held until a whole group is averaged, and
+// only the averaged pixels reach the line buffer and the pixel callbacks.
+static inline void IRAM_ATTR store_sample(bt656_decoder_t* decoder, uint8_t data) {
+    uint16_t pos = decoder->sample_pos++;
+    if (pos < decoder->window_start || pos >= decoder->window_end) {
+        return;
+    }
+    
+    if (decoder->h_decimation == 1) {
+        if (decoder->config.enable_line_output && decoder->line_pos < BT656_LINE_BUFFER_SIZE) {
+            decoder->line_buffer[decoder->line_pos++] = data;
+        }
+        process_video_data(decoder, data);
+        return;
+    }
+    
+    decoder->pending[decoder->pending_pos++] = data;
+    if (decoder->pending_pos < 4 * decoder->h_decimation) {
+        return;
+    }
+    decoder->pending_pos = 0;
+    
+    uint8_t out[4];
+    decimate_groups(decoder->pending, out, 1, decoder->h_decimation);
+    if (decoder->config.enable_line_output && decoder->line_pos + 4 <= BT656_LINE_BUFFER_SIZE) {
+        memcpy(decoder->line_buffer + decoder->line_pos, out, 4);
+        decoder->line_pos += 4;
+    }
+    for (int i = 0; i < 4; i++) {
+        process_video_data(decoder, out[i]);
+    }
+}
+
+// Bytes from `data` before the next 0xFF. Samples never take that value, so
+// these bytes cannot start a timing reference.
+static inline size_t sample_run_length(const uint8_t* data, size_t length) {
+    const uint8_t* ff = (const uint8_t*)memchr(data, BT656_TR_MARKER_FF, length);
+    return ff ? (size_t)(ff - data) : length;
+}
+
+// Consume part of a run of active samples, returning the bytes used (> 0)
+static size_t IRAM_ATTR consume_samples(bt656_decoder_t* decoder, const uint8_t* data, size_t run) {
+    uint16_t pos = decoder->sample_pos;
+    
+    // Left of the window: skip straight to its first sample
+    if (pos < decoder->window_start) {
+        size_t skip = decoder->window_start - pos;
+        if (skip > run) skip = run;
+        decoder->sample_pos += skip;
+        return skip;
+    }
+    
+    // Right of the window: nothing more to collect until EAV
+    if (pos >= decoder->window_end) {
+        decoder->sample_pos += run;
+        return run;
+    }
+    
+    // Inside the window: whole groups (one pixel pair, or one decimation group)
+    // are copied or averaged straight into the line unless a per-pixel callback needs them
+    const size_t group = 4 * decoder->h_decimation;
+    size_t available = decoder->window_end - pos;
+    if (available > run) available = run;
+    size_t count = available - available % group;
+    
+    bool per_pixel = decoder->pixel_callback ||
+                     (decoder->config.enable_rgb_conversion && decoder->rgb_callback);
+    if (per_pixel || count == 0 || decoder->phase != BT656_PHASE_Y1 || decoder->pending_pos) {
+        // Sample by sample, but without rescanning the run for every byte
+        size_t n = per_pixel ? available : 1;
+        for (size_t i = 0; i < n; i++) {
+            store_sample(decoder, data[i]);
+        }
+        return n;
+    }
+    
+    if (decoder->config.enable_line_output) {
+        size_t room = BT656_LINE_BUFFER_SIZE - decoder->line_pos;
+        size_t out = count / decoder->h_decimation;
+        if (out > room) out = room - room % 4;
+        
+        if (decoder->h_decimation == 1) {
+            memcpy(decoder->line_buffer + decoder->line_pos, data, out);
+        } else {
+            decimate_groups(data, decoder->line_buffer + decoder->line_pos, out / 4, decoder->h_decimation);
+        }
+        decoder->line_pos += out;
+    }
+    
+    // Pixel pairs counted after decimation, as store_sample() would count them
+    uint16_t pairs = count / group;
+    decoder->sample_pos += count;
+    decoder->pixel_count += pairs;
+    decoder->stats.pixels_received += pairs;
+    return count;
+}
+
 // Handle sync signal changes
 static void handle_sync_signals(bt656_decoder_t* decoder, bt656_sync_t sync) {
+    // EAV closes the active line; only lines inside the window were collected
+    if (sync.eav && decoder->line_active) {
+        if (decoder->in_active_video) {
+            emit_line(decoder);
+        } else {
+            decoder->stats.lines_skipped++;
+        }
+        decoder->active_line++;
+    }
+    
     // Handle vertical sync (new frame)
     if (sync.vsync && !decoder->sync.vsync) {
         decoder->frame_started = true;
         decoder->line_count = 0;
         decoder->pixel_count = 0;
+        decoder->active_line = 0;
         decoder->stats.frames_received++;
         decoder->stats.last_frame_time = micros();
         
         if (decoder->frame_callback) {
-            decoder->frame_callback();
+            decoder->frame_callback(decoder->user);
         }
     }
     
@@ -113,18 +356,27 @@ static void handle_sync_signals(bt656_decoder_t* decoder, bt656_sync_t sync) {
         decoder->stats.lines_received++;
         
         if (decoder->line_callback) {
-            decoder->line_callback(decoder->line_count);
+            decoder->line_callback(decoder->line_count, decoder->user);
         }
         
         decoder->line_count++;
     }
     
-    // Handle SAV (Start of Active Video)
-    if (sync.sav) {
-        decoder->in_active_video = true;
+    // Handle SAV (Start of Active Video) - blanking lines carry SAV with V=1.
+    // Lines outside the window or dropped by vertical decimation are never
+    // collected, so their samples cost nothing.
+    if (sync.sav && !sync.vsync) {
+        uint16_t row = decoder->active_line * 2 + (sync.field ? 1 : 0);
+        decoder->line_active = true;
+        decoder->in_active_video = row >= decoder->window_top && row < decoder->window_bottom &&
+                                   (row - decoder->window_top) % decoder->v_decimation == 0;
         decoder->phase = BT656_PHASE_Y1;
         decoder->pixel_count = 0;
+        decoder->line_pos = 0;
+        decoder->sample_pos = 0;
+        decoder->pending_pos = 0;
     } else {
+        decoder->line_active = false;
         decoder->in_active_video = false;
     }
     
@@ -155,6 +407,7 @@ bool bt656_decoder_init(bt656_decoder_t* decoder, const bt656_config_t* config)
         decoder->config.enable_rgb_conversion = true;
         decoder->config.enable_frame_buffer = false;
         decoder->config.output_format = 1; // RGB
+        decoder->config.enable_line_output = false;
     }
     
     // Initialize state
@@ -164,11 +417,15 @@ bool bt656_decoder_init(bt656_decoder_t* decoder, const bt656_config_t* config)
     decoder->frame_started = false;
     decoder->line_started = false;
     
+    apply_config(decoder);
+    
     // Initialize callbacks to NULL
     decoder->pixel_callback = nullptr;
     decoder->rgb_callback = nullptr;
     decoder->frame_callback = nullptr;
     decoder->line_callback = nullptr;
+    decoder->line_output_callback = nullptr;
+    decoder->user = nullptr;
     
     Serial.println("BT656 decoder initialized successfully");
     return true;
@@ -192,6 +449,11 @@ void bt656_decoder_reset(bt656_decoder_t* decoder) {
     decoder->line_started = false;
     decoder->line_count = 0;
     decoder->pixel_count = 0;
+    decoder->line_active = false;
+    decoder->line_pos = 0;
+    decoder->active_line = 0;
+    decoder->sample_pos = 0;
+    decoder->pending_pos = 0;
     
     // Clear sync signals
     memset(&decoder->sync, 0, sizeof(bt656_sync_t));
@@ -204,12 +466,8 @@ void bt656_decoder_reset(bt656_decoder_t* decoder) {
 void bt656_decoder_process_byte(bt656_decoder_t* decoder, uint8_t data) {
     if (!decoder) return;
     
-    // Check for timing reference pattern
-    if (detect_timing_reference(decoder, data)) {
-        return; // Wait for control byte
-    }
-    
-    // Process control byte after timing reference
+    // Process control byte after timing reference (must run before the
+    // pattern detector, which would otherwise reset the state to IDLE)
     if (decoder->state == BT656_STATE_CONTROL_BYTE) {
         bt656_sync_t sync = extract_sync_signals(data);
         handle_sync_signals(decoder, sync);
@@ -217,10 +475,55 @@ void bt656_decoder_process_byte(bt656_decoder_t* decoder, uint8_t data) {
         return;
     }
     
-    // Process video data if in active video region
+    // Check for timing reference pattern
+    if (detect_timing_reference(decoder, data)) {
+        return; // Wait for control byte
+    }
+    
+    // Process video data if in active video region (FF 00 00 preamble bytes are not samples)
+    if (decoder->in_active_video && decoder->state == BT656_STATE_IDLE) {
+        store_sample(decoder, data);
+    }
+}
+
+// Decode a block of bytes. Equivalent to feeding each byte to
+// bt656_decoder_process_byte(), but runs that cannot hold a timing reference
+// are skipped or copied in bulk: blanking, lines outside the window and pixels
+// left or right of it cost one memchr() instead of a state machine step each.
+void IRAM_ATTR bt656_decoder_process_buffer(bt656_decoder_t* decoder, const uint8_t* data, size_t length) {
+    if (!decoder || !data) return;
+    
+    size_t i = 0;
+    while (i < length) {
+        if (decoder->state != BT656_STATE_IDLE) {
+            bt656_decoder_process_byte(decoder, data[i++]);
+            continue;
+        }
+        
+        size_t run = sample_run_length(data + i, length - i);
+        if (run == 0) {
+            bt656_decoder_process_byte(decoder, data[i++]);
+        } else if (!decoder->in_active_video) {
+            i += run;
+        } else {
+            i += consume_samples(decoder, data + i, run);
+        }
+    }
+}
+
+// End of input. A recording that stops inside an active line never sends the
+// EAV that closes it, so the collected line is handed over here instead.
+void bt656_decoder_flush(bt656_decoder_t* decoder) {
+    if (!decoder || !decoder->line_active) return;
+    
     if (decoder->in_active_video) {
-        process_video_data(decoder, data);
+        emit_line(decoder);
+    } else {
+        decoder->stats.lines_skipped++;
     }
+    decoder->active_line++;
+    decoder->line_active = false;
+    decoder->in_active_video = false;
 }
 
 // ============================================================================
@@ -230,33 +533,46 @@ void bt656_decoder_process_byte(bt656_decoder_t* decoder, uint8_t data) {
 void bt656_decoder_set_config(bt656_decoder_t* decoder, const bt656_config_t* config) {
     if (decoder && config) {
         decoder->config = *config;
+        apply_config(decoder);
     }
 }
 
-void bt656_decoder_set_pixel_callback(bt656_decoder_t* decoder, void (*callback)(bt656_ycbcr_t* pixel, uint16_t x, uint16_t y)) {
+void bt656_decoder_set_pixel_callback(bt656_decoder_t* decoder, void (*callback)(bt656_ycbcr_t* pixel, uint16_t x, uint16_t y, void* user)) {
     if (decoder) {
         decoder->pixel_callback = callback;
     }
 }
 
-void bt656_decoder_set_rgb_callback(bt656_decoder_t* decoder, void (*callback)(bt656_rgb_t* pixel, uint16_t x, uint16_t y)) {
+void bt656_decoder_set_rgb_callback(bt656_decoder_t* decoder, void (*callback)(bt656_rgb_t* pixel, uint16_t x, uint16_t y, void* user)) {
     if (decoder) {
         decoder->rgb_callback = callback;
     }
 }
 
-void bt656_decoder_set_frame_callback(bt656_decoder_t* decoder, void (*callback)(void)) {
+void bt656_decoder_set_frame_callback(bt656_decoder_t* decoder, void (*callback)(void* user)) {
     if (decoder) {
         decoder->frame_callback = callback;
     }
 }
 
-void bt656_decoder_set_line_callback(bt656_decoder_t* decoder, void (*callback)(uint16_t line_number)) {
+void bt656_decoder_set_line_callback(bt656_decoder_t* decoder, void (*callback)(uint16_t line_number, void* user)) {
     if (decoder) {
         decoder->line_callback = callback;
     }
 }
 
+void bt656_decoder_set_line_output_callback(bt656_decoder_t* decoder, void (*callback)(bt656_line_t* line, void* user)) {
+    if (decoder) {
+        decoder->line_output_callback = callback;
+    }
+}
+
+void bt656_decoder_set_user(bt656_decoder_t* decoder, void* user) {
+    if (decoder) {
+        decoder->user = user;
+    }
+}
+
 // ============================================================================
 // Status and Statistics Functions
 // ============================================================================
@@ -326,6 +642,148 @@ uint16_t bt656_rgb_to_rgb565(bt656_rgb_t rgb) {
     return (r << 11) | (g << 5) | b;
 }
 
+// ============================================================================
+// Benchmark Functions
+// ============================================================================
+
+// Timing reference status byte with protection bits (ITU-R BT.656 table 2)
+static uint8_t make_status_byte(bool field, bool vsync, bool hsync) {
+    uint8_t f = field, v = vsync, h = hsync;
+    return 0x80 | (f << 6) | (v << 5) | (h << 4) |
+           ((v ^ h) << 3) | ((f ^ h) << 2) | ((f ^ v) << 1) | (f ^ v ^ h);
+}
+
+// Write one synthetic PAL line (EAV, horizontal blanking, SAV, active samples)
+// into `out`, which must hold BT656_TEST_LINE_SIZE bytes. Returns bytes written.
+size_t bt656_generate_test_line(uint8_t* out, bool field, bool vsync, uint16_t line_number) {
+    if (!out) return 0;
+    
+    uint8_t* p = out;
+    const uint8_t timing[3] = { BT656_TR_MARKER_FF, BT656_TR_MARKER_00, BT656_TR_MARKER_00 };
+    
+    memcpy(p, timing, 3);
+    p[3] = make_status_byte(field, vsync, true);
+    p += 4;
+    
+    for (int i = 0; i < BT656_PAL_BLANKING_PIXELS * 2 - 8; i += 2) {
+        *p++ = 0x80;
+        *p++ = 0x10;
+    }
+    
+    memcpy(p, timing, 3);
+    p[3] = make_status_byte(field, vsync, false);
+    p += 4;
+    
+    // Luma ramp and slowly varying chroma, kept inside the legal 16-240 range
+    for (int x = 0; x < BT656_PAL_ACTIVE_PIXELS; x += 2) {
+        *p++ = vsync ? 128 : 64 + (line_number & 0x7F);
+        *p++ = vsync ? 16 : 16 + ((x + line_number) % 220);
+        *p++ = vsync ? 128 : 192 - (x & 0x3F);
+        *p++ = vsync ? 16 : 16 + ((x + 1 + line_number) % 220);
+    }
+    
+    return p - out;
+}
+
+// Both count output pixels into the uint32_t passed as the decoder's user pointer
+static void benchmark_line_output(bt656_line_t* line, void* user) {
+    *(uint32_t*)user += line->width;
+}
+
+// Called once per Cb Y Cr Y group, which carries two pixels
+static void benchmark_rgb_output(bt656_rgb_t*, uint16_t, uint16_t, void* user) {
+    *(uint32_t*)user += 2;
+}
+
+// Decode `frames` synthetic frames with the given settings, returning microseconds
+// and counting the pixels delivered into `output_pixels`
+static uint32_t benchmark_decode(bt656_decoder_t* decoder, const uint8_t* lines, uint16_t frames,
+                                 uint8_t h_decimation, uint8_t v_decimation, bool rgb_output,
+                                 uint32_t* output_pixels) {
+    const uint16_t blanking_lines = BT656_PAL_FIELD_LINES - BT656_PAL_ACTIVE_LINES / 2;
+    
+    bt656_config_t config = {};
+    config.expected_width = BT656_PAL_ACTIVE_PIXELS;
+    config.expected_height = BT656_PAL_ACTIVE_LINES;
+    config.enable_line_output = !rgb_output;
+    config.enable_rgb_conversion = rgb_output;
+    config.h_decimation = h_decimation;
+    config.v_decimation = v_decimation;
+    
+    bt656_decoder_init(decoder, &config);
+    if (rgb_output) {
+        bt656_decoder_set_rgb_callback(decoder, benchmark_rgb_output);
+    } else {
+        bt656_decoder_set_line_output_callback(decoder, benchmark_line_output);
+    }
+    *output_pixels = 0;
+    bt656_decoder_set_user(decoder, output_pixels);
+    
+    uint32_t start = micros();
+    for (uint16_t f = 0; f < frames; f++) {
+        for (int field = 0; field < 2; field++) {
+            uint16_t field_lines = BT656_PAL_FIELD_LINES + field;
+            for (uint16_t l = 0; l < field_lines; l++) {
+                bool vsync = l < blanking_lines + field;
+                const uint8_t* line = lines + ((vsync ? 0 : 2) + field) * BT656_TEST_LINE_SIZE;
+                bt656_decoder_process_buffer(decoder, line, BT656_TEST_LINE_SIZE);
+            }
+        }
+    }
+    bt656_decoder_flush(decoder);  // The last line has no EAV after it
+    uint32_t elapsed = micros() - start;
+    return elapsed ? elapsed : 1;
+}
+
+// Decode `frames` synthetic PAL frames through bt656_decoder_process_buffer()
+// at each decimation setting, for line output and for per-pixel RGB output
+void bt656_decoder_run_benchmark(uint16_t frames) {
+    static const uint8_t settings[][2] = {
+        {1, 1}, {2, 1}, {4, 1}, {1, 2}, {2, 2}, {4, 2}, {4, 4}
+    };
+    
+    if (frames == 0) frames = 1;
+    
+    // One blanking and one active line per field, reused for every line
+    uint8_t* lines = (uint8_t*)malloc(BT656_TEST_LINE_SIZE * 4);
+    bt656_decoder_t* decoder = (bt656_decoder_t*)malloc(sizeof(bt656_decoder_t));
+    if (!lines || !decoder) {
+        Serial.println("ERROR: Failed to allocate benchmark buffers");
+        if (lines) free(lines);
+        if (decoder) free(decoder);
+        return;
+    }
+    for (int i = 0; i < 4; i++) {
+        bt656_generate_test_line(lines + i * BT656_TEST_LINE_SIZE, i & 1, i < 2, 100);
+    }
+    
+    Serial.println("=== BT656 Decimation Benchmark ===");
+    Serial.printf("%d PAL frames per setting\n", frames);
+    
+    for (int mode = 0; mode < 2; mode++) {
+        bool rgb_output = mode == 1;
+        Serial.println(rgb_output ? "-- Per-pixel RGB output --" : "-- Line output --");
+        
+        uint32_t baseline_us = 0;
+        for (size_t s = 0; s < sizeof(settings) / sizeof(settings[0]); s++) {
+            uint32_t out_pixels = 0;
+            uint32_t elapsed = benchmark_decode(decoder, lines, frames, settings[s][0], settings[s][1],
+                                                rgb_output, &out_pixels);
+            if (s == 0) baseline_us = elapsed;
+            
+            out_pixels /= frames;
+            Serial.printf("H %dx V %dx: %lu us, %.1f fps, %lu px/frame out, %.2fx vs full\n",
+                          settings[s][0], settings[s][1], elapsed,
+                          frames * 1000000.0f / elapsed, out_pixels,
+                          (float)baseline_us / elapsed);
+        }
+    }
+    
+    Serial.println("==================================");
+    free(lines);
+    free(decoder);
+}
+
 // ============================================================================
 // Utility Functions
 // ============================================================================
@@ -340,6 +798,7 @@ void bt656_decoder_print_stats(bt656_decoder_t* decoder) {
     Serial.printf("Timing Errors: %lu\n", decoder->stats.timing_errors);
     Serial.printf("Sync Errors: %lu\n", decoder->stats.sync_errors);
     Serial.printf("Data Errors: %lu\n", decoder->stats.data_errors);
+    Serial.printf("Lines Skipped (outside window): %lu\n", decoder->stats.lines_skipped);
     Serial.printf("Last Frame Time: %llu us\n", decoder->stats.last_frame_time);
     Serial.printf("Current State: %s\n", bt656_state_to_string(decoder->state));
     Serial.printf("Current Phase: %s\n", bt656_phase_to_string(decoder->phase));
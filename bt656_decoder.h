@@ -15,6 +15,13 @@
 #define BT656_PAL_ACTIVE_LINES     576       // PAL active video lines
 #define BT656_PAL_ACTIVE_PIXELS    720       // PAL active pixels per line
 #define BT656_PAL_TOTAL_PIXELS     864       // PAL total pixels per line
+#define BT656_LINE_BUFFER_SIZE     (BT656_PAL_ACTIVE_PIXELS * 2)  // UYVY bytes per active line
+#define BT656_PAL_FIELD_LINES      312       // Lines in the first PAL field (second has 313)
+#define BT656_PAL_BLANKING_PIXELS  (BT656_PAL_TOTAL_PIXELS - BT656_PAL_ACTIVE_PIXELS)
+#define BT656_TEST_LINE_SIZE       (BT656_PAL_TOTAL_PIXELS * 2)  // Bytes per generated line
+
+// Decimation limits
+#define BT656_MAX_H_DECIMATION     4         // Horizontal factors: 1, 2 or 4
 
 // BT656 data stream markers
 #define BT656_TR_MARKER_FF         0xFF      // Timing reference marker
@@ -25,8 +32,8 @@
 // BT656 sync signal bit positions
 #define BT656_FIELD_BIT            6         // Field indicator bit
 #define BT656_VSYNC_BIT            5         // Vertical sync bit
-#define BT656_HSYNC_BIT            4         // Horizontal sync bit
-#define BT656_SAV_BIT              3         // SAV indicator bit
+#define BT656_HSYNC_BIT            4         // Horizontal sync bit (H=0 SAV, H=1 EAV)
+#define BT656_SAV_BIT              3         // Protection bit P3 (kept for reference)
 
 // ============================================================================
 // Data Structures
@@ -72,6 +79,25 @@ typedef struct {
     uint8_t b;                     // Blue component
 } bt656_rgb_t;
 
+// Active video line as it leaves the decoder
+typedef struct {
+    uint8_t* data;                 // Packed UYVY samples (Cb Y0 Cr Y1 ...)
+    uint16_t width;                // Pixels in line
+    uint16_t line_number;          // Active line within current field
+    uint16_t row;                  // Output row in the windowed, decimated frame
+    bool field;                    // Field indicator (odd/even)
+} bt656_line_t;
+
+// Active window in frame coordinates (rows interleave both fields)
+// x0 and y0 are rounded down to even values so chroma pairs and field parity
+// are kept; a width or height of 0 extends the window to the raster edge.
+typedef struct {
+    uint16_t x0;                   // First pixel
+    uint16_t y0;                   // First frame row
+    uint16_t width;                // Pixels (0 = to the end of the line)
+    uint16_t height;               // Frame rows (0 = to the end of the frame)
+} bt656_window_t;
+
 // BT656 decoder statistics
 typedef struct {
     uint32_t frames_received;      // Total frames received
@@ -80,6 +106,7 @@ typedef struct {
     uint32_t timing_errors;        // Timing reference errors
     uint32_t sync_errors;          // Sync signal errors
     uint32_t data_errors;          // Data phase errors
+    uint32_t lines_skipped;        // Active lines outside the window
     uint64_t last_frame_time;      // Timestamp of last frame
 } bt656_stats_t;
 
@@ -90,6 +117,10 @@ typedef struct {
     bool enable_rgb_conversion;    // Enable YCbCr to RGB conversion
     bool enable_frame_buffer;      // Enable frame buffering
     uint8_t output_format;         // 0=YCbCr, 1=RGB, 2=Grayscale
+    bool enable_line_output;       // Collect active lines for the line output callback
+    bt656_window_t window;         // Region decoded; all zero = full raster
+    uint8_t h_decimation;          // Average 1, 2 or 4 pixels per output pixel (0 = 1)
+    uint8_t v_decimation;          // Keep every Nth frame row, 2 = one field (0 = 1)
 } bt656_config_t;
 
 // BT656 decoder instance
@@ -108,15 +139,34 @@ typedef struct {
     bool in_active_video;          // Currently in active video region
     bool frame_started;            // Frame has started
     bool line_started;             // Line has started
+    bool line_active;              // Current line is an active (non-blanking) line
+    
+    // Line output
+    uint8_t line_buffer[BT656_LINE_BUFFER_SIZE] __attribute__((aligned(4)));
+    uint16_t line_pos;             // Bytes collected in current line
+    uint16_t active_line;          // Active line within current field
+    
+    // Active window (derived from config.window)
+    uint16_t sample_pos;           // Bytes since SAV in the current line
+    uint16_t window_start;         // First sample byte inside the window
+    uint16_t window_end;           // First sample byte past the window
+    uint16_t window_top;           // First frame row inside the window
+    uint16_t window_bottom;        // First frame row past the window
+    uint8_t h_decimation;          // Validated horizontal factor (1, 2 or 4)
+    uint8_t v_decimation;          // Validated vertical factor (>= 1)
+    uint8_t pending[4 * BT656_MAX_H_DECIMATION];  // Samples of a partial decimation group
+    uint8_t pending_pos;           // Bytes held in pending
     
     bt656_stats_t stats;           // Decoder statistics
     bt656_config_t config;         // Decoder configuration
     
-    // Callback functions
-    void (*pixel_callback)(bt656_ycbcr_t* pixel, uint16_t x, uint16_t y);
-    void (*rgb_callback)(bt656_rgb_t* pixel, uint16_t x, uint16_t y);
-    void (*frame_callback)(void);
-    void (*line_callback)(uint16_t line_number);
+    // Callback functions (each receives `user` as its last argument)
+    void (*pixel_callback)(bt656_ycbcr_t* pixel, uint16_t x, uint16_t y, void* user);
+    void (*rgb_callback)(bt656_rgb_t* pixel, uint16_t x, uint16_t y, void* user);
+    void (*frame_callback)(void* user);
+    void (*line_callback)(uint16_t line_number, void* user);
+    void (*line_output_callback)(bt656_line_t* line, void* user);
+    void* user;                    // Caller context passed to every callback
 } bt656_decoder_t;
 
 // ============================================================================
@@ -128,13 +178,17 @@ bool bt656_decoder_init(bt656_decoder_t* decoder, const bt656_config_t* config);
 void bt656_decoder_deinit(bt656_decoder_t* decoder);
 void bt656_decoder_reset(bt656_decoder_t* decoder);
 void bt656_decoder_process_byte(bt656_decoder_t* decoder, uint8_t data);
+void bt656_decoder_process_buffer(bt656_decoder_t* decoder, const uint8_t* data, size_t length);
+void bt656_decoder_flush(bt656_decoder_t* decoder);          // End of input: close the open line
 
 // Configuration functions
 void bt656_decoder_set_config(bt656_decoder_t* decoder, const bt656_config_t* config);
-void bt656_decoder_set_pixel_callback(bt656_decoder_t* decoder, void (*callback)(bt656_ycbcr_t* pixel, uint16_t x, uint16_t y));
-void bt656_decoder_set_rgb_callback(bt656_decoder_t* decoder, void (*callback)(bt656_rgb_t* pixel, uint16_t x, uint16_t y));
-void bt656_decoder_set_frame_callback(bt656_decoder_t* decoder, void (*callback)(void));
-void bt656_decoder_set_line_callback(bt656_decoder_t* decoder, void (*callback)(uint16_t line_number));
+void bt656_decoder_set_pixel_callback(bt656_decoder_t* decoder, void (*callback)(bt656_ycbcr_t* pixel, uint16_t x, uint16_t y, void* user));
+void bt656_decoder_set_rgb_callback(bt656_decoder_t* decoder, void (*callback)(bt656_rgb_t* pixel, uint16_t x, uint16_t y, void* user));
+void bt656_decoder_set_frame_callback(bt656_decoder_t* decoder, void (*callback)(void* user));
+void bt656_decoder_set_line_callback(bt656_decoder_t* decoder, void (*callback)(uint16_t line_number, void* user));
+void bt656_decoder_set_line_output_callback(bt656_decoder_t* decoder, void (*callback)(bt656_line_t* line, void* user));
+void bt656_decoder_set_user(bt656_decoder_t* decoder, void* user);
 
 // Status and statistics functions
 bt656_stats_t bt656_decoder_get_stats(bt656_decoder_t* decoder);
@@ -148,6 +202,10 @@ bt656_rgb_t bt656_ycbcr_to_rgb(bt656_ycbcr_t ycbcr);
 uint8_t bt656_ycbcr_to_grayscale(bt656_ycbcr_t ycbcr);
 uint16_t bt656_rgb_to_rgb565(bt656_rgb_t rgb);
 
+// Benchmark functions
+size_t bt656_generate_test_line(uint8_t* out, bool field, bool vsync, uint16_t line_number);
+void bt656_decoder_run_benchmark(uint16_t frames);
+
 // Utility functions
 void bt656_decoder_print_stats(bt656_decoder_t* decoder);
 const char* bt656_state_to_string(bt656_state_t state);
@@ -1,26 +1,195 @@
 #include "bt656_example.h"
+#include "frame_ring.h"
+#include "video_stereo.h"
+#include "video_pipeline.h"
 #include <Arduino.h>
 
 // ============================================================================
 // Global Variables
 // ============================================================================
 
-// Global frame buffer instance
-static frame_buffer_t g_frame_buffer;
+// One camera: its frames and every stage that keeps per-stream history.
+// Binocular goggles run two channels, each fed by its own decoder.
+typedef struct {
+    // Frames exchanged between the decoder (producer) and processing (consumer)
+    frame_ring_t frame_ring;
+    
+    // Every native frame, allocated once at startup
+    frame_pool_t frame_pool;
+    
+    // Frame the decoder callbacks are currently writing
+    frame_buffer_t* write_frame;
+    uint32_t frame_counter;
+    
+    // Adaptive histogram equalization for low-light frames
+    video_clahe_t clahe;
+    
+    // Recursive temporal filter for low-light grain, fused with the tone curve
+    video_denoise_t denoise;
+    
+    // Fixed-pattern noise and hot pixel correction (each sensor has its own)
+    video_darkframe_t darkframe;
+    
+    // Streaming edge enhancement, a few lines behind the decoder
+    video_sharpen_t sharpen;
+    
+    // Builds a full frame from every field (50 fps) when enabled
+    video_deinterlace_t deinterlace;
+    
+    bool active;                  // Set up by video_processing_init()
+} video_channel_t;
+
+static video_channel_t g_channels[VIDEO_CHANNEL_COUNT];
+
+// Matches left and right frames by timestamp (binocular mode only)
+static video_stereo_t g_stereo;
 
 // Global processing configuration
 static video_processing_config_t g_processing_config = DEFAULT_PROCESSING_CONFIG;
 
+// Software tone curve applied to lines as they leave the decoder (shared, read-only)
+static video_tone_t g_tone;
+
+// Luma-to-colour palette for monochrome displays
+static video_palette_t g_palette;
+
+// Running average of recent left-channel frames, published through its own ring
+static video_stack_t g_stack;
+static frame_ring_t g_stack_ring;
+
+// Resamples native frames to output_width x output_height
+static video_scaler_t g_scaler;
+
+// Pre-distorts output frames for the eyepiece (display format and size)
+static video_remap_t g_remap;
+
 // Frame processing statistics
 static uint32_t g_total_frames_processed = 0;
 static uint32_t g_total_pixels_processed = 0;
 static uint64_t g_last_frame_time = 0;
 
+// ============================================================================
+// Frame Conversion Helpers
+// ============================================================================
+
+static inline uint8_t clamp_u8(int value) {
+    return (value < 0) ? 0 : (value > 255) ? 255 : value;
+}
+
+// Convert the native UYVY frame into one of the other formats
+static void convert_frame(frame_buffer_t* buffer, uint8_t format, uint8_t* out) {
+    video_image_t src = frame_buffer_get_image(buffer);
+    video_image_t dst = video_image_make(out, buffer->width, buffer->height, format);
+    const video_palette_table_t* table = video_palette_acquire(buffer->palette);
+    
+    // Palettes replace true colour for the RGB formats
+    if (table && table->id != VIDEO_PALETTE_NONE &&
+        (format == FRAME_FORMAT_RGB || format == FRAME_FORMAT_RGB565)) {
+        video_palette_map_image(table, &src, &dst);
+    } else {
+        video_image_convert(&src, &dst);
+    }
+    
+    video_palette_release(buffer->palette, table);
+}
+
+// ============================================================================
+// Orientation Helpers
+// ============================================================================
+
+static inline bool is_rotated(uint8_t orientation) {
+    return orientation == FRAME_ORIENT_ROTATE_90 || orientation == FRAME_ORIENT_ROTATE_270;
+}
+
+// Where source pixel (x, y) is stored; false if it lies outside the frame.
+// Rotated buffers hold the source transposed, so their width is the source height.
+static inline bool orient_pixel(const frame_buffer_t* buffer, uint16_t x, uint16_t y,
+                                uint16_t* out_x, uint16_t* out_y) {
+    uint8_t orientation = buffer->orientation;
+    if (is_rotated(orientation)) {
+        if (x >= buffer->height || y >= buffer->width) return false;
+        bool clockwise = orientation == FRAME_ORIENT_ROTATE_90;
+        *out_x = clockwise ? buffer->width - 1 - y : y;
+        *out_y = clockwise ? x : buffer->height - 1 - x;
+        return true;
+    }
+    
+    if (x >= buffer->width || y >= buffer->height) return false;
+    *out_x = (orientation & FRAME_ORIENT_MIRROR) ? buffer->width - 1 - x : x;
+    *out_y = (orientation & FRAME_ORIENT_FLIP) ? buffer->height - 1 - y : y;
+    return true;
+}
+
+// Store a UYVY line right to left, ending at the end of `dst_row`. Each pixel
+// pair is one 32-bit word; swapping its lumas (bytes 1 and 3) mirrors it.
+static void IRAM_ATTR mirror_line_uyvy(uint8_t* dst_row, const uint8_t* uyvy, uint16_t width, uint16_t frame_width) {
+    uint8_t* out = dst_row + (uint32_t)frame_width * 2;
+    
+    for (uint16_t x = 0; x + 2 <= width; x += 2) {
+        uint32_t pair;
+        memcpy(&pair, uyvy + 2 * x, 4);
+        pair = (pair & 0x00FF00FFUL) | ((pair >> 16) & 0x0000FF00UL) | ((pair << 16) & 0xFF000000UL);
+        out -= 4;
+        memcpy(out, &pair, 4);
+    }
+}
+
+// Write the pending source lines into the rotated frame. Source columns are
+// handled FRAME_TRANSPOSE_LINES at a time, so a block of the pending lines
+// stays in cache while each destination row receives one short run. A stored
+// pixel keeps its luma and takes Cb or Cr by its new column, like the per-pixel
+// callbacks do. Each source line becomes one column and is stamped there.
+static void IRAM_ATTR transpose_pending_lines(frame_buffer_t* buffer) {
+    uint8_t count = buffer->transpose_count;
+    if (count == 0) return;
+    buffer->transpose_count = 0;
+    
+    const uint32_t line_bytes = (uint32_t)buffer->height * 2;
+    const uint32_t stride = (uint32_t)buffer->width * 2;
+    uint16_t columns = 0;
+    uint16_t out_x, out_y;
+    for (uint8_t k = 0; k < count; k++) {
+        if (buffer->transpose_widths[k] > columns) columns = buffer->transpose_widths[k];
+        if (buffer->transpose_widths[k] > 0 && orient_pixel(buffer, 0, buffer->transpose_rows[k], &out_x, &out_y)) {
+            buffer->column_stamps[out_x] = buffer->sequence;
+        }
+    }
+    
+    for (uint16_t c0 = 0; c0 < columns; c0 += FRAME_TRANSPOSE_LINES) {
+        uint16_t c1 = (columns - c0 < FRAME_TRANSPOSE_LINES) ? columns : c0 + FRAME_TRANSPOSE_LINES;
+        
+        for (uint16_t c = c0; c < c1; c++) {
+            if (!orient_pixel(buffer, c, 0, &out_x, &out_y)) continue;
+            uint8_t* dst_row = buffer->uyvy_buffer + (uint32_t)out_y * stride;
+            const uint8_t* pair = buffer->transpose_lines + (uint32_t)(c & ~1) * 2;
+            
+            for (uint8_t k = 0; k < count; k++) {
+                if (c >= buffer->transpose_widths[k]) continue;
+                if (!orient_pixel(buffer, c, buffer->transpose_rows[k], &out_x, &out_y)) continue;
+                const uint8_t* src = pair + k * line_bytes;
+                uint8_t* dst = dst_row + (uint32_t)out_x * 2;
+                dst[0] = (out_x & 1) ? src[2] : src[0];
+                dst[1] = src[1 + 2 * (c & 1)];
+            }
+            buffer->line_stamps[out_y] = buffer->sequence;
+        }
+    }
+}
+
+// Mark the stored pixel's row (and, when rotated, its column) as written
+static inline void stamp_pixel(frame_buffer_t* buffer, uint16_t out_x, uint16_t out_y) {
+    buffer->line_stamps[out_y] = buffer->sequence;
+    if (buffer->column_stamps) {
+        buffer->column_stamps[out_x] = buffer->sequence;
+    }
+}
+
 // ============================================================================
 // Frame Buffer Functions
 // ============================================================================
 
-bool frame_buffer_init(frame_buffer_t* buffer, uint16_t width, uint16_t height) {
+// Shared setup; the native frame comes from `pool` when given, otherwise the heap
+static bool frame_buffer_setup(frame_buffer_t* buffer, frame_pool_t* pool, uint16_t width, uint16_t height) {
     if (!buffer) {
         Serial.println("ERROR: Invalid buffer pointer");
         return false;
@@ -30,65 +199,89 @@ bool frame_buffer_init(frame_buffer_t* buffer, uint16_t width, uint16_t height)
     memset(buffer, 0, sizeof(frame_buffer_t));
     buffer->width = width;
     buffer->height = height;
-    buffer->format = FRAME_FORMAT_YCBCR;
+    buffer->format = FRAME_FORMAT_UYVY;
+    buffer->generation = 1;  // Caches start at generation 0 (stale)
+    buffer->sequence = 1;    // Line stamps start at 0 (missing)
+    buffer->missing_line_policy = FRAME_MISSING_KEEP;
     
-    // Calculate buffer sizes
-    size_t ycbcr_size = width * height * 3;  // Y, Cb, Cr for each pixel
-    size_t rgb_size = width * height * 3;    // R, G, B for each pixel
-    size_t rgb565_size = width * height * 2; // RGB565 for each pixel
-    size_t gray_size = width * height;       // Grayscale for each pixel
-    
-    // Allocate buffers
-    buffer->ycbcr_buffer = (uint8_t*)malloc(ycbcr_size);
-    buffer->rgb_buffer = (uint8_t*)malloc(rgb_size);
-    buffer->rgb565_buffer = (uint16_t*)malloc(rgb565_size);
-    buffer->gray_buffer = (uint8_t*)malloc(gray_size);
+    // Only the native frame is allocated up front
+    size_t uyvy_size = width * height * 2;   // Cb Y Cr Y per pixel pair
+    if (pool) {
+        if (pool->frame_size < uyvy_size) {
+            Serial.println("ERROR: Frame pool frames too small");
+            return false;
+        }
+        buffer->handle = frame_pool_acquire(pool);
+        buffer->uyvy_buffer = buffer->handle ? buffer->handle->data : nullptr;
+    } else {
+        buffer->uyvy_buffer = (uint8_t*)malloc(uyvy_size);
+    }
+    buffer->line_stamps = (uint32_t*)calloc(height, sizeof(uint32_t));
     
     // Check allocation
-    if (!buffer->ycbcr_buffer || !buffer->rgb_buffer || 
-        !buffer->rgb565_buffer || !buffer->gray_buffer) {
+    if (!buffer->uyvy_buffer || !buffer->line_stamps) {
         Serial.println("ERROR: Failed to allocate frame buffers");
         frame_buffer_deinit(buffer);
         return false;
     }
     
-    // Clear buffers
-    memset(buffer->ycbcr_buffer, 0, ycbcr_size);
-    memset(buffer->rgb_buffer, 0, rgb_size);
-    memset(buffer->rgb565_buffer, 0, rgb565_size);
-    memset(buffer->gray_buffer, 0, gray_size);
+    // Clear to black (Y=16, Cb=Cr=128)
+    for (size_t i = 0; i < uyvy_size; i += 2) {
+        buffer->uyvy_buffer[i] = 128;
+        buffer->uyvy_buffer[i + 1] = 16;
+    }
     
     Serial.printf("Frame buffer initialized: %dx%d\n", width, height);
-    Serial.printf("YCbCr buffer: %d bytes\n", ycbcr_size);
-    Serial.printf("RGB buffer: %d bytes\n", rgb_size);
-    Serial.printf("RGB565 buffer: %d bytes\n", rgb565_size);
-    Serial.printf("Grayscale buffer: %d bytes\n", gray_size);
+    Serial.printf("UYVY buffer: %d bytes%s (other formats converted on request)\n",
+                  uyvy_size, pool ? " from pool" : "");
     
     return true;
 }
 
+bool frame_buffer_init(frame_buffer_t* buffer, uint16_t width, uint16_t height) {
+    return frame_buffer_setup(buffer, nullptr, width, height);
+}
+
+bool frame_buffer_init_pooled(frame_buffer_t* buffer, frame_pool_t* pool, uint16_t width, uint16_t height) {
+    if (!frame_pool_is_initialized(pool)) {
+        Serial.println("ERROR: Frame pool not initialized");
+        return false;
+    }
+    return frame_buffer_setup(buffer, pool, width, height);
+}
+
 void frame_buffer_deinit(frame_buffer_t* buffer) {
     if (!buffer) return;
     
-    // Free allocated buffers
-    if (buffer->ycbcr_buffer) {
-        free(buffer->ycbcr_buffer);
-        buffer->ycbcr_buffer = nullptr;
+    // Free allocated buffers (pooled frames go back to their pool)
+    if (buffer->handle) {
+        frame_handle_release(buffer->handle);
+        buffer->handle = nullptr;
+    } else if (buffer->uyvy_buffer) {
+        free(buffer->uyvy_buffer);
     }
+    buffer->uyvy_buffer = nullptr;
     
-    if (buffer->rgb_buffer) {
-        free(buffer->rgb_buffer);
-        buffer->rgb_buffer = nullptr;
+    for (int i = 0; i < FRAME_FORMAT_COUNT; i++) {
+        if (buffer->caches[i].data) {
+            free(buffer->caches[i].data);
+            buffer->caches[i].data = nullptr;
+        }
     }
     
-    if (buffer->rgb565_buffer) {
-        free(buffer->rgb565_buffer);
-        buffer->rgb565_buffer = nullptr;
+    if (buffer->line_stamps) {
+        free(buffer->line_stamps);
+        buffer->line_stamps = nullptr;
     }
     
-    if (buffer->gray_buffer) {
-        free(buffer->gray_buffer);
-        buffer->gray_buffer = nullptr;
+    if (buffer->transpose_lines) {
+        free(buffer->transpose_lines);
+        buffer->transpose_lines = nullptr;
+    }
+    
+    if (buffer->column_stamps) {
+        free(buffer->column_stamps);
+        buffer->column_stamps = nullptr;
     }
     
     // Reset buffer structure
@@ -104,78 +297,569 @@ void frame_buffer_reset(frame_buffer_t* buffer) {
     buffer->frame_ready = false;
     buffer->pixels_received = 0;
     buffer->lines_received = 0;
+    buffer->lines_written = 0;
     buffer->frame_errors = 0;
     
-    // Clear buffers
-    if (buffer->ycbcr_buffer) {
-        memset(buffer->ycbcr_buffer, 0, buffer->width * buffer->height * 3);
+    // No clearing: a new sequence makes every row's stamp stale, and rows
+    // that are not rewritten are handled by frame_buffer_finish_frame()
+    buffer->sequence++;
+}
+
+bool frame_buffer_is_ready(frame_buffer_t* buffer) {
+    return buffer ? buffer->frame_ready : false;
+}
+
+// `row` and `uyvy` are in source orientation; the line is stored wherever the
+// buffer's orientation puts it
+void frame_buffer_write_line(frame_buffer_t* buffer, uint16_t row, const uint8_t* uyvy, uint16_t width) {
+    if (!buffer || !buffer->uyvy_buffer || !uyvy) {
+        return;
+    }
+    
+    if (is_rotated(buffer->orientation)) {
+        // Source lines become columns: gather a block of them, then transpose
+        if (row >= buffer->width || !buffer->transpose_lines) return;
+        if (width > buffer->height) width = buffer->height;
+        if (buffer->transpose_count == FRAME_TRANSPOSE_LINES) {
+            transpose_pending_lines(buffer);
+        }
+        uint8_t slot = buffer->transpose_count++;
+        memcpy(buffer->transpose_lines + (uint32_t)slot * buffer->height * 2, uyvy, width * 2);
+        buffer->transpose_rows[slot] = row;
+        buffer->transpose_widths[slot] = width;
+    } else {
+        if (row >= buffer->height) return;
+        if (width > buffer->width) width = buffer->width;
+        
+        uint16_t dst_row = (buffer->orientation & FRAME_ORIENT_FLIP) ? buffer->height - 1 - row : row;
+        uint8_t* dst = buffer->uyvy_buffer + (uint32_t)dst_row * buffer->width * 2;
+        if (buffer->orientation & FRAME_ORIENT_MIRROR) {
+            mirror_line_uyvy(dst, uyvy, width, buffer->width);
+        } else {
+            memcpy(dst, uyvy, width * 2);
+        }
+        buffer->line_stamps[dst_row] = buffer->sequence;
     }
-    if (buffer->rgb_buffer) {
-        memset(buffer->rgb_buffer, 0, buffer->width * buffer->height * 3);
+    
+    buffer->generation++;
+    buffer->pixels_received += width;
+    buffer->lines_written++;
+}
+
+void frame_buffer_invalidate(frame_buffer_t* buffer) {
+    if (buffer) {
+        buffer->generation++;
     }
-    if (buffer->rgb565_buffer) {
-        memset(buffer->rgb565_buffer, 0, buffer->width * buffer->height * 2);
+}
+
+void frame_buffer_finish_frame(frame_buffer_t* buffer, const frame_buffer_t* previous) {
+    if (!buffer || !buffer->uyvy_buffer || !buffer->line_stamps) return;
+    
+    transpose_pending_lines(buffer);
+    
+    uint32_t missing = 0;
+    uint32_t row_bytes = (uint32_t)buffer->width * 2;
+    bool repeat = previous && previous != buffer && previous->uyvy_buffer &&
+                  previous->width == buffer->width && previous->height == buffer->height;
+    bool black = buffer->missing_line_policy == FRAME_MISSING_BLACK;
+    
+    if (buffer->column_stamps) {
+        // Rotated: each source line is a column, so a dropped line leaves a column
+        for (uint16_t col = 0; col < buffer->width; col++) {
+            if (buffer->column_stamps[col] == buffer->sequence) continue;
+            
+            missing++;
+            if (!black && !repeat) continue;
+            
+            uint8_t* dst = buffer->uyvy_buffer + (uint32_t)col * 2;
+            const uint8_t* src = repeat ? previous->uyvy_buffer + (uint32_t)col * 2 : nullptr;
+            for (uint16_t row = 0; row < buffer->height; row++, dst += row_bytes) {
+                if (black) {
+                    dst[0] = 128;
+                    dst[1] = 16;
+                } else {
+                    memcpy(dst, src, 2);
+                    src += row_bytes;
+                }
+            }
+        }
+    } else {
+        for (uint16_t row = 0; row < buffer->height; row++) {
+            if (buffer->line_stamps[row] == buffer->sequence) continue;
+            
+            missing++;
+            
+            // Only missing rows are touched, never the whole frame
+            uint8_t* dst = buffer->uyvy_buffer + row * row_bytes;
+            if (black) {
+                for (uint32_t i = 0; i < row_bytes; i += 2) {
+                    dst[i] = 128;
+                    dst[i + 1] = 16;
+                }
+            } else if (repeat) {
+                memcpy(dst, previous->uyvy_buffer + row * row_bytes, row_bytes);
+            }
+        }
     }
-    if (buffer->gray_buffer) {
-        memset(buffer->gray_buffer, 0, buffer->width * buffer->height);
+    
+    buffer->lines_missing = missing;
+    if (missing) {
+        buffer->generation++;
     }
 }
 
-bool frame_buffer_is_ready(frame_buffer_t* buffer) {
-    return buffer ? buffer->frame_ready : false;
+bool frame_buffer_is_line_valid(frame_buffer_t* buffer, uint16_t row) {
+    if (!buffer || !buffer->line_stamps || row >= buffer->height) {
+        return false;
+    }
+    return buffer->line_stamps[row] == buffer->sequence;
+}
+
+// Every row of the native frame was written directly (e.g. through an image view)
+void frame_buffer_mark_written(frame_buffer_t* buffer) {
+    if (!buffer || !buffer->line_stamps) return;
+    
+    for (uint16_t row = 0; row < buffer->height; row++) {
+        buffer->line_stamps[row] = buffer->sequence;
+    }
+    if (buffer->column_stamps) {
+        for (uint16_t col = 0; col < buffer->width; col++) {
+            buffer->column_stamps[col] = buffer->sequence;
+        }
+    }
+    buffer->generation++;
+    buffer->pixels_received = (uint32_t)buffer->width * buffer->height;
+    buffer->lines_written = buffer->height;
+}
+
+// Store source lines mirrored, flipped or rotated from now on. Rotations need
+// a buffer allocated with the source dimensions swapped, plus room for
+// FRAME_TRANSPOSE_LINES source lines that is allocated here.
+bool frame_buffer_set_orientation(frame_buffer_t* buffer, uint8_t orientation) {
+    if (!buffer || !buffer->uyvy_buffer || orientation > FRAME_ORIENT_ROTATE_270) {
+        Serial.println("ERROR: Invalid frame orientation");
+        return false;
+    }
+    
+    transpose_pending_lines(buffer);
+    
+    if (is_rotated(orientation) && !buffer->transpose_lines) {
+        buffer->transpose_lines = (uint8_t*)malloc((uint32_t)FRAME_TRANSPOSE_LINES * buffer->height * 2);
+        buffer->column_stamps = (uint32_t*)calloc(buffer->width, sizeof(uint32_t));
+        if (!buffer->transpose_lines || !buffer->column_stamps) {
+            Serial.println("ERROR: Failed to allocate transpose lines");
+            free(buffer->transpose_lines);
+            free(buffer->column_stamps);
+            buffer->transpose_lines = nullptr;
+            buffer->column_stamps = nullptr;
+            return false;
+        }
+    } else if (!is_rotated(orientation) && buffer->transpose_lines) {
+        free(buffer->transpose_lines);
+        free(buffer->column_stamps);
+        buffer->transpose_lines = nullptr;
+        buffer->column_stamps = nullptr;
+    }
+    
+    buffer->orientation = orientation;
+    buffer->generation++;
+    return true;
+}
+
+// Keep the native frame alive past the buffer's next reuse. The caller owns
+// one reference and drops it with frame_handle_release(). NULL if not pooled.
+frame_handle_t* frame_buffer_retain(frame_buffer_t* buffer) {
+    if (!buffer || !buffer->handle) return nullptr;
+    
+    frame_handle_retain(buffer->handle);
+    return buffer->handle;
+}
+
+// Before rewriting a buffer, swap out a native frame someone still retains.
+// Returns false if the pool had no spare frame; the retained frame is then reused.
+bool IRAM_ATTR frame_buffer_rebind(frame_buffer_t* buffer) {
+    if (!buffer || !frame_handle_is_shared(buffer->handle)) return true;
+    
+    frame_handle_t* fresh = frame_pool_acquire(buffer->handle->pool);
+    if (!fresh) {
+        return false;  // Counted in the pool's exhausted statistic
+    }
+    
+    frame_handle_release(buffer->handle);
+    buffer->handle = fresh;
+    buffer->uyvy_buffer = fresh->data;
+    
+    // New memory holds nothing from this buffer: all rows and caches are stale
+    buffer->sequence++;
+    buffer->generation++;
+    return true;
 }
 
 // ============================================================================
 // Frame Buffer Access Functions
 // ============================================================================
 
+uint8_t* frame_buffer_get_uyvy(frame_buffer_t* buffer) {
+    return buffer ? buffer->uyvy_buffer : nullptr;
+}
+
+// View of the native frame; crop, field and ROI views are slices of it
+video_image_t frame_buffer_get_image(frame_buffer_t* buffer) {
+    if (!buffer || !buffer->uyvy_buffer) {
+        return video_image_make(nullptr, 0, 0, FRAME_FORMAT_UYVY);
+    }
+    return video_image_make(buffer->uyvy_buffer, buffer->width, buffer->height, FRAME_FORMAT_UYVY);
+}
+
+// View of the frame in `format`, converted on first request like frame_buffer_get_format()
+video_image_t frame_buffer_get_format_image(frame_buffer_t* buffer, uint8_t format) {
+    uint8_t* data = frame_buffer_get_format(buffer, format);
+    if (!data) {
+        return video_image_make(nullptr, 0, 0, format);
+    }
+    return video_image_make(data, buffer->width, buffer->height, format);
+}
+
+// View of one field (0 = even rows, 1 = odd rows) of the native frame, without copying
+video_image_t frame_buffer_get_field(frame_buffer_t* buffer, uint8_t field) {
+    video_image_t frame = frame_buffer_get_image(buffer);
+    return video_image_field(&frame, field);
+}
+
+uint8_t* frame_buffer_get_format(frame_buffer_t* buffer, uint8_t format) {
+    if (!buffer || !buffer->uyvy_buffer || format >= FRAME_FORMAT_COUNT) {
+        return nullptr;
+    }
+    
+    if (format == FRAME_FORMAT_UYVY) {
+        return buffer->uyvy_buffer;
+    }
+    
+    frame_cache_t* cache = &buffer->caches[format];
+    
+    // First request for this format allocates its cache
+    if (!cache->data) {
+        cache->data = (uint8_t*)malloc((size_t)buffer->width * buffer->height * video_image_bytes_per_pixel(format));
+        if (!cache->data) {
+            Serial.println("ERROR: Failed to allocate frame conversion cache");
+            return nullptr;
+        }
+        cache->generation = 0;
+    }
+    
+    // Convert once per frame generation
+    if (cache->generation != buffer->generation) {
+        convert_frame(buffer, format, cache->data);
+        cache->generation = buffer->generation;
+        buffer->conversions++;
+    }
+    
+    return cache->data;
+}
+
 uint8_t* frame_buffer_get_ycbcr(frame_buffer_t* buffer) {
-    return buffer ? buffer->ycbcr_buffer : nullptr;
+    return frame_buffer_get_format(buffer, FRAME_FORMAT_YCBCR);
 }
 
 uint8_t* frame_buffer_get_rgb(frame_buffer_t* buffer) {
-    return buffer ? buffer->rgb_buffer : nullptr;
+    return frame_buffer_get_format(buffer, FRAME_FORMAT_RGB);
 }
 
 uint16_t* frame_buffer_get_rgb565(frame_buffer_t* buffer) {
-    return buffer ? buffer->rgb565_buffer : nullptr;
+    return (uint16_t*)frame_buffer_get_format(buffer, FRAME_FORMAT_RGB565);
 }
 
 uint8_t* frame_buffer_get_gray(frame_buffer_t* buffer) {
-    return buffer ? buffer->gray_buffer : nullptr;
+    return frame_buffer_get_format(buffer, FRAME_FORMAT_GRAY);
 }
 
 // ============================================================================
 // Video Processing Functions
 // ============================================================================
 
+// Tone curve parameters taken from the processing configuration
+static video_tone_params_t tone_params_from_config(const video_processing_config_t* config) {
+    video_tone_params_t params;
+    params.brightness = config->brightness;
+    params.contrast = config->contrast;
+    params.saturation = config->saturation;
+    params.gamma = config->gamma;
+    return params;
+}
+
+// RGB caches depend on the palette, so every slot drops them when a new one goes live
+static void invalidate_palette_caches() {
+    for (int c = 0; c < VIDEO_CHANNEL_COUNT; c++) {
+        for (int i = 0; i < FRAME_RING_SLOTS; i++) {
+            frame_buffer_invalidate(&g_channels[c].frame_ring.slots[i]);
+        }
+    }
+}
+
+// Deinterlaced rows go to the frame being written, in place of the woven lines
+static void store_deinterlaced_line(video_channel_t* channel, const video_image_t* line, uint16_t row) {
+    frame_buffer_write_line(channel->write_frame, row, line->data, line->width);
+}
+
+static bool deinterlace_enabled(video_channel_t* channel) {
+    return channel->deinterlace.field_store && channel->deinterlace.config.mode != VIDEO_DEINTERLACE_OFF;
+}
+
+// Last step for every processed line: into the deinterlacer or straight into the frame
+static void store_line(video_channel_t* channel, const uint8_t* uyvy, uint16_t width, uint16_t row) {
+    if (deinterlace_enabled(channel)) {
+        video_deinterlace_push_line(&channel->deinterlace, uyvy, row);
+    } else {
+        frame_buffer_write_line(channel->write_frame, row, uyvy, width);
+    }
+}
+
+// Stage callbacks carry no context, so each channel has its own
+static void deinterlace_output_left(const video_image_t* line, uint16_t row) {
+    store_deinterlaced_line(&g_channels[VIDEO_CHANNEL_LEFT], line, row);
+}
+
+static void deinterlace_output_right(const video_image_t* line, uint16_t row) {
+    store_deinterlaced_line(&g_channels[VIDEO_CHANNEL_RIGHT], line, row);
+}
+
+static void sharpen_output_left(const video_image_t* line, uint16_t row) {
+    store_line(&g_channels[VIDEO_CHANNEL_LEFT], line->data, line->width, row);
+}
+
+static void sharpen_output_right(const video_image_t* line, uint16_t row) {
+    store_line(&g_channels[VIDEO_CHANNEL_RIGHT], line->data, line->width, row);
+}
+
+static void (* const g_deinterlace_outputs[VIDEO_CHANNEL_COUNT])(const video_image_t* line, uint16_t row) = {
+    deinterlace_output_left, deinterlace_output_right
+};
+
+static void (* const g_sharpen_outputs[VIDEO_CHANNEL_COUNT])(const video_image_t* line, uint16_t row) = {
+    sharpen_output_left, sharpen_output_right
+};
+
+// Per-stream stages, then the channel's frames. A stage that fails is only
+// disabled; without frames the channel cannot run.
+static bool channel_init(uint8_t index, uint16_t frame_width, uint16_t frame_height) {
+    video_channel_t* channel = &g_channels[index];
+    memset(channel, 0, sizeof(video_channel_t));
+    
+    if (g_processing_config.clahe_tiles > 0) {
+        video_clahe_config_t clahe_config = VIDEO_CLAHE_DEFAULT_CONFIG;
+        clahe_config.width = FRAME_WIDTH;
+        clahe_config.height = FRAME_HEIGHT;
+        clahe_config.tiles_x = g_processing_config.clahe_tiles;
+        clahe_config.tiles_y = g_processing_config.clahe_tiles;
+        clahe_config.clip_limit = g_processing_config.clahe_clip_limit;
+        if (!video_clahe_init(&channel->clahe, &clahe_config)) {
+            Serial.println("WARNING: CLAHE disabled");
+        }
+    }
+    
+    if (g_processing_config.sharpen_amount > 0) {
+        video_sharpen_config_t sharpen_config = VIDEO_SHARPEN_DEFAULT_CONFIG;
+        sharpen_config.width = FRAME_WIDTH;
+        sharpen_config.amount = g_processing_config.sharpen_amount;
+        sharpen_config.threshold = g_processing_config.sharpen_threshold;
+        if (video_sharpen_init(&channel->sharpen, &sharpen_config)) {
+            video_sharpen_set_line_callback(&channel->sharpen, g_sharpen_outputs[index]);
+        } else {
+            Serial.println("WARNING: Sharpening disabled");
+        }
+    }
+    
+    // The offset map is subtracted from source lines but calibrated and patched
+    // on stored frames, so both must share one orientation
+    if (g_processing_config.enable_dark_correction && g_processing_config.orientation != FRAME_ORIENT_NORMAL) {
+        Serial.println("WARNING: Dark-frame correction needs FRAME_ORIENT_NORMAL, disabled");
+    } else if (g_processing_config.enable_dark_correction) {
+        video_darkframe_config_t darkframe_config = VIDEO_DARKFRAME_DEFAULT_CONFIG;
+        darkframe_config.width = FRAME_WIDTH;
+        darkframe_config.height = FRAME_HEIGHT;
+        if (!video_darkframe_init(&channel->darkframe, &darkframe_config)) {
+            Serial.println("WARNING: Dark-frame correction disabled");
+        }
+    }
+    
+    if (g_processing_config.denoise_strength > 0) {
+        video_denoise_config_t denoise_config = VIDEO_DENOISE_DEFAULT_CONFIG;
+        denoise_config.width = FRAME_WIDTH;
+        denoise_config.height = FRAME_HEIGHT;
+        denoise_config.strength = g_processing_config.denoise_strength;
+        if (!video_denoise_init(&channel->denoise, &denoise_config)) {
+            Serial.println("WARNING: Noise reduction disabled");
+        }
+    }
+    
+    if (g_processing_config.deinterlace != VIDEO_DEINTERLACE_OFF) {
+        video_deinterlace_config_t deinterlace_config = VIDEO_DEINTERLACE_DEFAULT_CONFIG;
+        deinterlace_config.width = FRAME_WIDTH;
+        deinterlace_config.height = FRAME_HEIGHT;
+        deinterlace_config.format = FRAME_FORMAT_UYVY;
+        deinterlace_config.mode = (video_deinterlace_mode_t)g_processing_config.deinterlace;
+        if (video_deinterlace_init(&channel->deinterlace, &deinterlace_config)) {
+            video_deinterlace_set_line_callback(&channel->deinterlace, g_deinterlace_outputs[index]);
+        } else {
+            Serial.println("WARNING: Deinterlacing disabled");
+        }
+    }
+    
+    // Preallocate every frame so steady-state capture never touches the heap
+    if (!frame_pool_init(&channel->frame_pool, FRAME_WIDTH * FRAME_HEIGHT * 2, FRAME_RING_SLOTS + FRAME_POOL_SPARE)) {
+        Serial.println("ERROR: Failed to initialize frame pool");
+        return false;
+    }
+    
+    // Initialize frame ring (decoder writes one slot while processing reads another)
+    if (!frame_ring_init(&channel->frame_ring, &channel->frame_pool, frame_width, frame_height)) {
+        Serial.println("ERROR: Failed to initialize frame buffer");
+        return false;
+    }
+    for (int i = 0; i < FRAME_RING_SLOTS; i++) {
+        channel->frame_ring.slots[i].palette = &g_palette;
+        if (!frame_buffer_set_orientation(&channel->frame_ring.slots[i], g_processing_config.orientation)) {
+            return false;
+        }
+    }
+    channel->write_frame = frame_ring_get_write_frame(&channel->frame_ring);
+    channel->active = true;
+    return true;
+}
+
+static void channel_deinit(video_channel_t* channel) {
+    video_clahe_deinit(&channel->clahe);
+    video_sharpen_deinit(&channel->sharpen);
+    video_darkframe_deinit(&channel->darkframe);
+    video_denoise_deinit(&channel->denoise);
+    video_deinterlace_deinit(&channel->deinterlace);
+    channel->write_frame = nullptr;
+    channel->active = false;
+    frame_ring_deinit(&channel->frame_ring);
+    frame_pool_deinit(&channel->frame_pool);
+}
+
 bool video_processing_init(const video_processing_config_t* config) {
     if (config) {
         g_processing_config = *config;
     }
     
-    // Initialize frame buffer
-    if (!frame_buffer_init(&g_frame_buffer, FRAME_WIDTH, FRAME_HEIGHT)) {
-        Serial.println("ERROR: Failed to initialize frame buffer");
+    if (g_processing_config.channels < 1 || g_processing_config.channels > VIDEO_CHANNEL_COUNT) {
+        Serial.println("ERROR: Invalid channel count");
         return false;
     }
     
-    Serial.println("Video processing initialized successfully");
+    video_tone_params_t tone_params = tone_params_from_config(&g_processing_config);
+    video_tone_init(&g_tone, &tone_params);
+    video_palette_init(&g_palette, (video_palette_id_t)g_processing_config.palette);
+    
+    // Frames are stored in mount orientation; a 90 degree mount swaps their size
+    bool rotated = is_rotated(g_processing_config.orientation);
+    uint16_t frame_width = rotated ? FRAME_HEIGHT : FRAME_WIDTH;
+    uint16_t frame_height = rotated ? FRAME_WIDTH : FRAME_HEIGHT;
+    
+    for (uint8_t i = 0; i < g_processing_config.channels; i++) {
+        if (!channel_init(i, frame_width, frame_height)) {
+            video_processing_deinit();
+            return false;
+        }
+    }
+    
+    if (g_processing_config.channels == 2) {
+        video_stereo_config_t stereo_config = VIDEO_STEREO_DEFAULT_CONFIG;
+        stereo_config.tolerance_us = g_processing_config.pair_tolerance_us;
+        video_stereo_init(&g_stereo, &stereo_config, &g_channels[VIDEO_CHANNEL_LEFT].frame_ring,
+                          &g_channels[VIDEO_CHANNEL_RIGHT].frame_ring);
+    }
+    
+    if (g_processing_config.stack_depth > 0) {
+        video_stack_config_t stack_config = VIDEO_STACK_DEFAULT_CONFIG;
+        stack_config.width = frame_width;
+        stack_config.height = frame_height;
+        stack_config.depth = g_processing_config.stack_depth;
+        if (!video_stack_init(&g_stack, &stack_config) ||
+            !frame_ring_init(&g_stack_ring, nullptr, frame_width, frame_height)) {
+            Serial.println("WARNING: Frame stacking disabled");
+            video_stack_deinit(&g_stack);
+        }
+    }
+    
+    if (g_processing_config.output_width != frame_width || g_processing_config.output_height != frame_height) {
+        video_scaler_config_t scaler_config;
+        scaler_config.src_width = frame_width;
+        scaler_config.src_height = frame_height;
+        scaler_config.dst_width = g_processing_config.output_width;
+        scaler_config.dst_height = g_processing_config.output_height;
+        scaler_config.format = FRAME_FORMAT_UYVY;
+        scaler_config.mode = VIDEO_SCALER_AUTO;
+        if (!video_scaler_init(&g_scaler, &scaler_config)) {
+            Serial.println("WARNING: Output scaling disabled");
+        }
+    }
+    
+    if (g_processing_config.lens_k1 != 0 || g_processing_config.lens_k2 != 0) {
+        video_remap_config_t remap_config = VIDEO_REMAP_DEFAULT_CONFIG;
+        remap_config.src_width = frame_width;
+        remap_config.src_height = frame_height;
+        remap_config.dst_width = g_processing_config.output_width;
+        remap_config.dst_height = g_processing_config.output_height;
+        remap_config.format = g_processing_config.output_format;
+        if (!video_remap_init(&g_remap, &remap_config) ||
+            !video_remap_build_radial(&g_remap, g_processing_config.lens_k1 / 100.0f,
+                                      g_processing_config.lens_k2 / 100.0f, 1.0f)) {
+            Serial.println("WARNING: Lens correction disabled");
+            video_remap_deinit(&g_remap);
+        }
+    }
+    
+    Serial.printf("Video processing initialized successfully (%d channel%s)\n",
+                  g_processing_config.channels, g_processing_config.channels > 1 ? "s" : "");
     return true;
 }
 
 void video_processing_deinit(void) {
-    frame_buffer_deinit(&g_frame_buffer);
+    for (int i = 0; i < VIDEO_CHANNEL_COUNT; i++) {
+        channel_deinit(&g_channels[i]);
+    }
+    video_stereo_deinit(&g_stereo);
+    video_scaler_deinit(&g_scaler);
+    video_remap_deinit(&g_remap);
+    video_stack_deinit(&g_stack);
+    frame_ring_deinit(&g_stack_ring);
     Serial.println("Video processing deinitialized");
 }
 
+// Channel whose frame ring holds `buffer` (NULL for frames from elsewhere)
+static video_channel_t* channel_of_frame(const frame_buffer_t* buffer) {
+    for (int i = 0; i < VIDEO_CHANNEL_COUNT; i++) {
+        const frame_buffer_t* slots = g_channels[i].frame_ring.slots;
+        if (buffer >= slots && buffer < slots + FRAME_RING_SLOTS) {
+            return &g_channels[i];
+        }
+    }
+    return nullptr;
+}
+
 void video_processing_process_frame(frame_buffer_t* buffer) {
     if (!buffer || !buffer->frame_ready) return;
     
+    video_channel_t* channel = channel_of_frame(buffer);
+    video_darkframe_t* darkframe = channel ? &channel->darkframe : nullptr;
+    
     g_total_frames_processed++;
     g_total_pixels_processed += buffer->pixels_received;
     g_last_frame_time = micros();
     
+    // Dark frames feed the calibration; otherwise hot pixels are patched (sparse, consumer side)
+    if (video_darkframe_is_calibrating(darkframe)) {
+        video_image_t image = frame_buffer_get_image(buffer);
+        video_darkframe_add_calibration_frame(darkframe, &image);
+    } else if (video_darkframe_is_valid(darkframe) && darkframe->hot_count > 0) {
+        video_image_t image = frame_buffer_get_image(buffer);
+        video_darkframe_patch_image(darkframe, &image);
+        frame_buffer_invalidate(buffer);
+    }
+    
     // Process frame based on configuration
     switch (g_processing_config.process_mode) {
         case PROCESS_MODE_DISPLAY:
@@ -208,9 +892,169 @@ void video_processing_process_frame(frame_buffer_t* buffer) {
     buffer->frame_ready = false;
 }
 
+// Consumer side: process the newest complete frame, if one arrived since the last call.
+// Runs outside the decoder callbacks, so slow processing only drops frames.
+frame_buffer_t* video_processing_acquire_frame(void) {
+    return video_processing_acquire_channel_frame(VIDEO_CHANNEL_LEFT);
+}
+
+frame_buffer_t* video_processing_acquire_channel_frame(uint8_t channel) {
+    if (channel >= VIDEO_CHANNEL_COUNT || !g_channels[channel].active) return nullptr;
+    
+    frame_buffer_t* frame = frame_ring_acquire_latest(&g_channels[channel].frame_ring);
+    if (!frame) return nullptr;
+    
+    if (g_processing_config.enable_processing) {
+        video_processing_process_frame(frame);
+    }
+    return frame;
+}
+
+// Binocular consumer side: the next left and right frames captured within
+// pair_tolerance_us, both processed. Use instead of acquiring either channel;
+// the frames stay valid until the next call.
+bool video_processing_acquire_pair(frame_buffer_t** left, frame_buffer_t** right) {
+    if (!left || !right || !g_stereo.left_ring) return false;
+    
+    video_stereo_pair_t pair;
+    if (!video_stereo_acquire_pair(&g_stereo, &pair)) return false;
+    
+    if (g_processing_config.enable_processing) {
+        video_processing_process_frame(pair.left);
+        video_processing_process_frame(pair.right);
+    }
+    *left = pair.left;
+    *right = pair.right;
+    return true;
+}
+
+// Average the next `frames` processed frames (lens covered) into the dark-frame
+// map of every channel
+bool video_processing_calibrate_dark_frames(uint16_t frames) {
+    bool started = false;
+    for (int i = 0; i < VIDEO_CHANNEL_COUNT; i++) {
+        video_darkframe_t* darkframe = &g_channels[i].darkframe;
+        if (darkframe->offsets && !video_darkframe_begin_calibration(darkframe, frames)) {
+            return false;
+        }
+        started |= darkframe->offsets != nullptr;
+    }
+    return started;
+}
+
+// Map for saving (video_darkframe_save) or restoring (video_darkframe_load)
+video_darkframe_t* video_processing_get_darkframe(void) {
+    return video_processing_get_channel_darkframe(VIDEO_CHANNEL_LEFT);
+}
+
+video_darkframe_t* video_processing_get_channel_darkframe(uint8_t channel) {
+    if (channel >= VIDEO_CHANNEL_COUNT || !g_channels[channel].darkframe.offsets) return nullptr;
+    return &g_channels[channel].darkframe;
+}
+
+// Stacking stage: consumes the newest decoded frame and publishes its running
+// average to the stack ring. Call from the processing task instead of
+// video_processing_acquire_frame(); returns true if a frame was stacked.
+bool video_processing_stack_frame(void) {
+    if (!g_stack.sums) return false;
+    
+    frame_buffer_t* frame = frame_ring_acquire_latest(&g_channels[VIDEO_CHANNEL_LEFT].frame_ring);
+    if (!frame) return false;
+    
+    frame_buffer_t* stacked = frame_ring_get_write_frame(&g_stack_ring);
+    frame_buffer_reset(stacked);
+    
+    video_image_t src = frame_buffer_get_image(frame);
+    video_image_t dst = frame_buffer_get_image(stacked);
+    if (!video_stack_process(&g_stack, &src, &dst)) {
+        return false;
+    }
+    
+    frame_buffer_mark_written(stacked);
+    stacked->field = frame->field;
+    stacked->frame_number = frame->frame_number;
+    stacked->timestamp = frame->timestamp;
+    stacked->frame_complete = true;
+    stacked->frame_ready = true;
+    
+    frame_ring_publish(&g_stack_ring);
+    return true;
+}
+
+// Consumer side of the stack ring: the newest averaged frame, if one is new
+frame_buffer_t* video_processing_acquire_stacked_frame(void) {
+    if (!g_stack.sums) return nullptr;
+    return frame_ring_acquire_latest(&g_stack_ring);
+}
+
+// Resample an acquired frame to the configured output size. `dst` must be a
+// UYVY view of output_width x output_height; false if scaling is not enabled.
+bool video_processing_scale_output(frame_buffer_t* buffer, const video_image_t* dst) {
+    if (!buffer || !g_scaler.ring) return false;
+    
+    video_image_t src = frame_buffer_get_image(buffer);
+    return video_scaler_scale_image(&g_scaler, &src, dst);
+}
+
+// Remap an acquired frame for the eyepiece, scaling to the output size in the
+// same pass. `dst` must be an output_format view of output_width x
+// output_height; false if lens correction is not enabled.
+bool video_processing_correct_lens(frame_buffer_t* buffer, const video_image_t* dst) {
+    if (!buffer || !g_remap.grid) return false;
+    
+    video_image_t src = frame_buffer_get_format_image(buffer, g_remap.config.format);
+    return video_remap_apply(&g_remap, &src, dst);
+}
+
 void video_processing_set_config(const video_processing_config_t* config) {
     if (config) {
+        bool lens_changed = config->lens_k1 != g_processing_config.lens_k1 ||
+                            config->lens_k2 != g_processing_config.lens_k2;
+        uint8_t orientation = g_processing_config.orientation;
+        uint8_t channels = g_processing_config.channels;
         g_processing_config = *config;
+        g_processing_config.orientation = orientation;  // Fixed at init (it sizes the frames)
+        g_processing_config.channels = channels;
+        
+        // LUTs are rebuilt only if brightness/contrast/saturation/gamma changed
+        video_tone_params_t tone_params = tone_params_from_config(config);
+        video_tone_set_params(&g_tone, &tone_params);
+        
+        // Palette swap is published atomically, the decoder never waits on it
+        if (video_palette_get_selected(&g_palette) != config->palette &&
+            video_palette_select(&g_palette, (video_palette_id_t)config->palette)) {
+            invalidate_palette_caches();
+        }
+        
+        for (int c = 0; c < VIDEO_CHANNEL_COUNT; c++) {
+            video_channel_t* channel = &g_channels[c];
+            video_clahe_set_clip_limit(&channel->clahe, config->clahe_clip_limit);
+            
+            if (channel->denoise.history) {
+                video_denoise_set_strength(&channel->denoise, config->denoise_strength,
+                                           channel->denoise.config.motion_threshold);
+            }
+            
+            if (channel->sharpen.lines) {
+                video_sharpen_set_params(&channel->sharpen, config->sharpen_amount, config->sharpen_threshold);
+            }
+            
+            // Modes switch at runtime; the field store is only allocated if enabled at init
+            if (channel->deinterlace.field_store) {
+                video_deinterlace_set_mode(&channel->deinterlace, (video_deinterlace_mode_t)config->deinterlace);
+            }
+        }
+        
+        // The grid is rebuilt once per change, never per frame
+        if (g_remap.grid && lens_changed) {
+            video_remap_build_radial(&g_remap, config->lens_k1 / 100.0f, config->lens_k2 / 100.0f, 1.0f);
+        }
+        
+        // Stack depth is fixed at init (it sizes the buffers); changing it restarts averaging
+        if (g_stack.sums && config->stack_depth != g_stack.config.depth) {
+            video_stack_reset(&g_stack);
+        }
+        
         Serial.println("Video processing configuration updated");
     }
 }
@@ -219,100 +1063,455 @@ void video_processing_set_config(const video_processing_config_t* config) {
 // BT656 Decoder Callback Functions
 // ============================================================================
 
-void example_ycbcr_callback(bt656_ycbcr_t* pixel, uint16_t x, uint16_t y) {
-    if (!pixel || x >= g_frame_buffer.width || y >= g_frame_buffer.height) {
+static void channel_ycbcr(video_channel_t* channel, bt656_ycbcr_t* pixel, uint16_t x, uint16_t y) {
+    frame_buffer_t* frame = channel->write_frame;
+    uint16_t out_x, out_y;
+    if (!pixel || !frame || !orient_pixel(frame, x, y, &out_x, &out_y)) {
+        return;
+    }
+    
+    // One 16-bit store: chroma (Cb on even, Cr on odd stored pixels) then luma
+    uint32_t index = (uint32_t)out_y * frame->width + out_x;
+    uint16_t sample = ((out_x & 1) ? pixel->cr : pixel->cb) | (pixel->y << 8);
+    memcpy(frame->uyvy_buffer + index * 2, &sample, 2);
+    stamp_pixel(frame, out_x, out_y);
+    
+    frame->pixels_received++;
+}
+
+static void channel_rgb(video_channel_t* channel, bt656_rgb_t* pixel, uint16_t x, uint16_t y) {
+    frame_buffer_t* frame = channel->write_frame;
+    uint16_t out_x, out_y;
+    if (!pixel || !frame || !orient_pixel(frame, x, y, &out_x, &out_y)) {
+        return;
+    }
+    
+    // Storage is native UYVY: convert back with the BT.601 forward transform
+    bt656_ycbcr_t ycbcr;
+    ycbcr.y = clamp_u8(((66 * pixel->r + 129 * pixel->g + 25 * pixel->b + 128) >> 8) + 16);
+    ycbcr.cb = clamp_u8(((-38 * pixel->r - 74 * pixel->g + 112 * pixel->b + 128) >> 8) + 128);
+    ycbcr.cr = clamp_u8(((112 * pixel->r - 94 * pixel->g - 18 * pixel->b + 128) >> 8) + 128);
+    
+    uint8_t* dst = frame->uyvy_buffer + ((uint32_t)out_y * frame->width + out_x) * 2;
+    dst[0] = (out_x & 1) ? ycbcr.cr : ycbcr.cb;
+    dst[1] = ycbcr.y;
+    stamp_pixel(frame, out_x, out_y);
+}
+
+static void channel_frame_end(video_channel_t* channel) {
+    frame_buffer_t* frame = channel->write_frame;
+    if (!frame) return;
+    
+    // Lines the unsharp mask still holds belong to the field that just ended
+    video_sharpen_flush(&channel->sharpen);
+    
+    // A tone change that waited for the idle table is published between fields,
+    // when no line holds it
+    video_tone_update(&g_tone);
+    if (video_palette_update(&g_palette)) {
+        invalidate_palette_caches();
+    }
+    
+    // Vertical blanking follows every field; woven frames are complete after field 1,
+    // deinterlaced frames after every field
+    bool per_field = deinterlace_enabled(channel);
+    if (per_field) {
+        video_deinterlace_end_field(&channel->deinterlace);
+    }
+    
+    // Nothing arrived since the last frame (e.g. the blanking before the first
+    // field); pixels_received counts both line output and per-pixel writes
+    if (frame->pixels_received == 0) {
         return;
     }
+    if (!per_field && frame->lines_written > 0 && frame->field == 0) {
+        return;
+    }
+    
+    // Per-pixel writes bypass frame_buffer_write_line, so invalidate caches here
+    frame_buffer_invalidate(frame);
+    frame_buffer_finish_frame(frame, frame_ring_get_last_published(&channel->frame_ring));
     
-    // Calculate buffer index
-    uint32_t index = (y * g_frame_buffer.width + x) * 3;
+    frame->frame_number = ++channel->frame_counter;
+    frame->timestamp = micros();
+    frame->frame_complete = true;
+    frame->frame_ready = true;
     
-    // Store YCbCr pixel in buffer
-    if (g_frame_buffer.ycbcr_buffer) {
-        g_frame_buffer.ycbcr_buffer[index + 0] = pixel->y;
-        g_frame_buffer.ycbcr_buffer[index + 1] = pixel->cb;
-        g_frame_buffer.ycbcr_buffer[index + 2] = pixel->cr;
+    if (g_processing_config.enable_debug) {
+        Serial.printf("Frame %lu complete: %lu pixels, %lu lines, %lu missing\n", 
+                     frame->frame_number,
+                     frame->pixels_received,
+                     frame->lines_received,
+                     frame->lines_missing);
     }
     
-    // Convert to RGB and store
-    bt656_rgb_t rgb = bt656_ycbcr_to_rgb(*pixel);
-    if (g_frame_buffer.rgb_buffer) {
-        g_frame_buffer.rgb_buffer[index + 0] = rgb.r;
-        g_frame_buffer.rgb_buffer[index + 1] = rgb.g;
-        g_frame_buffer.rgb_buffer[index + 2] = rgb.b;
+    // Tile histograms of this frame become the maps for the next one
+    if (g_processing_config.enable_processing && (!per_field || frame->field == 1)) {
+        video_clahe_end_frame(&channel->clahe);
     }
     
-    // Convert to RGB565 and store
-    if (g_frame_buffer.rgb565_buffer) {
-        uint32_t rgb565_index = y * g_frame_buffer.width + x;
-        g_frame_buffer.rgb565_buffer[rgb565_index] = bt656_rgb_to_rgb565(rgb);
+    // Hand the frame to the consumer and continue on a free slot (single atomic swap)
+    channel->write_frame = frame_ring_publish(&channel->frame_ring);
+    frame_buffer_reset(channel->write_frame);
+}
+
+static void channel_line(video_channel_t* channel, uint16_t line_number) {
+    if (channel->write_frame) {
+        channel->write_frame->lines_received++;
     }
     
-    // Convert to grayscale and store
-    if (g_frame_buffer.gray_buffer) {
-        uint32_t gray_index = y * g_frame_buffer.width + x;
-        g_frame_buffer.gray_buffer[gray_index] = bt656_ycbcr_to_grayscale(*pixel);
+    if (g_processing_config.enable_debug && line_number % 100 == 0) {
+        Serial.printf("Line %d received\n", line_number);
+    }
+}
+
+static void channel_line_output(video_channel_t* channel, bt656_line_t* line) {
+    frame_buffer_t* frame = channel->write_frame;
+    if (!line || !line->data || !frame) return;
+    
+    // Decoder rows already weave both fields (field 0 on even rows, field 1 on
+    // odd rows) and account for the window and any decimation
+    uint16_t row = line->row;
+    
+    // Tone curve in place, one pass over the line
+    if (g_processing_config.enable_processing) {
+        // Fixed-pattern offsets come off the raw samples first
+        video_darkframe_subtract_uyvy(&channel->darkframe, line->data, line->width, row);
+        
+        if (channel->denoise.history) {
+            // Temporal filter and tone curve in the same pass
+            video_denoise_apply_uyvy(&channel->denoise, &g_tone, line->data, line->width, row);
+        } else {
+            video_tone_apply_uyvy(&g_tone, line->data, line->width);
+        }
+        
+        // Histogram this line and remap it with the previous frame's tiles
+        video_clahe_process_uyvy(&channel->clahe, line->data, line->width, row);
     }
     
-    g_frame_buffer.pixels_received++;
+    frame->field = line->field ? 1 : 0;
+    
+    // Sharpened lines come back through the channel's sharpen output, `radius` lines later
+    video_sharpen_t* sharpen = &channel->sharpen;
+    if (g_processing_config.enable_processing && sharpen->lines && sharpen->config.amount > 0 &&
+        line->width == sharpen->config.width) {
+        video_sharpen_push_line(sharpen, line->data, row);
+    } else {
+        store_line(channel, line->data, line->width, row);
+    }
 }
 
-void example_rgb_callback(bt656_rgb_t* pixel, uint16_t x, uint16_t y) {
-    if (!pixel || x >= g_frame_buffer.width || y >= g_frame_buffer.height) {
-        return;
+// The decoder's user pointer is the channel; none means the left (or only) one
+static inline video_channel_t* channel_from_user(void* user) {
+    return user ? (video_channel_t*)user : &g_channels[VIDEO_CHANNEL_LEFT];
+}
+
+void example_ycbcr_callback(bt656_ycbcr_t* pixel, uint16_t x, uint16_t y, void* user) {
+    channel_ycbcr(channel_from_user(user), pixel, x, y);
+}
+
+void example_rgb_callback(bt656_rgb_t* pixel, uint16_t x, uint16_t y, void* user) {
+    channel_rgb(channel_from_user(user), pixel, x, y);
+}
+
+void example_frame_callback(void* user) {
+    channel_frame_end(channel_from_user(user));
+}
+
+void example_line_callback(uint16_t line_number, void* user) {
+    channel_line(channel_from_user(user), line_number);
+}
+
+void example_line_output_callback(bt656_line_t* line, void* user) {
+    channel_line_output(channel_from_user(user), line);
+}
+
+// User pointer for the decoder that feeds `channel` (VIDEO_CHANNEL_*)
+void* example_get_channel(uint8_t channel) {
+    return channel < VIDEO_CHANNEL_COUNT ? &g_channels[channel] : nullptr;
+}
+
+// ============================================================================
+// Binocular Simulation
+// ============================================================================
+
+#define STEREO_SIM_FIELD_US   20000   // PAL field period
+#define STEREO_SIM_LEFT_LINE  100     // Test pattern seeds; they give the two
+#define STEREO_SIM_RIGHT_LINE 50      // cameras different luma to tell them apart
+
+// Decode one synthetic PAL field; `lines` holds blanking and active lines of both fields
+static void stereo_sim_feed_field(bt656_decoder_t* decoder, const uint8_t* lines, int field) {
+    const uint16_t blanking_lines = BT656_PAL_FIELD_LINES - BT656_PAL_ACTIVE_LINES / 2;
+    uint16_t field_lines = BT656_PAL_FIELD_LINES + field;
+    for (uint16_t l = 0; l < field_lines; l++) {
+        bool vsync = l < blanking_lines + field;
+        const uint8_t* line = lines + ((vsync ? 0 : 2) + field) * BT656_TEST_LINE_SIZE;
+        bt656_decoder_process_buffer(decoder, line, BT656_TEST_LINE_SIZE);
+    }
+}
+
+// Feed two synthetic cameras, the right one `skew_us` behind the left, through
+// binocular processing and check that every pair holds one frame of each camera.
+// Runs its own video_processing_init(); call it while processing is stopped.
+// Returns false on a mismatched pair, or when a skew within the pairing
+// tolerance produced no pairs at all.
+bool example_run_stereo_simulation(int32_t skew_us, uint16_t frames) {
+    uint8_t* lines = (uint8_t*)malloc(BT656_TEST_LINE_SIZE * 8);
+    bt656_decoder_t* decoders = (bt656_decoder_t*)malloc(sizeof(bt656_decoder_t) * VIDEO_CHANNEL_COUNT);
+    if (!lines || !decoders) {
+        Serial.println("ERROR: Failed to allocate simulation buffers");
+        if (lines) free(lines);
+        if (decoders) free(decoders);
+        return false;
     }
     
-    // Calculate buffer index
-    uint32_t index = (y * g_frame_buffer.width + x) * 3;
+    video_processing_config_t config = DEFAULT_PROCESSING_CONFIG;
+    config.enable_processing = false;
+    config.enable_statistics = false;
+    config.channels = 2;
+    if (!video_processing_init(&config)) {
+        free(lines);
+        free(decoders);
+        return false;
+    }
+    
+    bt656_config_t decoder_config = {};
+    decoder_config.expected_width = BT656_PAL_ACTIVE_PIXELS;
+    decoder_config.expected_height = BT656_PAL_ACTIVE_LINES;
+    decoder_config.enable_line_output = true;
+    decoder_config.h_decimation = 1;
+    decoder_config.v_decimation = 1;
+    
+    for (uint8_t side = 0; side < VIDEO_CHANNEL_COUNT; side++) {
+        bt656_decoder_init(&decoders[side], &decoder_config);
+        bt656_decoder_set_line_output_callback(&decoders[side], example_line_output_callback);
+        bt656_decoder_set_frame_callback(&decoders[side], example_frame_callback);
+        bt656_decoder_set_user(&decoders[side], example_get_channel(side));
+    }
     
-    // Store RGB pixel in buffer
-    if (g_frame_buffer.rgb_buffer) {
-        g_frame_buffer.rgb_buffer[index + 0] = pixel->r;
-        g_frame_buffer.rgb_buffer[index + 1] = pixel->g;
-        g_frame_buffer.rgb_buffer[index + 2] = pixel->b;
+    for (int i = 0; i < 4; i++) {
+        bt656_generate_test_line(lines + i * BT656_TEST_LINE_SIZE, i & 1, i < 2, STEREO_SIM_LEFT_LINE);
+        bt656_generate_test_line(lines + (4 + i) * BT656_TEST_LINE_SIZE, i & 1, i < 2, STEREO_SIM_RIGHT_LINE);
     }
     
-    // Convert to RGB565 and store
-    if (g_frame_buffer.rgb565_buffer) {
-        uint32_t rgb565_index = y * g_frame_buffer.width + x;
-        g_frame_buffer.rgb565_buffer[rgb565_index] = bt656_rgb_to_rgb565(*pixel);
+    // First active luma sample of each camera's pattern (x = 0)
+    const uint8_t expected_luma[VIDEO_CHANNEL_COUNT] = {
+        16 + STEREO_SIM_LEFT_LINE % 220, 16 + STEREO_SIM_RIGHT_LINE % 220
+    };
+    
+    // Both cameras start at least a full field after time 0, so early skew stays positive
+    int64_t start_us[VIDEO_CHANNEL_COUNT];
+    start_us[VIDEO_CHANNEL_LEFT] = STEREO_SIM_FIELD_US + (skew_us < 0 ? -(int64_t)skew_us : 0);
+    start_us[VIDEO_CHANNEL_RIGHT] = start_us[VIDEO_CHANNEL_LEFT] + skew_us;
+    
+    uint32_t fields[VIDEO_CHANNEL_COUNT] = {0, 0};
+    uint32_t total_fields = (uint32_t)frames * 2;
+    uint32_t pairs = 0;
+    uint32_t mismatched = 0;
+    
+    video_stereo_reset(&g_stereo);
+    while (fields[VIDEO_CHANNEL_LEFT] < total_fields || fields[VIDEO_CHANNEL_RIGHT] < total_fields) {
+        // Next field in stream time order, left first on a tie
+        int64_t left_us = start_us[VIDEO_CHANNEL_LEFT] + (int64_t)fields[VIDEO_CHANNEL_LEFT] * STEREO_SIM_FIELD_US;
+        int64_t right_us = start_us[VIDEO_CHANNEL_RIGHT] + (int64_t)fields[VIDEO_CHANNEL_RIGHT] * STEREO_SIM_FIELD_US;
+        uint8_t side = VIDEO_CHANNEL_LEFT;
+        if (fields[VIDEO_CHANNEL_LEFT] >= total_fields ||
+            (fields[VIDEO_CHANNEL_RIGHT] < total_fields && right_us < left_us)) {
+            side = VIDEO_CHANNEL_RIGHT;
+        }
+        
+        frame_ring_t* ring = &g_channels[side].frame_ring;
+        uint32_t published = ring->stats.frames_published;
+        stereo_sim_feed_field(&decoders[side], lines + side * 4 * BT656_TEST_LINE_SIZE, fields[side] & 1);
+        
+        // The simulation runs faster than real time, so stream time replaces micros()
+        if (ring->stats.frames_published != published) {
+            frame_ring_get_last_published(ring)->timestamp =
+                (uint64_t)(side == VIDEO_CHANNEL_LEFT ? left_us : right_us);
+        }
+        fields[side]++;
+        
+        frame_buffer_t* left;
+        frame_buffer_t* right;
+        if (video_processing_acquire_pair(&left, &right)) {
+            pairs++;
+            uint16_t row = FRAME_HEIGHT / 2;
+            if (left->uyvy_buffer[row * left->width * 2 + 1] != expected_luma[VIDEO_CHANNEL_LEFT] ||
+                right->uyvy_buffer[row * right->width * 2 + 1] != expected_luma[VIDEO_CHANNEL_RIGHT]) {
+                mismatched++;
+            }
+        }
     }
     
-    // Convert to grayscale and store
-    if (g_frame_buffer.gray_buffer) {
-        uint32_t gray_index = y * g_frame_buffer.width + x;
-        g_frame_buffer.gray_buffer[gray_index] = (pixel->r + pixel->g + pixel->b) / 3;
+    Serial.println("=== Binocular Simulation ===");
+    Serial.printf("%d PAL frames per camera, right camera skew %ld us\n", frames, (long)skew_us);
+    Serial.printf("Mismatched Pairs: %lu\n", mismatched);
+    video_stereo_print_stats(&g_stereo);
+    
+    uint32_t abs_skew_us = skew_us < 0 ? (uint32_t)-(int64_t)skew_us : (uint32_t)skew_us;
+    bool passed = true;
+    if (mismatched > 0) {
+        Serial.println("FAIL: Pairs hold frames from the wrong camera");
+        passed = false;
+    } else if (pairs == 0 && abs_skew_us <= g_stereo.config.tolerance_us) {
+        Serial.println("FAIL: No pairs produced within the pairing tolerance");
+        passed = false;
+    } else {
+        Serial.println("PASS");
     }
+    
+    video_processing_deinit();
+    free(lines);
+    free(decoders);
+    return passed;
 }
 
-void example_frame_callback(void) {
-    g_frame_buffer.frame_number++;
-    g_frame_buffer.timestamp = micros();
-    g_frame_buffer.frame_complete = true;
-    g_frame_buffer.frame_ready = true;
+// ============================================================================
+// Staged Pipeline
+// ============================================================================
+
+// A recorded PAL stream stands in for the capture hardware; each stage below
+// runs on its own pipeline thread, so the statics are each touched by one stage
+static const uint8_t* g_pipeline_recording = nullptr;
+static size_t g_pipeline_recording_length = 0;
+static size_t g_pipeline_capture_pos = 0;
+static bt656_decoder_t g_pipeline_decoder;
+static size_t g_pipeline_decoded_bytes = 0;
+static video_tone_t g_pipeline_tone;
+static uint32_t g_pipeline_sink_frames = 0;
+static uint32_t g_pipeline_sink_missing = 0;
+
+// One frame of bytes per item: up to and including the EAV that closes the
+// frame's last active line, which is the first EAV of the next frame
+static bool pipeline_capture(video_pipeline_item_t* item) {
+    const size_t frame_bytes = (size_t)(BT656_PAL_FIELD_LINES * 2 + 1) * BT656_TEST_LINE_SIZE;
+    if (g_pipeline_capture_pos >= g_pipeline_recording_length) return false;
     
-    if (g_processing_config.enable_debug) {
-        Serial.printf("Frame %lu complete: %lu pixels, %lu lines\n", 
-                     g_frame_buffer.frame_number,
-                     g_frame_buffer.pixels_received,
-                     g_frame_buffer.lines_received);
-    }
+    size_t end = g_pipeline_capture_pos == 0 ? frame_bytes + 4 : g_pipeline_capture_pos + frame_bytes;
+    if (end > g_pipeline_recording_length) end = g_pipeline_recording_length;
+    size_t length = end - g_pipeline_capture_pos;
+    if (length > item->capacity) length = item->capacity;
     
-    // Process the frame
-    if (g_processing_config.enable_processing) {
-        video_processing_process_frame(&g_frame_buffer);
+    memcpy(item->data, g_pipeline_recording + g_pipeline_capture_pos, length);
+    item->length = length;
+    g_pipeline_capture_pos += length;
+    return true;
+}
+
+// The decoder's user pointer is the item being decoded
+static void pipeline_decode_line(bt656_line_t* line, void* user) {
+    video_pipeline_item_t* item = (video_pipeline_item_t*)user;
+    frame_buffer_write_line(&item->frame, line->row, line->data, line->width);
+}
+
+static bool pipeline_decode(video_pipeline_item_t* item) {
+    bt656_decoder_set_user(&g_pipeline_decoder, item);
+    bt656_decoder_process_buffer(&g_pipeline_decoder, item->data, item->length);
+    
+    // The recording's last line has no EAV after it
+    g_pipeline_decoded_bytes += item->length;
+    if (g_pipeline_decoded_bytes >= g_pipeline_recording_length) {
+        bt656_decoder_flush(&g_pipeline_decoder);
     }
+    bt656_decoder_set_user(&g_pipeline_decoder, nullptr);
     
-    // Reset frame buffer for next frame
-    frame_buffer_reset(&g_frame_buffer);
+    frame_buffer_t* frame = &item->frame;
+    frame_buffer_finish_frame(frame, nullptr);
+    frame->frame_number = item->sequence + 1;
+    frame->timestamp = micros();
+    frame->frame_complete = true;
+    frame->frame_ready = true;
+    return frame->lines_written > 0;
+}
+
+static bool pipeline_enhance(video_pipeline_item_t* item) {
+    video_image_t image = frame_buffer_get_image(&item->frame);
+    video_tone_apply_image(&g_pipeline_tone, &image);
+    frame_buffer_invalidate(&item->frame);
+    return true;
 }
 
-void example_line_callback(uint16_t line_number) {
-    g_frame_buffer.lines_received++;
+static bool pipeline_colour(video_pipeline_item_t* item) {
+    return frame_buffer_get_rgb565(&item->frame) != nullptr;
+}
+
+static bool pipeline_sink(video_pipeline_item_t* item) {
+    g_pipeline_sink_frames++;
+    g_pipeline_sink_missing += item->frame.lines_missing;
+    if (g_processing_config.enable_debug) {
+        Serial.printf("Frame %lu out: %lu lines, %lu missing\n", item->frame.frame_number,
+                      item->frame.lines_written, item->frame.lines_missing);
+    }
+    return true;
+}
+
+// Run `frames` synthetic PAL frames through capture, decode, enhance (tone
+// curve), colour (RGB565) and sink stages, each on its own thread, and report
+// per-stage occupancy and latency
+void example_run_pipeline(uint16_t frames) {
+    const uint16_t blanking_lines = BT656_PAL_FIELD_LINES - BT656_PAL_ACTIVE_LINES / 2;
+    const size_t frame_bytes = (size_t)(BT656_PAL_FIELD_LINES * 2 + 1) * BT656_TEST_LINE_SIZE;
     
-    if (g_processing_config.enable_debug && line_number % 100 == 0) {
-        Serial.printf("Line %d received\n", line_number);
+    if (frames == 0) frames = 1;
+    
+    uint8_t* recording = (uint8_t*)malloc(frame_bytes * frames);
+    video_pipeline_t* pipeline = (video_pipeline_t*)malloc(sizeof(video_pipeline_t));
+    if (!recording || !pipeline) {
+        Serial.println("ERROR: Failed to allocate pipeline buffers");
+        if (recording) free(recording);
+        if (pipeline) free(pipeline);
+        return;
     }
+    
+    uint8_t* p = recording;
+    for (uint16_t f = 0; f < frames; f++) {
+        for (int field = 0; field < 2; field++) {
+            uint16_t field_lines = BT656_PAL_FIELD_LINES + field;
+            for (uint16_t l = 0; l < field_lines; l++) {
+                p += bt656_generate_test_line(p, field, l < blanking_lines + field, l + f);
+            }
+        }
+    }
+    g_pipeline_recording = recording;
+    g_pipeline_recording_length = p - recording;
+    g_pipeline_capture_pos = 0;
+    g_pipeline_decoded_bytes = 0;
+    g_pipeline_sink_frames = 0;
+    g_pipeline_sink_missing = 0;
+    
+    bt656_config_t decoder_config = {};
+    decoder_config.expected_width = BT656_PAL_ACTIVE_PIXELS;
+    decoder_config.expected_height = BT656_PAL_ACTIVE_LINES;
+    decoder_config.enable_line_output = true;
+    bt656_decoder_init(&g_pipeline_decoder, &decoder_config);
+    bt656_decoder_set_line_output_callback(&g_pipeline_decoder, pipeline_decode_line);
+    
+    video_tone_params_t tone_params = tone_params_from_config(&g_processing_config);
+    video_tone_init(&g_pipeline_tone, &tone_params);
+    
+    video_pipeline_config_t config = VIDEO_PIPELINE_DEFAULT_CONFIG;
+    config.raw_bytes = frame_bytes + 4;
+    
+    if (video_pipeline_init(pipeline, &config)) {
+        video_pipeline_add_stage(pipeline, "capture", pipeline_capture);
+        video_pipeline_add_stage(pipeline, "decode", pipeline_decode);
+        video_pipeline_add_stage(pipeline, "enhance", pipeline_enhance);
+        video_pipeline_add_stage(pipeline, "colour", pipeline_colour);
+        video_pipeline_add_stage(pipeline, "sink", pipeline_sink);
+        
+        if (video_pipeline_start(pipeline)) {
+            video_pipeline_wait(pipeline);
+            Serial.printf("Pipeline delivered %lu of %d frames, %lu lines missing\n",
+                          g_pipeline_sink_frames, frames, g_pipeline_sink_missing);
+            video_pipeline_print_stats(pipeline);
+        }
+        video_pipeline_deinit(pipeline);
+    }
+    
+    bt656_decoder_deinit(&g_pipeline_decoder);
+    g_pipeline_recording = nullptr;
+    free(recording);
+    free(pipeline);
 }
 
 // ============================================================================
@@ -327,6 +1526,7 @@ void example_print_frame_info(frame_buffer_t* buffer) {
     Serial.printf("Frame Size: %dx%d\n", buffer->width, buffer->height);
     Serial.printf("Pixels Received: %lu\n", buffer->pixels_received);
     Serial.printf("Lines Received: %lu\n", buffer->lines_received);
+    Serial.printf("Lines Missing: %lu\n", buffer->lines_missing);
     Serial.printf("Frame Complete: %s\n", buffer->frame_complete ? "YES" : "NO");
     Serial.printf("Frame Ready: %s\n", buffer->frame_ready ? "YES" : "NO");
     Serial.printf("Frame Errors: %lu\n", buffer->frame_errors);
@@ -341,8 +1541,8 @@ void example_save_frame_to_file(frame_buffer_t* buffer, const char* filename) {
     // In a real implementation, you would save the frame data to a file
     Serial.printf("Saving frame %lu to %s\n", buffer->frame_number, filename);
     
-    // Example: Save RGB565 data
-    if (buffer->rgb565_buffer) {
+    // Example: Save RGB565 data (converted from the native frame on request)
+    if (frame_buffer_get_rgb565(buffer)) {
         Serial.printf("RGB565 data available: %d bytes\n", 
                      buffer->width * buffer->height * 2);
     }
@@ -367,11 +1567,20 @@ void example_display_frame_statistics(frame_buffer_t* buffer) {
     
     // Calculate memory usage
     size_t total_memory = 0;
-    if (buffer->ycbcr_buffer) total_memory += buffer->width * buffer->height * 3;
-    if (buffer->rgb_buffer) total_memory += buffer->width * buffer->height * 3;
-    if (buffer->rgb565_buffer) total_memory += buffer->width * buffer->height * 2;
-    if (buffer->gray_buffer) total_memory += buffer->width * buffer->height;
+    if (buffer->uyvy_buffer) total_memory += buffer->width * buffer->height * 2;
+    for (int i = 0; i < FRAME_FORMAT_COUNT; i++) {
+        if (buffer->caches[i].data) total_memory += buffer->width * buffer->height * video_image_bytes_per_pixel(i);
+    }
     
     Serial.printf("Total Memory Usage: %d bytes\n", total_memory);
+    Serial.printf("Cache Conversions: %lu\n", buffer->conversions);
+    for (int i = 0; i < VIDEO_CHANNEL_COUNT; i++) {
+        video_channel_t* channel = &g_channels[i];
+        if (!channel->active) continue;
+        Serial.printf("Channel %d Frames Dropped (slow consumer): %lu\n", i, channel->frame_ring.stats.frames_dropped);
+        Serial.printf("Channel %d Pool Frames In Use: %lu (high-water %lu of %d)\n", i,
+                      channel->frame_pool.stats.in_use, channel->frame_pool.stats.high_water_mark,
+                      channel->frame_pool.frame_count);
+    }
     Serial.println("========================");
 } 
\ No newline at end of file
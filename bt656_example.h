@@ -6,6 +6,18 @@
 #include <stdbool.h>
 #include "bt656_decoder.h"
 #include "bt656_interface.h"
+#include "video_tone.h"
+#include "video_palette.h"
+#include "video_clahe.h"
+#include "frame_pool.h"
+#include "video_image.h"
+#include "video_scaler.h"
+#include "video_deinterlace.h"
+#include "video_denoise.h"
+#include "video_stack.h"
+#include "video_darkframe.h"
+#include "video_sharpen.h"
+#include "video_remap.h"
 
 // ============================================================================
 // Frame Buffer Configuration
@@ -16,22 +28,70 @@
 #define FRAME_HEIGHT   576
 #define FRAME_SIZE     (FRAME_WIDTH * FRAME_HEIGHT)
 
-// Frame buffer formats
-#define FRAME_FORMAT_YCBCR    0
-#define FRAME_FORMAT_RGB      1
-#define FRAME_FORMAT_RGB565   2
-#define FRAME_FORMAT_GRAY     3
+// Frame buffer formats (same values as VIDEO_PIXEL_*)
+#define FRAME_FORMAT_YCBCR    VIDEO_PIXEL_YCBCR
+#define FRAME_FORMAT_RGB      VIDEO_PIXEL_RGB888
+#define FRAME_FORMAT_RGB565   VIDEO_PIXEL_RGB565
+#define FRAME_FORMAT_GRAY     VIDEO_PIXEL_GRAY
+#define FRAME_FORMAT_UYVY     VIDEO_PIXEL_UYVY    // Native storage format (Cb Y0 Cr Y1)
+#define FRAME_FORMAT_COUNT    5
+
+// Handling of lines not written in the current frame
+#define FRAME_MISSING_KEEP    0       // Repeat the previous frame's line
+#define FRAME_MISSING_BLACK   1       // Blank the line when the frame completes
+
+// Frame orientation, applied while lines are written (no separate pass)
+#define FRAME_ORIENT_NORMAL     0
+#define FRAME_ORIENT_MIRROR     1     // Left-right
+#define FRAME_ORIENT_FLIP       2     // Top-bottom
+#define FRAME_ORIENT_ROTATE_180 3     // Mirror and flip
+#define FRAME_ORIENT_ROTATE_90  4     // Clockwise (buffer is FRAME_HEIGHT x FRAME_WIDTH)
+#define FRAME_ORIENT_ROTATE_270 5     // Counter-clockwise (buffer is FRAME_HEIGHT x FRAME_WIDTH)
+
+// Source lines gathered before a blocked transpose (rotations only)
+#define FRAME_TRANSPOSE_LINES 16
+
+// Camera channels (binocular goggles run both, each with its own decoder)
+#define VIDEO_CHANNEL_LEFT    0       // The only channel when channels = 1
+#define VIDEO_CHANNEL_RIGHT   1
+#define VIDEO_CHANNEL_COUNT   2
+
+// Pool frames beyond the frame ring slots, for consumers that retain frames
+#define FRAME_POOL_SPARE      2
+
+// Lazily converted copy of the native frame
+typedef struct {
+    uint8_t* data;                // Converted pixels (allocated on first request)
+    uint32_t generation;          // Frame generation the data was converted from
+} frame_cache_t;
 
 // Frame buffer structure
+// Only the native UYVY frame is written by the decoder. Other formats are
+// converted on first request and reused until the frame generation changes.
 typedef struct {
-    uint8_t* ycbcr_buffer;        // YCbCr frame buffer
-    uint8_t* rgb_buffer;          // RGB frame buffer
-    uint16_t* rgb565_buffer;      // RGB565 frame buffer
-    uint8_t* gray_buffer;         // Grayscale frame buffer
+    uint8_t* uyvy_buffer;         // Native UYVY frame buffer (2 bytes per pixel)
+    frame_handle_t* handle;       // Pool frame backing uyvy_buffer (NULL = heap allocated)
+    frame_cache_t caches[FRAME_FORMAT_COUNT];  // Converted formats, indexed by FRAME_FORMAT_*
+    video_palette_t* palette;     // Palette for RGB/RGB565 caches (NULL = true colour)
+    uint32_t generation;          // Incremented on every write to the native frame
+    
+    // Valid-line tracking (replaces clearing the frame on reset)
+    uint32_t* line_stamps;        // Sequence of the frame that last wrote each row
+    uint32_t sequence;            // Current frame sequence, bumped on reset
+    uint8_t missing_line_policy;  // FRAME_MISSING_* applied when the frame completes
+    
+    // Orientation (source lines land mirrored, flipped or transposed)
+    uint8_t orientation;          // FRAME_ORIENT_*
+    uint8_t* transpose_lines;     // Source lines awaiting the blocked transpose (rotations only)
+    uint32_t* column_stamps;      // Rotations: sequence that last wrote each column (one source line)
+    uint16_t transpose_rows[FRAME_TRANSPOSE_LINES];    // Source row of each pending line
+    uint16_t transpose_widths[FRAME_TRANSPOSE_LINES];  // Pixels in each pending line
+    uint8_t transpose_count;      // Pending lines
     
     uint16_t width;               // Frame width
     uint16_t height;              // Frame height
-    uint8_t format;               // Current format
+    uint8_t format;               // Native format (FRAME_FORMAT_UYVY)
+    uint8_t field;                // Field of the last line written (frames complete after field 1)
     uint32_t frame_number;        // Frame number
     uint64_t timestamp;           // Frame timestamp
     bool frame_complete;          // Frame complete flag
@@ -40,7 +100,10 @@ typedef struct {
     // Statistics
     uint32_t pixels_received;     // Pixels received in current frame
     uint32_t lines_received;      // Lines received in current frame
+    uint32_t lines_written;       // Whole lines stored through the line output
+    uint32_t lines_missing;       // Source lines not written in the last completed frame
     uint32_t frame_errors;        // Frame errors
+    uint32_t conversions;         // Cache conversions performed
 } frame_buffer_t;
 
 // ============================================================================
@@ -65,10 +128,25 @@ typedef struct {
     uint8_t brightness;           // Brightness adjustment
     uint8_t contrast;             // Contrast adjustment
     uint8_t saturation;           // Saturation adjustment
+    uint8_t gamma;                // Gamma in tenths (10 = linear)
+    uint8_t palette;              // video_palette_id_t for RGB output (NONE = true colour)
+    uint8_t clahe_tiles;          // CLAHE tile grid per axis (0 = CLAHE off)
+    uint8_t clahe_clip_limit;     // CLAHE clip limit in tenths
+    uint8_t deinterlace;          // video_deinterlace_mode_t (OFF = woven frames at 25 fps)
+    uint8_t denoise_strength;     // Temporal noise reduction in 16ths (0 = off)
+    uint8_t stack_depth;          // Frames averaged for static scenes (0 = no stacking)
+    bool enable_dark_correction;  // Allocate a dark-frame map (then calibrate or load one)
+    uint8_t sharpen_amount;       // Unsharp mask detail gain in 16ths (0 = off)
+    uint8_t sharpen_threshold;    // Luma detail left untouched (keeps grain down)
+    int8_t lens_k1;               // Eyepiece radial coefficients in hundredths (both 0 = no remap)
+    int8_t lens_k2;
+    uint8_t orientation;          // FRAME_ORIENT_* for the camera mount (fixed at init)
+    uint8_t channels;             // Cameras: 1, or 2 for binocular goggles (fixed at init)
+    uint16_t pair_tolerance_us;   // Largest left/right capture time difference of a stereo pair
     
     // Output parameters
-    uint16_t output_width;        // Output width
-    uint16_t output_height;       // Output height
+    uint16_t output_width;        // Output width (scaled from FRAME_WIDTH if different)
+    uint16_t output_height;       // Output height (scaled from FRAME_HEIGHT if different)
     uint8_t output_fps;           // Output frame rate
 } video_processing_config_t;
 
@@ -78,32 +156,63 @@ typedef struct {
 
 // Frame buffer functions
 bool frame_buffer_init(frame_buffer_t* buffer, uint16_t width, uint16_t height);
+bool frame_buffer_init_pooled(frame_buffer_t* buffer, frame_pool_t* pool, uint16_t width, uint16_t height);
 void frame_buffer_deinit(frame_buffer_t* buffer);
 void frame_buffer_reset(frame_buffer_t* buffer);
 bool frame_buffer_is_ready(frame_buffer_t* buffer);
-
-// Frame buffer access functions
+void frame_buffer_write_line(frame_buffer_t* buffer, uint16_t row, const uint8_t* uyvy, uint16_t width);
+void frame_buffer_invalidate(frame_buffer_t* buffer);
+void frame_buffer_finish_frame(frame_buffer_t* buffer, const frame_buffer_t* previous);
+bool frame_buffer_is_line_valid(frame_buffer_t* buffer, uint16_t row);
+void frame_buffer_mark_written(frame_buffer_t* buffer);
+bool frame_buffer_set_orientation(frame_buffer_t* buffer, uint8_t orientation);
+frame_handle_t* frame_buffer_retain(frame_buffer_t* buffer);
+bool frame_buffer_rebind(frame_buffer_t* buffer);
+
+// Frame buffer access functions (non-native formats are converted on first request)
+uint8_t* frame_buffer_get_uyvy(frame_buffer_t* buffer);
+uint8_t* frame_buffer_get_format(frame_buffer_t* buffer, uint8_t format);
 uint8_t* frame_buffer_get_ycbcr(frame_buffer_t* buffer);
 uint8_t* frame_buffer_get_rgb(frame_buffer_t* buffer);
 uint16_t* frame_buffer_get_rgb565(frame_buffer_t* buffer);
 uint8_t* frame_buffer_get_gray(frame_buffer_t* buffer);
 
+// Image views (zero-copy; valid until the buffer is rewritten)
+video_image_t frame_buffer_get_image(frame_buffer_t* buffer);
+video_image_t frame_buffer_get_format_image(frame_buffer_t* buffer, uint8_t format);
+video_image_t frame_buffer_get_field(frame_buffer_t* buffer, uint8_t field);
+
 // Video processing functions
 bool video_processing_init(const video_processing_config_t* config);
 void video_processing_deinit(void);
 void video_processing_process_frame(frame_buffer_t* buffer);
+frame_buffer_t* video_processing_acquire_frame(void);
+frame_buffer_t* video_processing_acquire_channel_frame(uint8_t channel);
+bool video_processing_acquire_pair(frame_buffer_t** left, frame_buffer_t** right);
+bool video_processing_calibrate_dark_frames(uint16_t frames);
+video_darkframe_t* video_processing_get_darkframe(void);
+video_darkframe_t* video_processing_get_channel_darkframe(uint8_t channel);
+bool video_processing_stack_frame(void);
+frame_buffer_t* video_processing_acquire_stacked_frame(void);
+bool video_processing_scale_output(frame_buffer_t* buffer, const video_image_t* dst);
+bool video_processing_correct_lens(frame_buffer_t* buffer, const video_image_t* dst);
 void video_processing_set_config(const video_processing_config_t* config);
 
-// Callback functions for BT656 decoder
-void example_ycbcr_callback(bt656_ycbcr_t* pixel, uint16_t x, uint16_t y);
-void example_rgb_callback(bt656_rgb_t* pixel, uint16_t x, uint16_t y);
-void example_frame_callback(void);
-void example_line_callback(uint16_t line_number);
+// Callback functions for BT656 decoder. The decoder's user pointer selects the
+// channel (from example_get_channel()); without one they feed the left channel.
+void example_ycbcr_callback(bt656_ycbcr_t* pixel, uint16_t x, uint16_t y, void* user);
+void example_rgb_callback(bt656_rgb_t* pixel, uint16_t x, uint16_t y, void* user);
+void example_frame_callback(void* user);
+void example_line_callback(uint16_t line_number, void* user);
+void example_line_output_callback(bt656_line_t* line, void* user);
+void* example_get_channel(uint8_t channel);
 
 // Utility functions
 void example_print_frame_info(frame_buffer_t* buffer);
 void example_save_frame_to_file(frame_buffer_t* buffer, const char* filename);
 void example_display_frame_statistics(frame_buffer_t* buffer);
+bool example_run_stereo_simulation(int32_t skew_us, uint16_t frames);
+void example_run_pipeline(uint16_t frames);
 
 // ============================================================================
 // Default Configurations
@@ -119,6 +228,21 @@ static const video_processing_config_t DEFAULT_PROCESSING_CONFIG = {
     .brightness = 128,
     .contrast = 128,
     .saturation = 128,
+    .gamma = VIDEO_TONE_GAMMA_LINEAR,
+    .palette = VIDEO_PALETTE_NONE,
+    .clahe_tiles = 0,
+    .clahe_clip_limit = 30,
+    .deinterlace = VIDEO_DEINTERLACE_OFF,
+    .denoise_strength = 0,
+    .stack_depth = 0,
+    .enable_dark_correction = false,
+    .sharpen_amount = 0,
+    .sharpen_threshold = 4,
+    .lens_k1 = 0,
+    .lens_k2 = 0,
+    .orientation = FRAME_ORIENT_NORMAL,
+    .channels = 1,
+    .pair_tolerance_us = 8000,   // Under half a PAL field
     .output_width = FRAME_WIDTH,
     .output_height = FRAME_HEIGHT,
     .output_fps = 25
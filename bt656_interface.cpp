@@ -9,9 +9,6 @@
 
 
 
-// Global interface instance for ISR access
-static bt656_interface_t* g_interface = nullptr;
-
 // Flag to track if GPIO ISR service is installed
 static bool g_gpio_isr_installed = false;
 
@@ -80,39 +77,42 @@ void IRAM_ATTR bt656_pclk_isr_optimized(void* arg) {
   // CRITICAL: No Serial calls, no complex operations, no delays
   // This ISR must be as fast as possible to avoid watchdog timeouts
 
-  if (!g_interface || !g_interface->interrupt_enabled) {
+  // Each interface registers itself as the ISR argument, so several can run at once
+  bt656_interface_t* interface = (bt656_interface_t*)arg;
+  if (!interface || !interface->interrupt_enabled) {
     return;
   }
 
   // Read data using optimized function (direct register access)
-  uint8_t data = read_parallel_data_optimized(g_interface->config.data_pins);
+  uint8_t data = read_parallel_data_optimized(interface->config.data_pins);
 
   // Add to buffer (minimal processing)
-  if (add_to_buffer_optimized(g_interface, data)) {
-    g_interface->stats.bytes_captured++;
+  if (add_to_buffer_optimized(interface, data)) {
+    interface->stats.bytes_captured++;
   }
 
   // Simple counter increment (no complex operations)
-  g_interface->stats.interrupts_handled++;
+  interface->stats.interrupts_handled++;
 
   // CRITICAL: Return immediately - no delays, no Serial, no complex logic
 }
 
 // Alternative ISR with direct BT656 processing (for advanced users)
 void IRAM_ATTR bt656_pclk_isr_direct(void* arg) {
-  if (!g_interface || !g_interface->interrupt_enabled || !g_interface->decoder) {
+  bt656_interface_t* interface = (bt656_interface_t*)arg;
+  if (!interface || !interface->interrupt_enabled || !interface->decoder) {
     return;
   }
 
   // Read data using optimized function
-  uint8_t data = read_parallel_data_optimized(g_interface->config.data_pins);
+  uint8_t data = read_parallel_data_optimized(interface->config.data_pins);
 
   // Process BT656 data directly in ISR (minimal processing)
   // This is more advanced and requires careful testing
-  bt656_decoder_process_byte(g_interface->decoder, data);
+  bt656_decoder_process_byte(interface->decoder, data);
 
-  g_interface->stats.interrupts_handled++;
-  g_interface->stats.bytes_captured++;
+  interface->stats.interrupts_handled++;
+  interface->stats.bytes_captured++;
 }
 
 // ============================================================================
@@ -187,9 +187,6 @@ bool bt656_interface_init(bt656_interface_t* interface, const bt656_interface_co
     Serial.printf("PCLK pin configured: GPIO %d\n", interface->config.pclk_pin);
   }
 
-  // Set global interface pointer for ISR
-  g_interface = interface;
-
   // Initialize callbacks to NULL
   interface->data_ready_callback = nullptr;
   interface->error_callback = nullptr;
@@ -230,13 +227,6 @@ void bt656_interface_deinit(bt656_interface_t* interface) {
     interface->data_buffer = nullptr;
   }
 
-  // Clear global pointer
-  if (g_interface == interface) {
-    g_interface = nullptr;
-  }
-
-
-
   Serial.println("BT656 interface deinitialized");
 }
 
@@ -0,0 +1,156 @@
+#include "frame_pool.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+static inline size_t align_up(size_t value) {
+    return (value + FRAME_POOL_ALIGNMENT - 1) & ~(size_t)(FRAME_POOL_ALIGNMENT - 1);
+}
+
+// Track frames in use and the high-water mark (only the stats path contends)
+static inline void IRAM_ATTR update_in_use(frame_pool_t* pool, int delta) {
+    uint32_t in_use = __atomic_add_fetch(&pool->stats.in_use, delta, __ATOMIC_RELAXED);
+    uint32_t high = __atomic_load_n(&pool->stats.high_water_mark, __ATOMIC_RELAXED);
+    while (in_use > high &&
+           !__atomic_compare_exchange_n(&pool->stats.high_water_mark, &high, in_use,
+                                        true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+// ============================================================================
+// Core Frame Pool Functions
+// ============================================================================
+
+bool frame_pool_init(frame_pool_t* pool, size_t frame_size, uint8_t frame_count) {
+    if (!pool) {
+        Serial.println("ERROR: Invalid frame pool pointer");
+        return false;
+    }
+
+    memset(pool, 0, sizeof(frame_pool_t));
+
+    if (frame_count == 0 || frame_count > FRAME_POOL_MAX_FRAMES || frame_size == 0) {
+        Serial.println("ERROR: Invalid frame pool size");
+        return false;
+    }
+
+    // One allocation for every frame, each frame starting on an aligned boundary
+    size_t stride = align_up(frame_size);
+    pool->memory = (uint8_t*)malloc(stride * frame_count + FRAME_POOL_ALIGNMENT - 1);
+    if (!pool->memory) {
+        Serial.println("ERROR: Failed to allocate frame pool");
+        return false;
+    }
+
+    uint8_t* base = (uint8_t*)align_up((size_t)pool->memory);
+    for (uint8_t i = 0; i < frame_count; i++) {
+        frame_handle_t* handle = &pool->handles[i];
+        handle->data = base + stride * i;
+        handle->size = frame_size;
+        handle->refcount = 0;
+        handle->index = i;
+        handle->pool = pool;
+    }
+
+    pool->frame_count = frame_count;
+    pool->frame_size = frame_size;
+    pool->free_mask = (1UL << frame_count) - 1;
+
+    Serial.printf("Frame pool initialized: %d frames x %d bytes (%d-byte aligned)\n",
+                  frame_count, frame_size, FRAME_POOL_ALIGNMENT);
+    return true;
+}
+
+void frame_pool_deinit(frame_pool_t* pool) {
+    if (!pool) return;
+
+    if (pool->stats.in_use) {
+        Serial.printf("WARNING: Frame pool freed with %lu frames in use\n", pool->stats.in_use);
+    }
+
+    if (pool->memory) {
+        free(pool->memory);
+    }
+
+    memset(pool, 0, sizeof(frame_pool_t));
+}
+
+bool frame_pool_is_initialized(frame_pool_t* pool) {
+    return pool ? pool->memory != nullptr : false;
+}
+
+// ============================================================================
+// Handle Functions
+// ============================================================================
+
+// Take a free frame (refcount 1). Returns NULL when the pool is exhausted.
+frame_handle_t* IRAM_ATTR frame_pool_acquire(frame_pool_t* pool) {
+    if (!pool || !pool->memory) return nullptr;
+
+    uint32_t mask = __atomic_load_n(&pool->free_mask, __ATOMIC_ACQUIRE);
+    uint32_t bit;
+    do {
+        if (mask == 0) {
+            __atomic_add_fetch(&pool->stats.exhausted, 1, __ATOMIC_RELAXED);
+            return nullptr;
+        }
+        bit = __builtin_ctz(mask);
+    } while (!__atomic_compare_exchange_n(&pool->free_mask, &mask, mask & ~(1UL << bit),
+                                          true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+
+    frame_handle_t* handle = &pool->handles[bit];
+    __atomic_store_n(&handle->refcount, 1, __ATOMIC_RELAXED);
+
+    __atomic_add_fetch(&pool->stats.acquisitions, 1, __ATOMIC_RELAXED);
+    update_in_use(pool, 1);
+    return handle;
+}
+
+void IRAM_ATTR frame_handle_retain(frame_handle_t* handle) {
+    if (handle) {
+        __atomic_add_fetch(&handle->refcount, 1, __ATOMIC_RELAXED);
+    }
+}
+
+// Drop one reference; the last owner returns the frame to its pool
+void IRAM_ATTR frame_handle_release(frame_handle_t* handle) {
+    if (!handle || !handle->pool) return;
+
+    if (__atomic_sub_fetch(&handle->refcount, 1, __ATOMIC_ACQ_REL) == 0) {
+        frame_pool_t* pool = handle->pool;
+        __atomic_fetch_or(&pool->free_mask, 1UL << handle->index, __ATOMIC_RELEASE);
+        __atomic_add_fetch(&pool->stats.releases, 1, __ATOMIC_RELAXED);
+        update_in_use(pool, -1);
+    }
+}
+
+bool frame_handle_is_shared(frame_handle_t* handle) {
+    return handle ? __atomic_load_n(&handle->refcount, __ATOMIC_ACQUIRE) > 1 : false;
+}
+
+// ============================================================================
+// Status and Statistics Functions
+// ============================================================================
+
+frame_pool_stats_t frame_pool_get_stats(frame_pool_t* pool) {
+    if (pool) {
+        return pool->stats;
+    }
+    frame_pool_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+void frame_pool_print_stats(frame_pool_t* pool) {
+    if (!pool) return;
+
+    Serial.println("=== Frame Pool Statistics ===");
+    Serial.printf("Frames: %d x %d bytes\n", pool->frame_count, pool->frame_size);
+    Serial.printf("Acquisitions: %lu\n", pool->stats.acquisitions);
+    Serial.printf("Releases: %lu\n", pool->stats.releases);
+    Serial.printf("Exhausted: %lu\n", pool->stats.exhausted);
+    Serial.printf("In Use: %lu\n", pool->stats.in_use);
+    Serial.printf("High-Water Mark: %lu / %d\n", pool->stats.high_water_mark, pool->frame_count);
+    Serial.println("=============================");
+}
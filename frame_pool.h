@@ -0,0 +1,70 @@
+#ifndef FRAME_POOL_H
+#define FRAME_POOL_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Frame Pool Configuration
+// ============================================================================
+
+#define FRAME_POOL_ALIGNMENT       64        // Frame start alignment (cache line / DMA)
+#define FRAME_POOL_MAX_FRAMES      16        // Max frames per pool (one bit each in the free mask)
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+typedef struct frame_pool frame_pool_t;
+
+// Reference-counted handle to one pooled frame
+typedef struct {
+    uint8_t* data;                 // FRAME_POOL_ALIGNMENT-aligned frame memory
+    size_t size;                   // Usable bytes
+    volatile uint32_t refcount;    // Owners; returned to the pool at zero
+    uint8_t index;                 // Slot in the pool
+    frame_pool_t* pool;            // Owning pool
+} frame_handle_t;
+
+// Frame pool statistics
+typedef struct {
+    uint32_t acquisitions;         // Handles handed out
+    uint32_t releases;             // Handles returned
+    uint32_t exhausted;            // Acquire attempts with no free frame
+    uint32_t in_use;               // Frames currently handed out
+    uint32_t high_water_mark;      // Most frames ever in use at once
+} frame_pool_stats_t;
+
+// Fixed set of frames allocated once at startup
+// Acquire/release are lock-free (atomic free-mask), so they are safe from the
+// decoder callbacks and never touch the heap.
+struct frame_pool {
+    uint8_t* memory;               // Single backing allocation (unaligned)
+    frame_handle_t handles[FRAME_POOL_MAX_FRAMES];
+    volatile uint32_t free_mask;   // Bit set = frame available
+    uint8_t frame_count;           // Frames in the pool
+    size_t frame_size;             // Requested bytes per frame
+    frame_pool_stats_t stats;      // Pool statistics
+};
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core frame pool functions
+bool frame_pool_init(frame_pool_t* pool, size_t frame_size, uint8_t frame_count);
+void frame_pool_deinit(frame_pool_t* pool);
+bool frame_pool_is_initialized(frame_pool_t* pool);
+
+// Handle functions
+frame_handle_t* frame_pool_acquire(frame_pool_t* pool);
+void frame_handle_retain(frame_handle_t* handle);
+void frame_handle_release(frame_handle_t* handle);
+bool frame_handle_is_shared(frame_handle_t* handle);
+
+// Status and statistics functions
+frame_pool_stats_t frame_pool_get_stats(frame_pool_t* pool);
+void frame_pool_print_stats(frame_pool_t* pool);
+
+#endif // FRAME_POOL_H
@@ -0,0 +1,143 @@
+#include "frame_ring.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Core Frame Ring Functions
+// ============================================================================
+
+// Slots draw their frames from `pool` when given (NULL = heap allocated)
+bool frame_ring_init(frame_ring_t* ring, frame_pool_t* pool, uint16_t width, uint16_t height) {
+    if (!ring) {
+        Serial.println("ERROR: Invalid frame ring pointer");
+        return false;
+    }
+
+    memset(ring, 0, sizeof(frame_ring_t));
+
+    for (int i = 0; i < FRAME_RING_SLOTS; i++) {
+        bool ok = pool ? frame_buffer_init_pooled(&ring->slots[i], pool, width, height)
+                       : frame_buffer_init(&ring->slots[i], width, height);
+        if (!ok) {
+            Serial.println("ERROR: Failed to allocate frame ring slots");
+            frame_ring_deinit(ring);
+            return false;
+        }
+    }
+
+    // Producer starts on slot 0, handover slot 1 (empty), consumer slot 2
+    ring->write_index = 0;
+    ring->shared = 1;
+    ring->read_index = 2;
+    ring->last_published = 1;
+
+    Serial.printf("Frame ring initialized: %d slots of %dx%d\n", FRAME_RING_SLOTS, width, height);
+    return true;
+}
+
+void frame_ring_deinit(frame_ring_t* ring) {
+    if (!ring) return;
+
+    for (int i = 0; i < FRAME_RING_SLOTS; i++) {
+        if (ring->slots[i].uyvy_buffer) {
+            frame_buffer_deinit(&ring->slots[i]);
+        }
+    }
+
+    memset(ring, 0, sizeof(frame_ring_t));
+}
+
+// ============================================================================
+// Producer Side
+// ============================================================================
+
+frame_buffer_t* frame_ring_get_write_frame(frame_ring_t* ring) {
+    return ring ? &ring->slots[ring->write_index] : nullptr;
+}
+
+// Hand the completed write frame to the consumer and take the handover slot back.
+// Returns the frame the producer should write next.
+frame_buffer_t* IRAM_ATTR frame_ring_publish(frame_ring_t* ring) {
+    if (!ring) return nullptr;
+
+    uint32_t previous = __atomic_exchange_n(&ring->shared, ring->write_index | FRAME_RING_FRESH,
+                                            __ATOMIC_ACQ_REL);
+
+    // The slot we got back was never read: the consumer fell behind
+    if (previous & FRAME_RING_FRESH) {
+        ring->stats.frames_dropped++;
+    }
+
+    ring->last_published = ring->write_index;
+    ring->write_index = previous & FRAME_RING_INDEX_MASK;
+    ring->stats.frames_published++;
+
+    // A consumer may still hold the slot's frame through frame_buffer_retain()
+    frame_buffer_t* next = &ring->slots[ring->write_index];
+    if (frame_handle_is_shared(next->handle) && frame_buffer_rebind(next)) {
+        ring->stats.frames_rebound++;
+    }
+    return next;
+}
+
+// The last published frame is never written until the producer gets it back
+// on a later publish, so the producer may read it (e.g. to repeat missing lines)
+frame_buffer_t* frame_ring_get_last_published(frame_ring_t* ring) {
+    return ring ? &ring->slots[ring->last_published] : nullptr;
+}
+
+// ============================================================================
+// Consumer Side
+// ============================================================================
+
+// Swap in the newest published frame. Returns NULL if nothing new arrived since
+// the last call; the previously acquired frame stays valid until then.
+frame_buffer_t* frame_ring_acquire_latest(frame_ring_t* ring) {
+    if (!ring) return nullptr;
+
+    if (!(__atomic_load_n(&ring->shared, __ATOMIC_ACQUIRE) & FRAME_RING_FRESH)) {
+        return nullptr;
+    }
+
+    uint32_t previous = __atomic_exchange_n(&ring->shared, ring->read_index, __ATOMIC_ACQ_REL);
+    ring->read_index = previous & FRAME_RING_INDEX_MASK;
+    ring->stats.frames_consumed++;
+    return &ring->slots[ring->read_index];
+}
+
+frame_buffer_t* frame_ring_get_read_frame(frame_ring_t* ring) {
+    return ring ? &ring->slots[ring->read_index] : nullptr;
+}
+
+bool frame_ring_has_new_frame(frame_ring_t* ring) {
+    return ring ? (__atomic_load_n(&ring->shared, __ATOMIC_ACQUIRE) & FRAME_RING_FRESH) != 0 : false;
+}
+
+// ============================================================================
+// Status and Statistics Functions
+// ============================================================================
+
+frame_ring_stats_t frame_ring_get_stats(frame_ring_t* ring) {
+    if (ring) {
+        return ring->stats;
+    }
+    frame_ring_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+void frame_ring_reset_stats(frame_ring_t* ring) {
+    if (ring) {
+        memset(&ring->stats, 0, sizeof(frame_ring_stats_t));
+    }
+}
+
+void frame_ring_print_stats(frame_ring_t* ring) {
+    if (!ring) return;
+
+    Serial.println("=== Frame Ring Statistics ===");
+    Serial.printf("Frames Published: %lu\n", ring->stats.frames_published);
+    Serial.printf("Frames Consumed: %lu\n", ring->stats.frames_consumed);
+    Serial.printf("Frames Dropped: %lu\n", ring->stats.frames_dropped);
+    Serial.printf("Frames Rebound: %lu\n", ring->stats.frames_rebound);
+    Serial.printf("Write Slot: %lu | Read Slot: %lu\n", ring->write_index, ring->read_index);
+    Serial.println("=============================");
+}
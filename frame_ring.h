@@ -0,0 +1,64 @@
+#ifndef FRAME_RING_H
+#define FRAME_RING_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "bt656_example.h"
+
+// ============================================================================
+// Frame Ring Configuration
+// ============================================================================
+
+#define FRAME_RING_SLOTS           3         // Write, shared and read slots
+#define FRAME_RING_INDEX_MASK      0x03      // Slot index bits in the shared word
+#define FRAME_RING_FRESH           0x04      // Shared slot holds an unread frame
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Frame ring statistics (each counter has a single writer)
+typedef struct {
+    uint32_t frames_published;     // Frames handed over by the producer
+    uint32_t frames_consumed;      // Frames picked up by the consumer
+    uint32_t frames_dropped;       // Published frames replaced before the consumer read them
+    uint32_t frames_rebound;       // Write slots moved to a fresh pool frame (old one retained)
+} frame_ring_stats_t;
+
+// Lock-free triple buffer between one producer (decoder) and one consumer
+// The producer always owns a free slot to write, the consumer always owns the
+// slot it is reading, and the third slot is exchanged with a single atomic swap.
+typedef struct {
+    frame_buffer_t slots[FRAME_RING_SLOTS];
+    uint32_t write_index;          // Slot owned by the producer
+    uint32_t read_index;           // Slot owned by the consumer
+    uint32_t last_published;       // Slot most recently published (producer view)
+    volatile uint32_t shared;      // Handover slot index | FRAME_RING_FRESH
+    frame_ring_stats_t stats;      // Exchange statistics
+} frame_ring_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core frame ring functions
+bool frame_ring_init(frame_ring_t* ring, frame_pool_t* pool, uint16_t width, uint16_t height);
+void frame_ring_deinit(frame_ring_t* ring);
+
+// Producer side
+frame_buffer_t* frame_ring_get_write_frame(frame_ring_t* ring);
+frame_buffer_t* frame_ring_publish(frame_ring_t* ring);
+frame_buffer_t* frame_ring_get_last_published(frame_ring_t* ring);
+
+// Consumer side
+frame_buffer_t* frame_ring_acquire_latest(frame_ring_t* ring);
+frame_buffer_t* frame_ring_get_read_frame(frame_ring_t* ring);
+bool frame_ring_has_new_frame(frame_ring_t* ring);
+
+// Status and statistics functions
+frame_ring_stats_t frame_ring_get_stats(frame_ring_t* ring);
+void frame_ring_reset_stats(frame_ring_t* ring);
+void frame_ring_print_stats(frame_ring_t* ring);
+
+#endif // FRAME_RING_H
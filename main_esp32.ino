@@ -3,6 +3,7 @@
 #include "tvp5150_parallel_esp32.h"
 #include "bt656_decoder.h"
 #include "bt656_interface.h"
+#include "video_tone.h"
 #include "pin_config.h"
 
 // Status variables
@@ -16,6 +17,11 @@ const unsigned long STATUS_CHECK_INTERVAL = 1000;
 bt656_decoder_t bt656_decoder;
 bt656_interface_t bt656_interface;
 
+// Software tone curve for the line output. Only gamma is changed here;
+// brightness, contrast and saturation are set in the TVP5150.
+video_tone_t tone_curve;
+video_tone_params_t tone_params = VIDEO_TONE_DEFAULT_PARAMS;
+
 // Frame statistics
 uint32_t total_frames_received = 0;
 uint32_t total_pixels_received = 0;
@@ -26,7 +32,7 @@ uint64_t last_frame_timestamp = 0;
 // ============================================================================
 
 // Callback for YCbCr pixels from BT656 decoder
-void on_ycbcr_pixel(bt656_ycbcr_t* pixel, uint16_t x, uint16_t y) {
+void on_ycbcr_pixel(bt656_ycbcr_t* pixel, uint16_t x, uint16_t y, void* user) {
     // Process YCbCr pixel data
     total_pixels_received++;
     
@@ -35,7 +41,7 @@ void on_ycbcr_pixel(bt656_ycbcr_t* pixel, uint16_t x, uint16_t y) {
 }
 
 // Callback for RGB pixels from BT656 decoder
-void on_rgb_pixel(bt656_rgb_t* pixel, uint16_t x, uint16_t y) {
+void on_rgb_pixel(bt656_rgb_t* pixel, uint16_t x, uint16_t y, void* user) {
     // Process RGB pixel data
     // This is where you would add your RGB processing logic
     
@@ -46,25 +52,33 @@ void on_rgb_pixel(bt656_rgb_t* pixel, uint16_t x, uint16_t y) {
 }
 
 // Callback for frame start from BT656 decoder
-void on_frame_start() {
+void on_frame_start(void* user) {
     total_frames_received++;
     last_frame_timestamp = micros();
+    video_tone_update(&tone_curve);  // Publishes a gamma change that waited for a line
     
     Serial.printf("Frame %lu started at %llu us\n", total_frames_received, last_frame_timestamp);
 }
 
 // Callback for line start from BT656 decoder
-void on_line_start(uint16_t line_number) {
+void on_line_start(uint16_t line_number, void* user) {
     // Optional: Process line start events
     if (line_number % 100 == 0) {
         Serial.printf("Line %d started\n", line_number);
     }
 }
 
+// Callback for complete active lines from BT656 decoder
+void on_line_output(bt656_line_t* line, void* user) {
+    // Apply the gamma curve in place; store or transmit the line after this.
+    // The pixel callbacks run before the line is complete, so they see it untoned.
+    video_tone_apply_uyvy(&tone_curve, line->data, line->width);
+}
+
 // Callback for data ready from BT656 interface
 void on_data_ready(uint8_t* data, uint32_t count) {
-    // Optional: Process raw BT656 data
-    // This callback is called when data is available in the buffer
+    // Decode buffered BT656 data; ranges outside the decoder window are skipped in bulk
+    bt656_decoder_process_buffer(&bt656_decoder, data, count);
 }
 
 // Callback for errors from BT656 interface
@@ -147,7 +161,8 @@ void setup() {
             .expected_height = BT656_PAL_ACTIVE_LINES,
             .enable_rgb_conversion = true,
             .enable_frame_buffer = false,
-            .output_format = 1  // RGB
+            .output_format = 1,  // RGB
+            .enable_line_output = true
         };
         
         if (bt656_decoder_init(&bt656_decoder, &decoder_config)) {
@@ -158,6 +173,10 @@ void setup() {
             bt656_decoder_set_rgb_callback(&bt656_decoder, on_rgb_pixel);
             bt656_decoder_set_frame_callback(&bt656_decoder, on_frame_start);
             bt656_decoder_set_line_callback(&bt656_decoder, on_line_start);
+            bt656_decoder_set_line_output_callback(&bt656_decoder, on_line_output);
+            
+            // Tone curve tables are built once here and on parameter changes
+            video_tone_init(&tone_curve, &tone_params);
             
             // Initialize BT656 interface
             Serial.println("\nInitializing BT656 interface...");
@@ -599,6 +618,10 @@ void loop() {
 // ============================================================================
 
 // Optional: Add functions to adjust video parameters
+// Brightness, contrast and saturation are set in the TVP5150, so they reach
+// every consumer of the decoded video. The TVP5150 has no gamma control:
+// gamma is the software tone curve applied to the line output, and only
+// shows up for consumers that read decoded lines.
 void adjust_brightness(int delta) {
     static uint8_t current_brightness = 0x80;
     current_brightness = constrain(current_brightness + delta, 0, 255);
@@ -620,6 +643,12 @@ void adjust_saturation(int delta) {
     Serial.printf("Saturation set to: %d\n", current_saturation);
 }
 
+void adjust_gamma(int delta) {
+    tone_params.gamma = constrain(tone_params.gamma + delta, 1, 40);
+    video_tone_set_params(&tone_curve, &tone_params);
+    Serial.printf("Gamma set to: %d.%d\n", tone_params.gamma / 10, tone_params.gamma % 10);
+}
+
 // Function to restart BT656 interface
 void restart_bt656_interface() {
     if (bt656_interface_ready) {
@@ -4,19 +4,8 @@
 #include "tvp5150_parallel_esp32.h"
 #include <Arduino.h>
 
-// Global variables
-static tvp5150_pins_t current_pins;
-static bool parallel_initialized = false;
-static bool capturing = false;
-static uint32_t frame_count = 0;
-static void (*frame_callback)(video_frame_t* frame) = nullptr;
-
-// Video capture configuration
-static video_config_t current_config = {0};
-
-// Frame buffer (if needed)
-static uint8_t* frame_buffer = nullptr;
-static size_t frame_buffer_size = 0;
+// Port used by the single-camera functions
+static tvp5150_port_t default_port;
 
 // ============================================================================
 // Pin Management Functions
@@ -98,20 +87,46 @@ static bool read_pclk(const tvp5150_pins_t* pins) {
     return false;
 }
 
+// ============================================================================
+// Capture Frame Pool
+// ============================================================================
+
+// Make sure the capture pool holds frames of `frame_size` bytes. Only the first
+// capture (or a resolution change with no frames outstanding) allocates.
+static bool ensure_capture_pool(tvp5150_port_t* port, size_t frame_size) {
+    frame_pool_t* capture_pool = &port->capture_pool;
+    if (frame_pool_is_initialized(capture_pool)) {
+        if (capture_pool->frame_size >= frame_size) {
+            return true;
+        }
+        if (capture_pool->stats.in_use) {
+            Serial.println("ERROR: Capture frames still in use, cannot grow pool");
+            return false;
+        }
+        frame_pool_deinit(capture_pool);
+    }
+
+    if (!frame_pool_init(capture_pool, frame_size, TVP5150_CAPTURE_POOL_FRAMES)) {
+        Serial.println("ERROR: Failed to allocate capture frames");
+        return false;
+    }
+    return true;
+}
+
 // ============================================================================
 // Public Interface Functions
 // ============================================================================
 
-bool tvp5150_parallel_init(const tvp5150_pins_t* pins) {
+bool tvp5150_port_init(tvp5150_port_t* port, const tvp5150_pins_t* pins) {
     Serial.println("Initializing TVP5150 parallel interface...");
     
-    if (!pins) {
+    if (!port || !pins) {
         Serial.println("ERROR: Invalid pin configuration");
         return false;
     }
     
     // Store pin configuration
-    memcpy(&current_pins, pins, sizeof(tvp5150_pins_t));
+    memcpy(&port->pins, pins, sizeof(tvp5150_pins_t));
     
     // Initialize GPIO pins (only VSYNC/HREF - data pins configured by BT656 interface)
     if (!init_gpio_pins(pins)) {
@@ -120,53 +135,53 @@ bool tvp5150_parallel_init(const tvp5150_pins_t* pins) {
     }
     
     // Reset state
-    capturing = false;
-    frame_count = 0;
-    frame_callback = nullptr;
+    port->capturing = false;
+    port->frame_count = 0;
+    port->frame_callback = nullptr;
     
     // Clear configuration
-    memset(&current_config, 0, sizeof(current_config));
+    memset(&port->config, 0, sizeof(port->config));
     
-    parallel_initialized = true;
+    port->initialized = true;
     Serial.println("TVP5150 parallel interface initialized successfully");
     return true;
 }
 
-void tvp5150_parallel_deinit(void) {
+void tvp5150_port_deinit(tvp5150_port_t* port) {
+    if (!port) return;
+    
     Serial.println("Deinitializing TVP5150 parallel interface...");
     
     // Stop capture if running
-    if (capturing) {
-        tvp5150_stop_capture();
+    if (port->capturing) {
+        tvp5150_port_stop_capture(port);
     }
     
-    // Free frame buffer
-    if (frame_buffer) {
-        free(frame_buffer);
-        frame_buffer = nullptr;
-        frame_buffer_size = 0;
-    }
+    // Free capture frames
+    frame_pool_deinit(&port->capture_pool);
     
     // Reset state
-    parallel_initialized = false;
-    capturing = false;
-    frame_count = 0;
-    frame_callback = nullptr;
+    port->initialized = false;
+    port->capturing = false;
+    port->frame_count = 0;
+    port->frame_callback = nullptr;
     
     Serial.println("TVP5150 parallel interface deinitialized");
 }
 
-bool tvp5150_capture_frame(video_frame_t* frame) {
-    if (!parallel_initialized || !frame) {
+bool tvp5150_port_capture_frame(tvp5150_port_t* port, video_frame_t* frame) {
+    if (!port || !port->initialized || !frame) {
         return false;
     }
     
+    const tvp5150_pins_t* pins = &port->pins;
+    
     // Simple frame capture implementation
     // This is a basic implementation - you may need to enhance it based on your needs
     
     // Check if VSYNC is active (frame start)
-    if (is_pin_connected(current_pins.vsync_pin)) {
-        bool vsync = read_vsync(&current_pins);
+    if (is_pin_connected(pins->vsync_pin)) {
+        bool vsync = read_vsync(pins);
         if (vsync) {
             Serial.println("VSYNC detected - frame start");
         }
@@ -175,24 +190,28 @@ bool tvp5150_capture_frame(video_frame_t* frame) {
     // Read some sample data (simplified)
     uint8_t sample_data[8];
     for (int i = 0; i < 8; i++) {
-        sample_data[i] = read_parallel_data(&current_pins);
+        sample_data[i] = read_parallel_data(pins);
         delayMicroseconds(100); // Small delay
     }
     
     // Fill frame structure
-    frame->width = current_config.width > 0 ? current_config.width : 640;
-    frame->height = current_config.height > 0 ? current_config.height : 480;
-    frame->frame_number = frame_count++;
+    frame->width = port->config.width > 0 ? port->config.width : 640;
+    frame->height = port->config.height > 0 ? port->config.height : 480;
+    frame->frame_number = port->frame_count++;
     frame->timestamp = millis();
     
-    // Allocate buffer if needed
+    // Take a pooled frame if the caller did not supply one
     if (!frame->buffer) {
         frame->size = frame->width * frame->height * 2; // YUV422 = 2 bytes per pixel
-        frame->buffer = (uint8_t*)malloc(frame->size);
-        if (!frame->buffer) {
-            Serial.println("ERROR: Failed to allocate frame buffer");
+        if (!ensure_capture_pool(port, frame->size)) {
             return false;
         }
+        frame->handle = frame_pool_acquire(&port->capture_pool);
+        if (!frame->handle) {
+            Serial.println("ERROR: No free capture frame (release frames with tvp5150_release_frame)");
+            return false;
+        }
+        frame->buffer = frame->handle->data;
     }
     
     // Copy sample data (this is just a placeholder)
@@ -202,8 +221,8 @@ bool tvp5150_capture_frame(video_frame_t* frame) {
     return true;
 }
 
-bool tvp5150_start_capture(const video_config_t* config) {
-    if (!parallel_initialized) {
+bool tvp5150_port_start_capture(tvp5150_port_t* port, const video_config_t* config) {
+    if (!port || !port->initialized) {
         Serial.println("ERROR: Parallel interface not initialized");
         return false;
     }
@@ -219,92 +238,139 @@ bool tvp5150_start_capture(const video_config_t* config) {
     Serial.printf("FPS: %d\n", config->fps);
     
     // Store configuration
-    memcpy(&current_config, config, sizeof(video_config_t));
+    memcpy(&port->config, config, sizeof(video_config_t));
     
-    // Allocate frame buffer
+    // Take the capture frame from the pool (allocated on first start only)
     if (config->width > 0 && config->height > 0) {
-        frame_buffer_size = config->width * config->height * 2; // YUV422
-        frame_buffer = (uint8_t*)malloc(frame_buffer_size);
-        if (!frame_buffer) {
-            Serial.println("ERROR: Failed to allocate frame buffer");
+        if (!ensure_capture_pool(port, (size_t)config->width * config->height * 2)) { // YUV422
             return false;
         }
-        Serial.printf("Frame buffer allocated: %d bytes\n", frame_buffer_size);
+        if (!port->capture_handle) {
+            port->capture_handle = frame_pool_acquire(&port->capture_pool);
+            if (!port->capture_handle) {
+                Serial.println("ERROR: No free capture frame");
+                return false;
+            }
+        }
     }
     
-    capturing = true;
-    frame_count = 0;
+    port->capturing = true;
+    port->frame_count = 0;
     
     Serial.println("Video capture started");
     return true;
 }
 
-void tvp5150_stop_capture(void) {
-    if (!parallel_initialized) {
+void tvp5150_port_stop_capture(tvp5150_port_t* port) {
+    if (!port || !port->initialized) {
         return;
     }
     
     Serial.println("Stopping video capture...");
-    capturing = false;
+    port->capturing = false;
     
-    // Free frame buffer
-    if (frame_buffer) {
-        free(frame_buffer);
-        frame_buffer = nullptr;
-        frame_buffer_size = 0;
+    // Return the capture frame; the pool stays allocated for the next start
+    if (port->capture_handle) {
+        frame_handle_release(port->capture_handle);
+        port->capture_handle = nullptr;
     }
     
     Serial.println("Video capture stopped");
 }
 
+bool tvp5150_port_is_capturing(tvp5150_port_t* port) {
+    return port ? port->capturing : false;
+}
+
+uint32_t tvp5150_port_get_frame_count(tvp5150_port_t* port) {
+    return port ? port->frame_count : 0;
+}
+
+void tvp5150_port_set_callback(tvp5150_port_t* port, void (*callback)(video_frame_t* frame)) {
+    if (port) {
+        port->frame_callback = callback;
+    }
+}
+
+frame_pool_stats_t tvp5150_port_get_pool_stats(tvp5150_port_t* port) {
+    if (port) {
+        return frame_pool_get_stats(&port->capture_pool);
+    }
+    frame_pool_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+// Return a frame filled by tvp5150_capture_frame() to the pool
+void tvp5150_release_frame(video_frame_t* frame) {
+    if (!frame || !frame->handle) return;
+    
+    frame_handle_release(frame->handle);
+    frame->handle = nullptr;
+    frame->buffer = nullptr;
+}
+
+// ============================================================================
+// Single-Camera Functions
+// ============================================================================
+
+bool tvp5150_parallel_init(const tvp5150_pins_t* pins) {
+    return tvp5150_port_init(&default_port, pins);
+}
+
+void tvp5150_parallel_deinit(void) {
+    tvp5150_port_deinit(&default_port);
+}
+
+bool tvp5150_capture_frame(video_frame_t* frame) {
+    return tvp5150_port_capture_frame(&default_port, frame);
+}
+
+bool tvp5150_start_capture(const video_config_t* config) {
+    return tvp5150_port_start_capture(&default_port, config);
+}
+
+void tvp5150_stop_capture(void) {
+    tvp5150_port_stop_capture(&default_port);
+}
+
 bool tvp5150_is_capturing(void) {
-    return capturing;
+    return tvp5150_port_is_capturing(&default_port);
 }
 
 uint32_t tvp5150_get_frame_count(void) {
-    return frame_count;
+    return tvp5150_port_get_frame_count(&default_port);
 }
 
 void tvp5150_set_callback(void (*callback)(video_frame_t* frame)) {
-    frame_callback = callback;
+    tvp5150_port_set_callback(&default_port, callback);
+}
+
+frame_pool_stats_t tvp5150_get_pool_stats(void) {
+    return tvp5150_port_get_pool_stats(&default_port);
 }
 
 // ============================================================================
 // Utility Functions
 // ============================================================================
 
-void tvp5150_yuv422_to_rgb565(uint8_t* yuv_data, uint16_t* rgb_data, size_t pixel_count) {
-    if (!yuv_data || !rgb_data) {
-        return;
-    }
-    
-    for (size_t i = 0; i < pixel_count; i++) {
-        uint8_t y = yuv_data[i * 2];
-        uint8_t u = yuv_data[i * 2 + 1];
-        uint8_t v = yuv_data[i * 2 + 3];
-        
-        // Simple YUV to RGB conversion (simplified)
-        int r = y + 1.402 * (v - 128);
-        int g = y - 0.344 * (u - 128) - 0.714 * (v - 128);
-        int b = y + 1.772 * (u - 128);
-        
-        // Clamp values
-        r = constrain(r, 0, 255);
-        g = constrain(g, 0, 255);
-        b = constrain(b, 0, 255);
-        
-        // Convert to RGB565
-        rgb_data[i] = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+// View of a captured frame (YUYV, as read from the parallel port)
+video_image_t tvp5150_frame_image(const video_frame_t* frame) {
+    if (!frame || !frame->buffer) {
+        return video_image_make(nullptr, 0, 0, VIDEO_PIXEL_YUYV);
     }
+    return video_image_make(frame->buffer, frame->width, frame->height, VIDEO_PIXEL_YUYV);
 }
 
-void tvp5150_yuv422_to_grayscale(uint8_t* yuv_data, uint8_t* gray_data, size_t pixel_count) {
-    if (!yuv_data || !gray_data) {
-        return;
+bool tvp5150_yuv422_to_rgb565(const video_image_t* yuv, const video_image_t* rgb565) {
+    if (!yuv || !rgb565 || !video_image_is_422(yuv->format) || rgb565->format != VIDEO_PIXEL_RGB565) {
+        return false;
     }
-    
-    for (size_t i = 0; i < pixel_count; i++) {
-        // Y component is already grayscale
-        gray_data[i] = yuv_data[i * 2];
+    return video_image_convert(yuv, rgb565);
+}
+
+bool tvp5150_yuv422_to_grayscale(const video_image_t* yuv, const video_image_t* gray) {
+    if (!yuv || !gray || !video_image_is_422(yuv->format) || gray->format != VIDEO_PIXEL_GRAY) {
+        return false;
     }
-}
\ No newline at end of file
+    return video_image_convert(yuv, gray);
+}
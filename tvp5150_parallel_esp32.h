@@ -4,6 +4,11 @@
 #include <Arduino.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include "frame_pool.h"
+#include "video_image.h"
+
+// Capture frames preallocated when capture starts
+#define TVP5150_CAPTURE_POOL_FRAMES  4
 
 // Parallel interface pin definitions
 typedef struct {
@@ -23,6 +28,7 @@ typedef struct {
 // Video frame buffer
 typedef struct {
     uint8_t* buffer;
+    frame_handle_t* handle;   // Pool frame backing buffer (NULL = caller supplied)
     size_t size;
     uint16_t width;
     uint16_t height;
@@ -38,18 +44,44 @@ typedef struct {
     uint8_t fps;
 } video_config_t;
 
-// Function prototypes
+// One parallel capture port (binocular setups run one per decoder chip)
+typedef struct {
+    tvp5150_pins_t pins;
+    bool initialized;
+    bool capturing;
+    uint32_t frame_count;
+    void (*frame_callback)(video_frame_t* frame);
+    video_config_t config;
+    frame_pool_t capture_pool;     // Capture frames, allocated once and reused across captures
+    frame_handle_t* capture_handle;
+} tvp5150_port_t;
+
+// Per-port functions
+bool tvp5150_port_init(tvp5150_port_t* port, const tvp5150_pins_t* pins);
+void tvp5150_port_deinit(tvp5150_port_t* port);
+bool tvp5150_port_capture_frame(tvp5150_port_t* port, video_frame_t* frame);
+bool tvp5150_port_start_capture(tvp5150_port_t* port, const video_config_t* config);
+void tvp5150_port_stop_capture(tvp5150_port_t* port);
+bool tvp5150_port_is_capturing(tvp5150_port_t* port);
+uint32_t tvp5150_port_get_frame_count(tvp5150_port_t* port);
+void tvp5150_port_set_callback(tvp5150_port_t* port, void (*callback)(video_frame_t* frame));
+frame_pool_stats_t tvp5150_port_get_pool_stats(tvp5150_port_t* port);
+
+// Single-camera functions (operate on a built-in default port)
 bool tvp5150_parallel_init(const tvp5150_pins_t* pins);
 void tvp5150_parallel_deinit(void);
 bool tvp5150_capture_frame(video_frame_t* frame);
+void tvp5150_release_frame(video_frame_t* frame);
 bool tvp5150_start_capture(const video_config_t* config);
 void tvp5150_stop_capture(void);
 bool tvp5150_is_capturing(void);
 uint32_t tvp5150_get_frame_count(void);
 void tvp5150_set_callback(void (*callback)(video_frame_t* frame));
+frame_pool_stats_t tvp5150_get_pool_stats(void);
 
-// Utility functions
-void tvp5150_yuv422_to_rgb565(uint8_t* yuv_data, uint16_t* rgb_data, size_t pixel_count);
-void tvp5150_yuv422_to_grayscale(uint8_t* yuv_data, uint8_t* gray_data, size_t pixel_count);
+// Utility functions (views may be crops or fields of a larger frame)
+video_image_t tvp5150_frame_image(const video_frame_t* frame);
+bool tvp5150_yuv422_to_rgb565(const video_image_t* yuv, const video_image_t* rgb565);
+bool tvp5150_yuv422_to_grayscale(const video_image_t* yuv, const video_image_t* gray);
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "video_clahe.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+// Tile index and blend weight (0-255) toward the next tile, measured between tile centres
+static void tile_position(uint16_t pos, uint16_t tile_size, uint8_t tile_count, uint8_t* tile, uint8_t* weight) {
+    int half = tile_size / 2;
+    int t = ((int)pos - half) / (int)tile_size;
+
+    if ((int)pos < half || t < 0) {
+        *tile = 0;
+        *weight = 0;
+        return;
+    }
+    if (t >= tile_count - 1) {
+        *tile = tile_count - 1;
+        *weight = 0;
+        return;
+    }
+
+    *tile = t;
+    *weight = (((int)pos - half - t * (int)tile_size) * 256) / tile_size;
+}
+
+// Clip one tile histogram, redistribute the excess and turn its CDF into a mapping
+static uint32_t build_tile_map(const uint16_t* hist, uint8_t* map, uint8_t clip_limit) {
+    uint32_t bins[VIDEO_CLAHE_BINS];
+    uint32_t area = 0;
+    uint32_t clipped = 0;
+
+    for (int v = 0; v < VIDEO_CLAHE_BINS; v++) {
+        bins[v] = hist[v];
+        area += hist[v];
+    }
+
+    if (area == 0) {
+        for (int v = 0; v < VIDEO_CLAHE_BINS; v++) {
+            map[v] = v;
+        }
+        return 0;
+    }
+
+    if (clip_limit > 0) {
+        uint32_t limit = (area * clip_limit) / (VIDEO_CLAHE_BINS * 10);
+        if (limit < 1) limit = 1;
+
+        for (int v = 0; v < VIDEO_CLAHE_BINS; v++) {
+            if (bins[v] > limit) {
+                clipped += bins[v] - limit;
+                bins[v] = limit;
+            }
+        }
+
+        // Spread the excess evenly, remainder on a regular stride
+        uint32_t add = clipped / VIDEO_CLAHE_BINS;
+        uint32_t residual = clipped % VIDEO_CLAHE_BINS;
+        for (int v = 0; v < VIDEO_CLAHE_BINS; v++) {
+            bins[v] += add;
+        }
+        if (residual) {
+            uint32_t stride = VIDEO_CLAHE_BINS / residual;
+            for (uint32_t v = 0; v < VIDEO_CLAHE_BINS && residual; v += stride, residual--) {
+                bins[v]++;
+            }
+        }
+    }
+
+    uint32_t cdf = 0;
+    for (int v = 0; v < VIDEO_CLAHE_BINS; v++) {
+        cdf += bins[v];
+        map[v] = (cdf * 255 + area / 2) / area;
+    }
+
+    return clipped;
+}
+
+// Accumulate and remap one line of samples spaced `step` bytes apart
+static void IRAM_ATTR process_samples(video_clahe_t* clahe, uint8_t* samples, int step,
+                                      uint16_t width, uint16_t line_number) {
+    const video_clahe_config_t* cfg = &clahe->config;
+    if (line_number >= cfg->height) return;
+    if (width > cfg->width) width = cfg->width;
+
+    const uint32_t row_stride = (uint32_t)cfg->tiles_x * VIDEO_CLAHE_BINS;
+    uint16_t* hist_row = clahe->histograms + (line_number / clahe->tile_height) * row_stride;
+
+    uint8_t ty, wy;
+    tile_position(line_number, clahe->tile_height, cfg->tiles_y, &ty, &wy);
+    uint8_t ty_next = (ty + 1 < cfg->tiles_y) ? ty + 1 : ty;
+    const uint8_t* map_top = clahe->maps + ty * row_stride;
+    const uint8_t* map_bottom = clahe->maps + ty_next * row_stride;
+    const uint8_t last_tile = cfg->tiles_x - 1;
+
+    uint16_t x = 0;
+    for (uint8_t tx = 0; tx < cfg->tiles_x && x < width; tx++) {
+        uint16_t* hist = hist_row + tx * VIDEO_CLAHE_BINS;
+        uint16_t x_end = x + clahe->tile_width;
+        if (x_end > width) x_end = width;
+
+        for (; x < x_end; x++) {
+            uint8_t* p = samples + x * step;
+            uint8_t v = *p;
+            hist[v]++;
+
+            // Bilinear blend of the four surrounding tile mappings
+            uint32_t left = clahe->column_tile[x] * VIDEO_CLAHE_BINS + v;
+            uint32_t right = left + ((clahe->column_tile[x] < last_tile) ? VIDEO_CLAHE_BINS : 0);
+            int wx = clahe->column_weight[x];
+
+            int top = (map_top[left] << 8) + (map_top[right] - map_top[left]) * wx;
+            int bottom = (map_bottom[left] << 8) + (map_bottom[right] - map_bottom[left]) * wx;
+            *p = ((top << 8) + (bottom - top) * wy + 32768) >> 16;
+        }
+    }
+
+    clahe->stats.lines_processed++;
+    clahe->frame_lines++;
+}
+
+// ============================================================================
+// Core CLAHE Functions
+// ============================================================================
+
+bool video_clahe_init(video_clahe_t* clahe, const video_clahe_config_t* config) {
+    if (!clahe) {
+        Serial.println("ERROR: Invalid CLAHE pointer");
+        return false;
+    }
+
+    memset(clahe, 0, sizeof(video_clahe_t));
+    clahe->config = config ? *config : VIDEO_CLAHE_DEFAULT_CONFIG;
+    video_clahe_config_t* cfg = &clahe->config;
+
+    if (cfg->tiles_x == 0 || cfg->tiles_y == 0 ||
+        cfg->tiles_x > VIDEO_CLAHE_MAX_TILES || cfg->tiles_y > VIDEO_CLAHE_MAX_TILES ||
+        cfg->width < cfg->tiles_x || cfg->height < cfg->tiles_y) {
+        Serial.println("ERROR: Invalid CLAHE tile grid");
+        return false;
+    }
+
+    clahe->tile_width = (cfg->width + cfg->tiles_x - 1) / cfg->tiles_x;
+    clahe->tile_height = (cfg->height + cfg->tiles_y - 1) / cfg->tiles_y;
+
+    // 16-bit bins keep the histograms small; a tile must fit in them
+    if ((uint32_t)clahe->tile_width * clahe->tile_height > 0xFFFF) {
+        Serial.println("ERROR: CLAHE tiles too large, increase the tile grid");
+        return false;
+    }
+
+    size_t tile_count = (size_t)cfg->tiles_x * cfg->tiles_y;
+    clahe->histograms = (uint16_t*)calloc(tile_count * VIDEO_CLAHE_BINS, sizeof(uint16_t));
+    clahe->maps = (uint8_t*)malloc(tile_count * VIDEO_CLAHE_BINS);
+    clahe->column_tile = (uint8_t*)malloc(cfg->width);
+    clahe->column_weight = (uint8_t*)malloc(cfg->width);
+
+    if (!clahe->histograms || !clahe->maps || !clahe->column_tile || !clahe->column_weight) {
+        Serial.println("ERROR: Failed to allocate CLAHE buffers");
+        video_clahe_deinit(clahe);
+        return false;
+    }
+
+    // Identity maps until the first frame has been histogrammed
+    for (size_t t = 0; t < tile_count; t++) {
+        for (int v = 0; v < VIDEO_CLAHE_BINS; v++) {
+            clahe->maps[t * VIDEO_CLAHE_BINS + v] = v;
+        }
+    }
+
+    for (uint16_t x = 0; x < cfg->width; x++) {
+        tile_position(x, clahe->tile_width, cfg->tiles_x, &clahe->column_tile[x], &clahe->column_weight[x]);
+    }
+
+    Serial.printf("CLAHE initialized: %dx%d, %dx%d tiles, clip %d.%d\n",
+                  cfg->width, cfg->height, cfg->tiles_x, cfg->tiles_y,
+                  cfg->clip_limit / 10, cfg->clip_limit % 10);
+    return true;
+}
+
+void video_clahe_deinit(video_clahe_t* clahe) {
+    if (!clahe) return;
+
+    if (clahe->histograms) free(clahe->histograms);
+    if (clahe->maps) free(clahe->maps);
+    if (clahe->column_tile) free(clahe->column_tile);
+    if (clahe->column_weight) free(clahe->column_weight);
+
+    memset(clahe, 0, sizeof(video_clahe_t));
+}
+
+void video_clahe_set_clip_limit(video_clahe_t* clahe, uint8_t clip_limit) {
+    if (clahe) {
+        // Takes effect when the next frame's maps are built
+        clahe->config.clip_limit = clip_limit;
+    }
+}
+
+// ============================================================================
+// Streaming Functions
+// ============================================================================
+
+void IRAM_ATTR video_clahe_process_uyvy(video_clahe_t* clahe, uint8_t* uyvy, uint16_t width, uint16_t line_number) {
+    if (!clahe || !clahe->maps || !uyvy) return;
+    process_samples(clahe, uyvy + 1, 2, width, line_number);
+}
+
+void IRAM_ATTR video_clahe_process_luma(video_clahe_t* clahe, uint8_t* luma, uint16_t width, uint16_t line_number) {
+    if (!clahe || !clahe->maps || !luma) return;
+    process_samples(clahe, luma, 1, width, line_number);
+}
+
+// Process a UYVY, YUYV or grey view whose first row is frame line `first_line`
+void video_clahe_process_image(video_clahe_t* clahe, const video_image_t* image, uint16_t first_line) {
+    if (!clahe || !clahe->maps || !video_image_is_valid(image)) return;
+
+    int offset = 0;
+    int step = 2;
+    switch (image->format) {
+        case VIDEO_PIXEL_UYVY: offset = 1; break;
+        case VIDEO_PIXEL_YUYV: offset = 0; break;
+        case VIDEO_PIXEL_GRAY: step = 1; break;
+        default: return;
+    }
+
+    for (uint16_t row = 0; row < image->height; row++) {
+        process_samples(clahe, video_image_row(image, row) + offset, step, image->width, first_line + row);
+    }
+}
+
+void video_clahe_end_frame(video_clahe_t* clahe) {
+    if (!clahe || !clahe->maps) return;
+
+    // Nothing received (e.g. the first vertical blanking): keep the current maps
+    if (clahe->frame_lines == 0) return;
+
+    size_t tile_count = (size_t)clahe->config.tiles_x * clahe->config.tiles_y;
+    for (size_t t = 0; t < tile_count; t++) {
+        clahe->stats.pixels_clipped += build_tile_map(clahe->histograms + t * VIDEO_CLAHE_BINS,
+                                                      clahe->maps + t * VIDEO_CLAHE_BINS,
+                                                      clahe->config.clip_limit);
+    }
+
+    memset(clahe->histograms, 0, tile_count * VIDEO_CLAHE_BINS * sizeof(uint16_t));
+    clahe->stats.frames_mapped++;
+
+    // Ending on every field leaves the lower tiles without samples
+    if (clahe->frame_lines < clahe->config.height) {
+        clahe->stats.partial_frames++;
+    }
+    clahe->frame_lines = 0;
+}
+
+// ============================================================================
+// Status and Statistics Functions
+// ============================================================================
+
+video_clahe_stats_t video_clahe_get_stats(video_clahe_t* clahe) {
+    if (clahe) {
+        return clahe->stats;
+    }
+    video_clahe_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+void video_clahe_print_stats(video_clahe_t* clahe) {
+    if (!clahe) return;
+
+    Serial.println("=== CLAHE Statistics ===");
+    Serial.printf("Tile Grid: %dx%d (%dx%d px)\n", clahe->config.tiles_x, clahe->config.tiles_y,
+                  clahe->tile_width, clahe->tile_height);
+    Serial.printf("Clip Limit: %d.%d\n", clahe->config.clip_limit / 10, clahe->config.clip_limit % 10);
+    Serial.printf("Frames Mapped: %lu\n", clahe->stats.frames_mapped);
+    Serial.printf("Lines Processed: %lu\n", clahe->stats.lines_processed);
+    Serial.printf("Pixels Clipped: %lu\n", clahe->stats.pixels_clipped);
+    Serial.printf("Partial Frames: %lu\n", clahe->stats.partial_frames);
+    Serial.println("========================");
+}
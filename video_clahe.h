@@ -0,0 +1,90 @@
+#ifndef VIDEO_CLAHE_H
+#define VIDEO_CLAHE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "video_image.h"
+
+// ============================================================================
+// CLAHE Configuration
+// ============================================================================
+
+#define VIDEO_CLAHE_MAX_TILES      16        // Max tiles per axis
+#define VIDEO_CLAHE_BINS           256       // Histogram bins (8-bit luma)
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// CLAHE configuration
+typedef struct {
+    uint16_t width;                // Luma plane width
+    uint16_t height;               // Luma plane height
+    uint8_t tiles_x;               // Tile columns
+    uint8_t tiles_y;               // Tile rows
+    uint8_t clip_limit;            // Clip limit in tenths of the mean bin height (30 = 3.0)
+} video_clahe_config_t;
+
+// CLAHE statistics
+typedef struct {
+    uint32_t frames_mapped;        // Frames whose histograms produced new maps
+    uint32_t lines_processed;      // Lines accumulated and remapped
+    uint32_t pixels_clipped;       // Histogram counts redistributed by the clip limit
+    uint32_t partial_frames;       // Frames mapped from fewer lines than the frame height
+} video_clahe_stats_t;
+
+// CLAHE stage
+// Histograms of the frame being received are accumulated line by line while
+// the maps built from the previous frame are applied in the same pass, so the
+// stage never needs a second full-frame read.
+typedef struct {
+    video_clahe_config_t config;   // Stage configuration
+    video_clahe_stats_t stats;     // Stage statistics
+
+    uint16_t tile_width;           // Pixels per tile column
+    uint16_t tile_height;          // Lines per tile row
+
+    uint16_t* histograms;          // tiles_y * tiles_x * 256 counts (current frame)
+    uint8_t* maps;                 // tiles_y * tiles_x * 256 mappings (previous frame)
+    uint16_t frame_lines;          // Lines accumulated since the last end_frame
+
+    // Per-column interpolation table (built once at init)
+    uint8_t* column_tile;          // Left tile index for each column
+    uint8_t* column_weight;        // Right tile weight for each column (0-255)
+} video_clahe_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core CLAHE functions
+bool video_clahe_init(video_clahe_t* clahe, const video_clahe_config_t* config);
+void video_clahe_deinit(video_clahe_t* clahe);
+void video_clahe_set_clip_limit(video_clahe_t* clahe, uint8_t clip_limit);
+
+// Streaming: accumulate + remap one line, then rebuild maps at frame end
+// line_number is the row of the whole frame, so an interlaced source passes
+// the woven row of each field line and ends the frame after the second field.
+void video_clahe_process_uyvy(video_clahe_t* clahe, uint8_t* uyvy, uint16_t width, uint16_t line_number);
+void video_clahe_process_luma(video_clahe_t* clahe, uint8_t* luma, uint16_t width, uint16_t line_number);
+void video_clahe_process_image(video_clahe_t* clahe, const video_image_t* image, uint16_t first_line);
+void video_clahe_end_frame(video_clahe_t* clahe);
+
+// Status and statistics functions
+video_clahe_stats_t video_clahe_get_stats(video_clahe_t* clahe);
+void video_clahe_print_stats(video_clahe_t* clahe);
+
+// ============================================================================
+// Default Configuration
+// ============================================================================
+
+static const video_clahe_config_t VIDEO_CLAHE_DEFAULT_CONFIG = {
+    .width = 720,
+    .height = 576,
+    .tiles_x = 8,
+    .tiles_y = 8,
+    .clip_limit = 30
+};
+
+#endif // VIDEO_CLAHE_H
@@ -0,0 +1,443 @@
+#include "video_darkframe.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+#define LUMA_LANES     0x00FF00FF
+
+#define SORT2(a, b)    { if ((a) > (b)) { uint8_t t = (a); (a) = (b); (b) = t; } }
+
+// Median of nine values (exchange network, 19 compares)
+static uint8_t median9(uint8_t* p) {
+    SORT2(p[1], p[2]); SORT2(p[4], p[5]); SORT2(p[7], p[8]);
+    SORT2(p[0], p[1]); SORT2(p[3], p[4]); SORT2(p[6], p[7]);
+    SORT2(p[1], p[2]); SORT2(p[4], p[5]); SORT2(p[7], p[8]);
+    SORT2(p[0], p[3]); SORT2(p[5], p[8]); SORT2(p[4], p[7]);
+    SORT2(p[3], p[6]); SORT2(p[1], p[4]); SORT2(p[2], p[5]);
+    SORT2(p[4], p[7]); SORT2(p[4], p[2]); SORT2(p[6], p[4]);
+    SORT2(p[4], p[2]);
+    return p[4];
+}
+
+// Gather a 3x3 neighbourhood of luma (edges clamped) and return its median
+static uint8_t neighbourhood_median(const uint8_t* plane, uint32_t stride, uint8_t step,
+                                    uint16_t width, uint16_t height, uint16_t x, uint16_t y) {
+    uint8_t values[9];
+    uint8_t n = 0;
+
+    for (int dy = -1; dy <= 1; dy++) {
+        int yy = (int)y + dy;
+        if (yy < 0) yy = 0;
+        if (yy >= height) yy = height - 1;
+        const uint8_t* row = plane + (uint32_t)yy * stride;
+
+        for (int dx = -1; dx <= 1; dx++) {
+            int xx = (int)x + dx;
+            if (xx < 0) xx = 0;
+            if (xx >= width) xx = width - 1;
+            values[n++] = row[(uint32_t)xx * step];
+        }
+    }
+    return median9(values);
+}
+
+// Luma position within a pixel (UYVY, YUYV or grey)
+static bool luma_layout(uint8_t format, uint8_t* offset, uint8_t* step) {
+    switch (format) {
+        case VIDEO_PIXEL_UYVY: *offset = 1; *step = 2; return true;
+        case VIDEO_PIXEL_YUYV: *offset = 0; *step = 2; return true;
+        case VIDEO_PIXEL_GRAY: *offset = 0; *step = 1; return true;
+        default: return false;
+    }
+}
+
+static inline void put_u16(uint8_t* p, uint16_t v) {
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static inline void put_u32(uint8_t* p, uint32_t v) {
+    put_u16(p, v & 0xFFFF);
+    put_u16(p + 2, v >> 16);
+}
+
+static inline uint16_t get_u16(const uint8_t* p) {
+    return p[0] | (p[1] << 8);
+}
+
+static inline uint32_t get_u32(const uint8_t* p) {
+    return get_u16(p) | ((uint32_t)get_u16(p + 2) << 16);
+}
+
+// FNV-1a over the payload, stored in the header
+static uint32_t payload_checksum(const uint8_t* data, size_t length) {
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ data[i]) * 16777619UL;
+    }
+    return hash;
+}
+
+// Offsets that all fit in a nibble are stored two per byte
+static uint8_t offset_bits(video_darkframe_t* map) {
+    uint32_t pixels = (uint32_t)map->config.width * map->config.height;
+    for (uint32_t i = 0; i < pixels; i++) {
+        if (map->offsets[i] > 15) return 8;
+    }
+    return 4;
+}
+
+// ============================================================================
+// Core Functions
+// ============================================================================
+
+bool video_darkframe_init(video_darkframe_t* map, const video_darkframe_config_t* config) {
+    if (!map || !config || config->width == 0 || config->height == 0) {
+        Serial.println("ERROR: Invalid dark-frame configuration");
+        return false;
+    }
+
+    memset(map, 0, sizeof(video_darkframe_t));
+    map->config = *config;
+
+    map->offsets = (uint8_t*)calloc((uint32_t)config->width * config->height, 1);
+    map->hot_pixels = (video_hot_pixel_t*)malloc(config->max_hot_pixels * sizeof(video_hot_pixel_t));
+
+    if (!map->offsets || (config->max_hot_pixels && !map->hot_pixels)) {
+        Serial.println("ERROR: Failed to allocate dark-frame map");
+        video_darkframe_deinit(map);
+        return false;
+    }
+
+    return true;
+}
+
+void video_darkframe_deinit(video_darkframe_t* map) {
+    if (!map) return;
+
+    if (map->offsets) free(map->offsets);
+    if (map->hot_pixels) free(map->hot_pixels);
+    if (map->calibration_sums) free(map->calibration_sums);
+
+    memset(map, 0, sizeof(video_darkframe_t));
+}
+
+bool video_darkframe_is_valid(video_darkframe_t* map) {
+    return map && map->valid;
+}
+
+// ============================================================================
+// Calibration
+// ============================================================================
+
+bool video_darkframe_begin_calibration(video_darkframe_t* map, uint16_t frames) {
+    if (!map || !map->offsets || frames == 0 || frames > VIDEO_DARKFRAME_MAX_CALIBRATION) {
+        Serial.println("ERROR: Invalid dark-frame calibration request");
+        return false;
+    }
+
+    if (!map->calibration_sums) {
+        map->calibration_sums = (uint16_t*)malloc((uint32_t)map->config.width * map->config.height * sizeof(uint16_t));
+        if (!map->calibration_sums) {
+            Serial.println("ERROR: Failed to allocate dark-frame calibration buffer");
+            return false;
+        }
+    }
+
+    memset(map->calibration_sums, 0, (uint32_t)map->config.width * map->config.height * sizeof(uint16_t));
+    map->calibration_frames = 0;
+    map->calibration_target = frames;
+    map->valid = false;            // Calibration frames must not be corrected by an old map
+
+    Serial.printf("Dark-frame calibration started: %d frames\n", frames);
+    return true;
+}
+
+bool video_darkframe_add_calibration_frame(video_darkframe_t* map, const video_image_t* frame) {
+    if (!video_darkframe_is_calibrating(map) || !video_image_is_valid(frame) ||
+        frame->width != map->config.width || frame->height != map->config.height) {
+        return false;
+    }
+
+    uint8_t offset, step;
+    if (!luma_layout(frame->format, &offset, &step)) {
+        return false;
+    }
+
+    for (uint16_t row = 0; row < frame->height; row++) {
+        const uint8_t* luma = video_image_row(frame, row) + offset;
+        uint16_t* sums = map->calibration_sums + (uint32_t)row * frame->width;
+        for (uint16_t x = 0; x < frame->width; x++, luma += step) {
+            sums[x] += *luma;
+        }
+    }
+
+    if (++map->calibration_frames >= map->calibration_target) {
+        return video_darkframe_end_calibration(map);
+    }
+    return false;
+}
+
+// Average the frames added so far into the offset map and hot pixel list
+bool video_darkframe_end_calibration(video_darkframe_t* map) {
+    if (!video_darkframe_is_calibrating(map) || map->calibration_frames == 0) {
+        return false;
+    }
+
+    const video_darkframe_config_t* cfg = &map->config;
+    uint32_t pixels = (uint32_t)cfg->width * cfg->height;
+    uint16_t frames = map->calibration_frames;
+
+    // Mean dark level first; offsets are derived from it in place
+    for (uint32_t i = 0; i < pixels; i++) {
+        map->offsets[i] = (map->calibration_sums[i] + frames / 2) / frames;
+    }
+
+    // Hot pixels stand out from their neighbourhood (row order keeps the list sorted)
+    map->hot_count = 0;
+    map->stats.hot_pixels_dropped = 0;
+    for (uint16_t y = 0; y < cfg->height; y++) {
+        for (uint16_t x = 0; x < cfg->width; x++) {
+            uint8_t level = map->offsets[(uint32_t)y * cfg->width + x];
+            uint8_t median = neighbourhood_median(map->offsets, cfg->width, 1, cfg->width, cfg->height, x, y);
+            if (level > median + cfg->hot_threshold) {
+                if (map->hot_count < cfg->max_hot_pixels) {
+                    map->hot_pixels[map->hot_count].x = x;
+                    map->hot_pixels[map->hot_count].y = y;
+                    map->hot_count++;
+                } else {
+                    map->stats.hot_pixels_dropped++;
+                }
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < pixels; i++) {
+        map->offsets[i] = (map->offsets[i] > cfg->black_level) ? map->offsets[i] - cfg->black_level : 0;
+    }
+
+    // Hot pixels are replaced outright, so their offsets would only stop the map packing into nibbles
+    for (uint16_t i = 0; i < map->hot_count; i++) {
+        map->offsets[(uint32_t)map->hot_pixels[i].y * cfg->width + map->hot_pixels[i].x] = 0;
+    }
+
+    free(map->calibration_sums);
+    map->calibration_sums = nullptr;
+    map->calibration_target = 0;
+    map->valid = true;
+
+    Serial.printf("Dark-frame calibration complete: %d frames, %d hot pixels\n", frames, map->hot_count);
+    return true;
+}
+
+bool video_darkframe_is_calibrating(video_darkframe_t* map) {
+    return map && map->calibration_sums && map->calibration_target > 0;
+}
+
+// ============================================================================
+// Correction
+// ============================================================================
+
+// Saturating subtract of the offset map from one UYVY line. Both luma samples
+// of a word are handled together in 16-bit lanes: a guard bit above each lane
+// survives the subtraction only if the result is not negative.
+void IRAM_ATTR video_darkframe_subtract_uyvy(video_darkframe_t* map, uint8_t* uyvy, uint16_t width, uint16_t row) {
+    if (!map || !map->valid || !uyvy || row >= map->config.height) return;
+    if (width > map->config.width) width = map->config.width;
+
+    const uint8_t* offsets = map->offsets + (uint32_t)row * map->config.width;
+    uint32_t words = width / 2;
+
+    for (uint32_t i = 0; i < words; i++, uyvy += 4, offsets += 2) {
+        uint32_t w;
+        memcpy(&w, uyvy, 4);
+
+        uint32_t sub = offsets[0] | ((uint32_t)offsets[1] << 16);
+        uint32_t diff = (((w >> 8) & LUMA_LANES) | 0x01000100) - sub;
+        uint32_t keep = ((diff >> 8) & 0x00010001) * 0xFF;
+
+        w = (w & LUMA_LANES) | ((diff & keep) << 8);
+        memcpy(uyvy, &w, 4);
+    }
+
+    map->stats.lines_corrected++;
+}
+
+// Replace every listed hot pixel's luma with its 3x3 median; returns pixels patched
+uint32_t video_darkframe_patch_image(video_darkframe_t* map, const video_image_t* image) {
+    uint8_t offset, step;
+    if (!map || !map->valid || !video_image_is_valid(image) || !luma_layout(image->format, &offset, &step)) {
+        return 0;
+    }
+
+    uint8_t* luma = image->data + offset;
+    uint32_t patched = 0;
+
+    for (uint16_t i = 0; i < map->hot_count; i++) {
+        const video_hot_pixel_t* hot = &map->hot_pixels[i];
+        if (hot->x >= image->width || hot->y >= image->height) continue;
+
+        uint8_t median = neighbourhood_median(luma, image->stride, step, image->width, image->height, hot->x, hot->y);
+        luma[(uint32_t)hot->y * image->stride + (uint32_t)hot->x * step] = median;
+        patched++;
+    }
+
+    map->stats.frames_patched++;
+    map->stats.pixels_patched += patched;
+    return patched;
+}
+
+// Subtract and patch a whole frame (UYVY, YUYV or grey)
+bool video_darkframe_apply_image(video_darkframe_t* map, const video_image_t* image) {
+    uint8_t offset, step;
+    if (!map || !map->valid || !video_image_is_valid(image) || !luma_layout(image->format, &offset, &step)) {
+        return false;
+    }
+
+    for (uint16_t row = 0; row < image->height && row < map->config.height; row++) {
+        uint8_t* line = video_image_row(image, row);
+
+        if (image->format == VIDEO_PIXEL_UYVY) {
+            video_darkframe_subtract_uyvy(map, line, image->width, row);
+            continue;
+        }
+
+        const uint8_t* offsets = map->offsets + (uint32_t)row * map->config.width;
+        uint8_t* luma = line + offset;
+        for (uint16_t x = 0; x < image->width && x < map->config.width; x++, luma += step) {
+            *luma = (*luma > offsets[x]) ? *luma - offsets[x] : 0;
+        }
+        map->stats.lines_corrected++;
+    }
+
+    video_darkframe_patch_image(map, image);
+    return true;
+}
+
+// ============================================================================
+// Binary Format
+// ============================================================================
+
+size_t video_darkframe_serialized_size(video_darkframe_t* map) {
+    if (!map || !map->valid) return 0;
+
+    uint32_t pixels = (uint32_t)map->config.width * map->config.height;
+    uint32_t map_bytes = (offset_bits(map) == 4) ? (pixels + 1) / 2 : pixels;
+    return VIDEO_DARKFRAME_HEADER_SIZE + map_bytes + (size_t)map->hot_count * 4;
+}
+
+// Returns the bytes written, 0 if there is no map or `capacity` is too small
+size_t video_darkframe_save(video_darkframe_t* map, uint8_t* out, size_t capacity) {
+    size_t size = video_darkframe_serialized_size(map);
+    if (size == 0 || !out || capacity < size) {
+        return 0;
+    }
+
+    uint32_t pixels = (uint32_t)map->config.width * map->config.height;
+    uint8_t bits = offset_bits(map);
+    uint8_t* payload = out + VIDEO_DARKFRAME_HEADER_SIZE;
+    uint8_t* p = payload;
+
+    if (bits == 4) {
+        for (uint32_t i = 0; i < pixels; i += 2) {
+            uint8_t high = (i + 1 < pixels) ? map->offsets[i + 1] : 0;
+            *p++ = map->offsets[i] | (high << 4);
+        }
+    } else {
+        memcpy(p, map->offsets, pixels);
+        p += pixels;
+    }
+
+    for (uint16_t i = 0; i < map->hot_count; i++, p += 4) {
+        put_u16(p, map->hot_pixels[i].x);
+        put_u16(p + 2, map->hot_pixels[i].y);
+    }
+
+    put_u32(out, VIDEO_DARKFRAME_MAGIC);
+    put_u16(out + 4, map->config.width);
+    put_u16(out + 6, map->config.height);
+    out[8] = map->config.black_level;
+    out[9] = bits;
+    put_u16(out + 10, map->hot_count);
+    put_u32(out + 12, payload_checksum(payload, size - VIDEO_DARKFRAME_HEADER_SIZE));
+    return size;
+}
+
+// Load a saved map; it must match the configured frame size
+bool video_darkframe_load(video_darkframe_t* map, const uint8_t* data, size_t length) {
+    if (!map || !map->offsets || !data || length < VIDEO_DARKFRAME_HEADER_SIZE) {
+        return false;
+    }
+
+    uint16_t width = get_u16(data + 4);
+    uint16_t height = get_u16(data + 6);
+    uint8_t bits = data[9];
+    uint16_t hot_count = get_u16(data + 10);
+
+    if (get_u32(data) != VIDEO_DARKFRAME_MAGIC || (bits != 4 && bits != 8)) {
+        Serial.println("ERROR: Not a dark-frame map");
+        return false;
+    }
+    if (width != map->config.width || height != map->config.height || hot_count > map->config.max_hot_pixels) {
+        Serial.println("ERROR: Dark-frame map does not match this configuration");
+        return false;
+    }
+
+    uint32_t pixels = (uint32_t)width * height;
+    uint32_t map_bytes = (bits == 4) ? (pixels + 1) / 2 : pixels;
+    size_t size = VIDEO_DARKFRAME_HEADER_SIZE + map_bytes + (size_t)hot_count * 4;
+    const uint8_t* payload = data + VIDEO_DARKFRAME_HEADER_SIZE;
+
+    if (length < size || payload_checksum(payload, size - VIDEO_DARKFRAME_HEADER_SIZE) != get_u32(data + 12)) {
+        Serial.println("ERROR: Dark-frame map is truncated or corrupt");
+        return false;
+    }
+
+    if (bits == 4) {
+        for (uint32_t i = 0; i < pixels; i++) {
+            map->offsets[i] = (payload[i / 2] >> ((i & 1) * 4)) & 0x0F;
+        }
+    } else {
+        memcpy(map->offsets, payload, pixels);
+    }
+
+    const uint8_t* p = payload + map_bytes;
+    for (uint16_t i = 0; i < hot_count; i++, p += 4) {
+        map->hot_pixels[i].x = get_u16(p);
+        map->hot_pixels[i].y = get_u16(p + 2);
+    }
+
+    map->hot_count = hot_count;
+    map->config.black_level = data[8];
+    map->valid = true;
+    return true;
+}
+
+// ============================================================================
+// Status and Statistics Functions
+// ============================================================================
+
+video_darkframe_stats_t video_darkframe_get_stats(video_darkframe_t* map) {
+    if (map) {
+        return map->stats;
+    }
+    video_darkframe_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+void video_darkframe_print_stats(video_darkframe_t* map) {
+    if (!map) return;
+
+    Serial.println("=== Dark-Frame Correction Statistics ===");
+    Serial.printf("Map: %s, %d hot pixels\n", map->valid ? "valid" : "none", map->hot_count);
+    if (video_darkframe_is_calibrating(map)) {
+        Serial.printf("Calibrating: %d of %d frames\n", map->calibration_frames, map->calibration_target);
+    }
+    Serial.printf("Lines Corrected: %lu\n", map->stats.lines_corrected);
+    Serial.printf("Frames Patched: %lu\n", map->stats.frames_patched);
+    Serial.printf("Pixels Patched: %lu\n", map->stats.pixels_patched);
+    Serial.printf("Hot Pixels Dropped: %lu\n", map->stats.hot_pixels_dropped);
+    Serial.println("========================================");
+}
@@ -0,0 +1,106 @@
+#ifndef VIDEO_DARKFRAME_H
+#define VIDEO_DARKFRAME_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "video_image.h"
+
+// ============================================================================
+// Dark-Frame Correction Configuration
+// ============================================================================
+
+#define VIDEO_DARKFRAME_MAX_CALIBRATION    256       // Frames a 16-bit sum can average
+#define VIDEO_DARKFRAME_MAGIC              0x314D4644  // "DFM1", little endian
+#define VIDEO_DARKFRAME_HEADER_SIZE        16        // Bytes before the offset map
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Dark-frame correction configuration
+typedef struct {
+    uint16_t width;                // Pixels per line
+    uint16_t height;               // Rows per frame
+    uint8_t black_level;           // Luma of a correct dark pixel (16 for BT.601)
+    uint8_t hot_threshold;         // Dark level above the local median that marks a hot pixel
+    uint16_t max_hot_pixels;       // Capacity of the hot pixel list
+} video_darkframe_config_t;
+
+// Hot pixel position
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+} video_hot_pixel_t;
+
+// Dark-frame correction statistics
+typedef struct {
+    uint32_t lines_corrected;      // Lines with the offset map subtracted
+    uint32_t frames_patched;       // Frames with hot pixels replaced
+    uint32_t pixels_patched;       // Hot pixels replaced in total
+    uint32_t hot_pixels_dropped;   // Hot pixels found beyond max_hot_pixels
+} video_darkframe_stats_t;
+
+// Fixed-pattern noise correction
+// Calibration averages dark frames (lens capped) into a per-pixel luma offset
+// above the black level and lists pixels that stand out from their
+// neighbourhood. At runtime the offsets are subtracted line by line and each
+// listed pixel is replaced by the median of its 3x3 neighbourhood.
+typedef struct {
+    video_darkframe_config_t config;
+
+    uint8_t* offsets;              // Luma offset per pixel (width x height)
+    video_hot_pixel_t* hot_pixels; // Sorted by row, then column
+    uint16_t hot_count;            // Entries in hot_pixels
+    bool valid;                    // Map calibrated or loaded
+
+    uint16_t* calibration_sums;    // Dark frame sums (only while calibrating)
+    uint16_t calibration_frames;   // Frames added so far
+    uint16_t calibration_target;   // Frames to average
+
+    video_darkframe_stats_t stats;
+} video_darkframe_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core functions
+bool video_darkframe_init(video_darkframe_t* map, const video_darkframe_config_t* config);
+void video_darkframe_deinit(video_darkframe_t* map);
+bool video_darkframe_is_valid(video_darkframe_t* map);
+
+// Calibration: add frames captured with the lens covered; the map is built
+// when the last one arrives (add returns true once calibration is complete)
+bool video_darkframe_begin_calibration(video_darkframe_t* map, uint16_t frames);
+bool video_darkframe_add_calibration_frame(video_darkframe_t* map, const video_image_t* frame);
+bool video_darkframe_end_calibration(video_darkframe_t* map);
+bool video_darkframe_is_calibrating(video_darkframe_t* map);
+
+// Correction
+void video_darkframe_subtract_uyvy(video_darkframe_t* map, uint8_t* uyvy, uint16_t width, uint16_t row);
+uint32_t video_darkframe_patch_image(video_darkframe_t* map, const video_image_t* image);
+bool video_darkframe_apply_image(video_darkframe_t* map, const video_image_t* image);
+
+// Binary format: 16-byte header, offsets (4 or 8 bits each), then x/y pairs
+size_t video_darkframe_serialized_size(video_darkframe_t* map);
+size_t video_darkframe_save(video_darkframe_t* map, uint8_t* out, size_t capacity);
+bool video_darkframe_load(video_darkframe_t* map, const uint8_t* data, size_t length);
+
+// Status and statistics functions
+video_darkframe_stats_t video_darkframe_get_stats(video_darkframe_t* map);
+void video_darkframe_print_stats(video_darkframe_t* map);
+
+// ============================================================================
+// Default Configuration
+// ============================================================================
+
+static const video_darkframe_config_t VIDEO_DARKFRAME_DEFAULT_CONFIG = {
+    .width = 720,
+    .height = 576,
+    .black_level = 16,
+    .hot_threshold = 24,
+    .max_hot_pixels = 1024
+};
+
+#endif // VIDEO_DARKFRAME_H
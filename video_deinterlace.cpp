@@ -0,0 +1,344 @@
+#include "video_deinterlace.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+// Lines are processed a pixel pair (one 32-bit word) at a time. Even and odd
+// bytes are split into two 16-bit lanes so each operation covers four samples.
+#define BYTE_LANES     0x00FF00FF
+
+static inline uint32_t load_word(const uint8_t* p) {
+    uint32_t word;
+    memcpy(&word, p, 4);
+    return word;
+}
+
+// Per-byte rounded average of two words
+static inline uint32_t average_words(uint32_t a, uint32_t b) {
+    return (a | b) - (((a ^ b) & 0xFEFEFEFEUL) >> 1);
+}
+
+// Per-byte a + (b - a) * alpha / ALPHA_MAX
+static inline uint32_t blend_words(uint32_t a, uint32_t b, uint32_t alpha) {
+    uint32_t keep = VIDEO_DEINTERLACE_ALPHA_MAX - alpha;
+    uint32_t even = ((a & BYTE_LANES) * keep + (b & BYTE_LANES) * alpha + 0x00080008) >> 4;
+    uint32_t odd = (((a >> 8) & BYTE_LANES) * keep + ((b >> 8) & BYTE_LANES) * alpha + 0x00080008) >> 4;
+    return (even & BYTE_LANES) | ((odd & BYTE_LANES) << 8);
+}
+
+static inline uint8_t luma_difference(uint32_t a, uint32_t b, uint8_t shift) {
+    int d = (int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF);
+    return d < 0 ? -d : d;
+}
+
+static void build_alpha_lut(video_deinterlace_t* deinterlace) {
+    uint16_t threshold = deinterlace->config.motion_threshold;
+    uint16_t range = deinterlace->config.motion_range ? deinterlace->config.motion_range : 1;
+
+    for (int i = 0; i < 256; i++) {
+        if (i <= threshold) {
+            deinterlace->alpha_lut[i] = 0;
+        } else if (i >= threshold + range) {
+            deinterlace->alpha_lut[i] = VIDEO_DEINTERLACE_ALPHA_MAX;
+        } else {
+            deinterlace->alpha_lut[i] = ((i - threshold) * VIDEO_DEINTERLACE_ALPHA_MAX + range / 2) / range;
+        }
+    }
+}
+
+static inline uint8_t* store_row(video_deinterlace_t* deinterlace, uint16_t row) {
+    return deinterlace->field_store + (uint32_t)(row >> 1) * deinterlace->line_bytes;
+}
+
+// Bob: average of the current-field lines above and below
+static void IRAM_ATTR interpolate_line(const uint8_t* above, const uint8_t* below, uint8_t* out, uint32_t words) {
+    for (uint32_t i = 0; i < words; i++, above += 4, below += 4, out += 4) {
+        uint32_t word = average_words(load_word(above), load_word(below));
+        memcpy(out, &word, 4);
+    }
+}
+
+// Motion adaptive: how far the woven pixel sits from the bob estimate decides
+// how much of each to use. Static detail keeps full vertical resolution, while
+// moving edges (where the fields disagree) lose their combing.
+static void IRAM_ATTR motion_line(video_deinterlace_t* deinterlace, const uint8_t* woven,
+                                  const uint8_t* above, const uint8_t* below, uint8_t* out) {
+    const uint8_t* lut = deinterlace->alpha_lut;
+    const uint8_t shift0 = deinterlace->luma_offset * 8;
+    const uint8_t shift1 = shift0 + 16;
+    uint32_t words = deinterlace->line_bytes / 4;
+    uint32_t moving = 0;
+
+    for (uint32_t i = 0; i < words; i++, woven += 4, above += 4, below += 4, out += 4) {
+        uint32_t weave = load_word(woven);
+        uint32_t bob = average_words(load_word(above), load_word(below));
+
+        uint8_t d0 = luma_difference(weave, bob, shift0);
+        uint8_t d1 = luma_difference(weave, bob, shift1);
+        uint8_t alpha = lut[d0 > d1 ? d0 : d1];
+
+        uint32_t word = weave;
+        if (alpha == VIDEO_DEINTERLACE_ALPHA_MAX) {
+            word = bob;
+        } else if (alpha) {
+            word = blend_words(weave, bob, alpha);
+        }
+        moving += (alpha != 0);
+        memcpy(out, &word, 4);
+    }
+
+    deinterlace->stats.moving_pairs += moving;
+    deinterlace->stats.static_pairs += words - moving;
+}
+
+// Hand one output row to the destination and/or line callback
+static void IRAM_ATTR deliver_row(video_deinterlace_t* deinterlace, const uint8_t* data, uint16_t row) {
+    const video_deinterlace_config_t* cfg = &deinterlace->config;
+
+    if (deinterlace->destination.data) {
+        uint8_t* dst = video_image_row(&deinterlace->destination, row);
+        if (dst != data) {
+            memcpy(dst, data, deinterlace->line_bytes);
+        }
+        data = dst;
+    }
+    deinterlace->stats.lines_out++;
+
+    if (deinterlace->line_callback) {
+        video_image_t line = video_image_make((uint8_t*)data, cfg->width, 1, cfg->format);
+        deinterlace->line_callback(&line, row);
+    }
+}
+
+// Build the row missing from the current field between `above` and `below`
+// (either may be NULL at the frame edges)
+static void IRAM_ATTR emit_missing_row(video_deinterlace_t* deinterlace, uint16_t row,
+                                       const uint8_t* above, const uint8_t* below) {
+    if (!above) above = below;
+    if (!below) below = above;
+    if (!above) return;
+
+    const uint8_t* woven = store_row(deinterlace, row);
+    uint8_t* out = deinterlace->destination.data ? video_image_row(&deinterlace->destination, row)
+                                                 : deinterlace->output_line;
+
+    switch (deinterlace->config.mode) {
+        case VIDEO_DEINTERLACE_WEAVE:
+            memcpy(out, woven, deinterlace->line_bytes);
+            break;
+
+        case VIDEO_DEINTERLACE_BOB:
+            interpolate_line(above, below, out, deinterlace->line_bytes / 4);
+            break;
+
+        case VIDEO_DEINTERLACE_MOTION:
+            motion_line(deinterlace, woven, above, below, out);
+            break;
+
+        default:
+            return;
+    }
+
+    deliver_row(deinterlace, out, row);
+}
+
+// ============================================================================
+// Core Deinterlacer Functions
+// ============================================================================
+
+bool video_deinterlace_init(video_deinterlace_t* deinterlace, const video_deinterlace_config_t* config) {
+    if (!deinterlace || !config) {
+        Serial.println("ERROR: Invalid deinterlacer pointer");
+        return false;
+    }
+
+    memset(deinterlace, 0, sizeof(video_deinterlace_t));
+    deinterlace->config = *config;
+    const video_deinterlace_config_t* cfg = &deinterlace->config;
+
+    if (!video_image_is_422(cfg->format) || cfg->width < 2 || (cfg->width & 1) || cfg->height < 2) {
+        Serial.println("ERROR: Deinterlacer needs 4:2:2 lines of even width and at least two rows");
+        return false;
+    }
+
+    deinterlace->line_bytes = (uint32_t)cfg->width * 2;
+    deinterlace->field_lines = (cfg->height + 1) / 2;
+    deinterlace->luma_offset = (cfg->format == VIDEO_PIXEL_UYVY) ? 1 : 0;
+    deinterlace->last_index = -1;
+    build_alpha_lut(deinterlace);
+
+    deinterlace->field_store = (uint8_t*)malloc(deinterlace->field_lines * deinterlace->line_bytes);
+    deinterlace->previous_line = (uint8_t*)malloc(deinterlace->line_bytes);
+    deinterlace->output_line = (uint8_t*)malloc(deinterlace->line_bytes);
+
+    if (!deinterlace->field_store || !deinterlace->previous_line || !deinterlace->output_line) {
+        Serial.println("ERROR: Failed to allocate deinterlacer buffers");
+        video_deinterlace_deinit(deinterlace);
+        return false;
+    }
+
+    // Until a first field arrives, the opposite field is black
+    uint8_t black[4];
+    black[deinterlace->luma_offset] = 16;
+    black[deinterlace->luma_offset + 2] = 16;
+    black[deinterlace->luma_offset ^ 1] = 128;
+    black[(deinterlace->luma_offset + 2) ^ 1] = 128;
+    for (uint32_t i = 0; i < deinterlace->field_lines * deinterlace->line_bytes; i += 4) {
+        memcpy(deinterlace->field_store + i, black, 4);
+    }
+
+    Serial.printf("Deinterlacer initialized: %dx%d, mode %d\n", cfg->width, cfg->height, cfg->mode);
+    return true;
+}
+
+void video_deinterlace_deinit(video_deinterlace_t* deinterlace) {
+    if (!deinterlace) return;
+
+    if (deinterlace->field_store) free(deinterlace->field_store);
+    if (deinterlace->previous_line) free(deinterlace->previous_line);
+    if (deinterlace->output_line) free(deinterlace->output_line);
+
+    memset(deinterlace, 0, sizeof(video_deinterlace_t));
+}
+
+// Takes effect from the next line
+void video_deinterlace_set_mode(video_deinterlace_t* deinterlace, video_deinterlace_mode_t mode) {
+    if (deinterlace) {
+        deinterlace->config.mode = mode;
+    }
+}
+
+void video_deinterlace_set_line_callback(video_deinterlace_t* deinterlace,
+                                         void (*callback)(const video_image_t* line, uint16_t row)) {
+    if (deinterlace) {
+        deinterlace->line_callback = callback;
+    }
+}
+
+// Write output rows straight into `destination` (NULL = callback only)
+void video_deinterlace_set_destination(video_deinterlace_t* deinterlace, const video_image_t* destination) {
+    if (!deinterlace) return;
+
+    if (destination && video_image_is_valid(destination) &&
+        destination->format == deinterlace->config.format &&
+        destination->width == deinterlace->config.width &&
+        destination->height >= deinterlace->config.height) {
+        deinterlace->destination = *destination;
+    } else {
+        deinterlace->destination.data = nullptr;
+    }
+}
+
+// ============================================================================
+// Streaming Functions
+// ============================================================================
+
+void IRAM_ATTR video_deinterlace_push_line(video_deinterlace_t* deinterlace, const uint8_t* line, uint16_t row) {
+    if (!deinterlace || !deinterlace->field_store || !line || row >= deinterlace->config.height) return;
+
+    uint8_t parity = row & 1;
+    int16_t index = row >> 1;
+
+    // A parity change or a line out of sequence starts a new field
+    if (deinterlace->last_index >= 0 && (parity != deinterlace->field || index <= deinterlace->last_index)) {
+        video_deinterlace_end_field(deinterlace);
+    }
+    if (deinterlace->last_index < 0) {
+        deinterlace->field = parity;
+        deinterlace->above = nullptr;
+    }
+    if (index != deinterlace->last_index + 1) {
+        deinterlace->above = nullptr;    // Lines were lost, nothing adjacent to interpolate from
+    }
+    deinterlace->last_index = index;
+    deinterlace->stats.lines_in++;
+
+    if (deinterlace->config.mode == VIDEO_DEINTERLACE_OFF) {
+        deliver_row(deinterlace, line, row);
+        return;
+    }
+
+    // Missing row above this line, then the line itself
+    if (row > 0) {
+        emit_missing_row(deinterlace, row - 1, deinterlace->above, line);
+    }
+    deliver_row(deinterlace, line, row);
+
+    // The opposite field's row just used is replaced by this field's line of the same
+    // index, which for field 0 is the previous line (its row below is only now built)
+    uint8_t* slot;
+    if (parity) {
+        slot = store_row(deinterlace, row);
+        memcpy(slot, line, deinterlace->line_bytes);
+        deinterlace->above = slot;
+    } else {
+        if (deinterlace->above) {
+            memcpy(store_row(deinterlace, row - 1), deinterlace->above, deinterlace->line_bytes);
+        }
+        memcpy(deinterlace->previous_line, line, deinterlace->line_bytes);
+        deinterlace->above = deinterlace->previous_line;
+    }
+}
+
+void video_deinterlace_end_field(video_deinterlace_t* deinterlace) {
+    if (!deinterlace || deinterlace->last_index < 0) return;
+
+    // Field 0 still owes the row below its last line
+    uint16_t row = deinterlace->last_index * 2 + deinterlace->field + 1;
+    if (deinterlace->config.mode != VIDEO_DEINTERLACE_OFF && deinterlace->above) {
+        if (row < deinterlace->config.height) {
+            emit_missing_row(deinterlace, row, deinterlace->above, nullptr);
+        }
+        if (deinterlace->field == 0) {
+            memcpy(store_row(deinterlace, row - 1), deinterlace->above, deinterlace->line_bytes);
+        }
+    }
+
+    deinterlace->stats.fields++;
+    deinterlace->last_index = -1;
+    deinterlace->above = nullptr;
+}
+
+bool video_deinterlace_push_field(video_deinterlace_t* deinterlace, const video_image_t* field, uint8_t parity) {
+    if (!deinterlace || !video_image_is_valid(field) || field->format != deinterlace->config.format ||
+        field->width != deinterlace->config.width || parity > 1) {
+        return false;
+    }
+
+    for (uint16_t i = 0; i < field->height; i++) {
+        video_deinterlace_push_line(deinterlace, video_image_row(field, i), i * 2 + parity);
+    }
+    video_deinterlace_end_field(deinterlace);
+    return true;
+}
+
+// ============================================================================
+// Status and Statistics Functions
+// ============================================================================
+
+video_deinterlace_stats_t video_deinterlace_get_stats(video_deinterlace_t* deinterlace) {
+    if (deinterlace) {
+        return deinterlace->stats;
+    }
+    video_deinterlace_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+void video_deinterlace_print_stats(video_deinterlace_t* deinterlace) {
+    if (!deinterlace) return;
+
+    video_deinterlace_stats_t* stats = &deinterlace->stats;
+    uint32_t pairs = stats->moving_pairs + stats->static_pairs;
+
+    Serial.println("=== Deinterlacer Statistics ===");
+    Serial.printf("Mode: %d\n", deinterlace->config.mode);
+    Serial.printf("Fields: %lu\n", stats->fields);
+    Serial.printf("Lines In: %lu\n", stats->lines_in);
+    Serial.printf("Lines Out: %lu\n", stats->lines_out);
+    if (pairs > 0) {
+        Serial.printf("Moving Pixels: %lu%%\n", (uint32_t)((uint64_t)stats->moving_pairs * 100 / pairs));
+    }
+    Serial.println("===============================");
+}
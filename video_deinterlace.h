@@ -0,0 +1,114 @@
+#ifndef VIDEO_DEINTERLACE_H
+#define VIDEO_DEINTERLACE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "video_image.h"
+
+// ============================================================================
+// Deinterlacer Configuration
+// ============================================================================
+
+#define VIDEO_DEINTERLACE_ALPHA_MAX         16    // Blend weight of a fully moving pixel (pure bob)
+#define VIDEO_DEINTERLACE_DEFAULT_THRESHOLD 12    // Luma difference still treated as static
+#define VIDEO_DEINTERLACE_DEFAULT_RANGE     24    // Difference over which weave fades into bob
+
+// Deinterlacing method
+typedef enum {
+    VIDEO_DEINTERLACE_OFF = 0,     // Lines pass through at their woven rows
+    VIDEO_DEINTERLACE_BOB,         // Missing rows interpolated from the current field
+    VIDEO_DEINTERLACE_WEAVE,       // Missing rows taken from the previous field
+    VIDEO_DEINTERLACE_MOTION       // Weave where static, bob where the fields disagree
+} video_deinterlace_mode_t;
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Deinterlacer configuration
+typedef struct {
+    uint16_t width;                // Pixels per line
+    uint16_t height;               // Rows in the output frame (both fields)
+    uint8_t format;                // VIDEO_PIXEL_UYVY or VIDEO_PIXEL_YUYV
+    video_deinterlace_mode_t mode; // Deinterlacing method
+    uint8_t motion_threshold;      // MOTION: luma difference below which the pixel weaves
+    uint8_t motion_range;          // MOTION: further difference at which it is pure bob
+} video_deinterlace_config_t;
+
+// Deinterlacer statistics
+typedef struct {
+    uint32_t fields;               // Fields completed (one output frame each)
+    uint32_t lines_in;             // Field lines pushed
+    uint32_t lines_out;            // Frame rows produced
+    uint32_t moving_pairs;         // MOTION: pixel pairs blended towards bob
+    uint32_t static_pairs;         // MOTION: pixel pairs woven unchanged
+} video_deinterlace_stats_t;
+
+// Streaming field-rate deinterlacer
+// Every field produces a full frame. When field line k arrives, the missing
+// row above it is built from line k-1, line k and the opposite field's row,
+// so output follows the incoming field line by line. The opposite field is
+// held in `field_store`, each row being replaced by the current field's
+// line as soon as it has been used.
+typedef struct {
+    video_deinterlace_config_t config;
+
+    uint8_t* field_store;          // One field of lines (opposite parity until consumed)
+    uint8_t* previous_line;        // Copy of the last current-field line (field 0)
+    uint8_t* output_line;          // Interpolated row when no destination is set
+    const uint8_t* above;          // Current-field line above the next missing row
+    uint32_t line_bytes;           // Bytes per line
+    uint16_t field_lines;          // Rows per field
+    uint8_t luma_offset;           // Byte of Y0 within a pixel pair
+
+    uint8_t alpha_lut[256];        // Luma difference -> blend weight (0..ALPHA_MAX)
+
+    int16_t last_index;            // Field line last pushed (-1 = field not started)
+    uint8_t field;                 // Parity of the field being pushed
+
+    video_image_t destination;     // Output frame (data NULL = callback only)
+    video_deinterlace_stats_t stats;
+
+    // Called with each output row (a one-row view) and its frame row
+    void (*line_callback)(const video_image_t* line, uint16_t row);
+} video_deinterlace_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core deinterlacer functions
+bool video_deinterlace_init(video_deinterlace_t* deinterlace, const video_deinterlace_config_t* config);
+void video_deinterlace_deinit(video_deinterlace_t* deinterlace);
+void video_deinterlace_set_mode(video_deinterlace_t* deinterlace, video_deinterlace_mode_t mode);
+void video_deinterlace_set_line_callback(video_deinterlace_t* deinterlace,
+                                         void (*callback)(const video_image_t* line, uint16_t row));
+void video_deinterlace_set_destination(video_deinterlace_t* deinterlace, const video_image_t* destination);
+
+// Streaming: push the lines of each field in order by woven frame row
+// (row & 1 = field), then end the field to flush the last row
+void video_deinterlace_push_line(video_deinterlace_t* deinterlace, const uint8_t* line, uint16_t row);
+void video_deinterlace_end_field(video_deinterlace_t* deinterlace);
+
+// A whole field (e.g. frame_buffer_get_field()) through the same path
+bool video_deinterlace_push_field(video_deinterlace_t* deinterlace, const video_image_t* field, uint8_t parity);
+
+// Status and statistics functions
+video_deinterlace_stats_t video_deinterlace_get_stats(video_deinterlace_t* deinterlace);
+void video_deinterlace_print_stats(video_deinterlace_t* deinterlace);
+
+// ============================================================================
+// Default Configuration
+// ============================================================================
+
+static const video_deinterlace_config_t VIDEO_DEINTERLACE_DEFAULT_CONFIG = {
+    .width = 720,
+    .height = 576,
+    .format = VIDEO_PIXEL_UYVY,
+    .mode = VIDEO_DEINTERLACE_MOTION,
+    .motion_threshold = VIDEO_DEINTERLACE_DEFAULT_THRESHOLD,
+    .motion_range = VIDEO_DEINTERLACE_DEFAULT_RANGE
+};
+
+#endif // VIDEO_DEINTERLACE_H
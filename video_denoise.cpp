@@ -0,0 +1,171 @@
+#include "video_denoise.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+// History weight falls linearly from `strength` at no difference to zero at
+// `motion_threshold`; the step is the rounded remainder of the difference.
+static void rebuild_step_lut(video_denoise_t* denoise) {
+    int strength = denoise->config.strength;
+    int threshold = denoise->config.motion_threshold ? denoise->config.motion_threshold : 1;
+
+    if (strength > VIDEO_DENOISE_WEIGHT_MAX) strength = VIDEO_DENOISE_WEIGHT_MAX;
+
+    for (int d = -255; d <= 255; d++) {
+        int magnitude = d < 0 ? -d : d;
+        int keep = (magnitude >= threshold) ? 0 : (strength * (threshold - magnitude) + threshold / 2) / threshold;
+        int take = VIDEO_DENOISE_WEIGHT_MAX - keep;
+
+        // Round away from zero so a lasting change always moves the history
+        int step = (magnitude * take + VIDEO_DENOISE_WEIGHT_MAX / 2) / VIDEO_DENOISE_WEIGHT_MAX;
+        if (step == 0 && magnitude > 0 && take > 0) step = 1;
+        denoise->step_lut[d + 255] = d < 0 ? -step : step;
+    }
+}
+
+// ============================================================================
+// Core Noise Reduction Functions
+// ============================================================================
+
+bool video_denoise_init(video_denoise_t* denoise, const video_denoise_config_t* config) {
+    if (!denoise || !config || config->width == 0 || config->height == 0) {
+        Serial.println("ERROR: Invalid noise reduction configuration");
+        return false;
+    }
+
+    memset(denoise, 0, sizeof(video_denoise_t));
+    denoise->config = *config;
+
+    denoise->history = (uint8_t*)malloc((uint32_t)config->width * config->height);
+    denoise->row_seeded = (uint8_t*)calloc(config->height, 1);
+
+    if (!denoise->history || !denoise->row_seeded) {
+        Serial.println("ERROR: Failed to allocate noise reduction history");
+        video_denoise_deinit(denoise);
+        return false;
+    }
+
+    for (int i = 0; i < 256; i++) {
+        denoise->identity_lut[i] = i;
+    }
+    rebuild_step_lut(denoise);
+
+    Serial.printf("Temporal noise reduction initialized: %dx%d, strength %d/16\n",
+                  config->width, config->height, config->strength);
+    return true;
+}
+
+void video_denoise_deinit(video_denoise_t* denoise) {
+    if (!denoise) return;
+
+    if (denoise->history) free(denoise->history);
+    if (denoise->row_seeded) free(denoise->row_seeded);
+
+    memset(denoise, 0, sizeof(video_denoise_t));
+}
+
+// Forget the history (scene cut, input switch); the next frame restarts it
+void video_denoise_reset(video_denoise_t* denoise) {
+    if (denoise && denoise->row_seeded) {
+        memset(denoise->row_seeded, 0, denoise->config.height);
+    }
+}
+
+void video_denoise_set_strength(video_denoise_t* denoise, uint8_t strength, uint8_t motion_threshold) {
+    if (!denoise) return;
+
+    if (denoise->config.strength != strength || denoise->config.motion_threshold != motion_threshold) {
+        denoise->config.strength = strength;
+        denoise->config.motion_threshold = motion_threshold;
+        rebuild_step_lut(denoise);
+    }
+}
+
+// ============================================================================
+// Per-Line Application
+// ============================================================================
+
+// One pass over a UYVY line: per 32-bit word (Cb Y0 Cr Y1) the two luma samples
+// are filtered against one 16-bit history read and write, then all four
+// samples go through the tone tables and the word is stored once.
+void IRAM_ATTR video_denoise_apply_uyvy(video_denoise_t* denoise, video_tone_t* tone,
+                                        uint8_t* uyvy, uint16_t width, uint16_t row) {
+    if (!denoise || !uyvy) return;
+
+    if (!denoise->history || row >= denoise->config.height || denoise->config.strength == 0) {
+        video_tone_apply_uyvy(tone, uyvy, width);
+        return;
+    }
+    if (width > denoise->config.width) width = denoise->config.width;
+
+    uint8_t* history = denoise->history + (uint32_t)row * denoise->config.width;
+    uint32_t words = width / 2;
+
+    // A row without history starts it from this frame
+    if (!denoise->row_seeded[row]) {
+        for (uint32_t i = 0; i < words; i++) {
+            history[i * 2] = uyvy[i * 4 + 1];
+            history[i * 2 + 1] = uyvy[i * 4 + 3];
+        }
+        denoise->row_seeded[row] = 1;
+        denoise->stats.lines_seeded++;
+        video_tone_apply_uyvy(tone, uyvy, width);
+        return;
+    }
+
+    const video_tone_table_t* table = video_tone_acquire(tone);
+    bool toned = table && !table->identity;
+    const uint8_t* ylut = toned ? table->luma_lut : denoise->identity_lut;
+    const uint8_t* clut = toned ? table->chroma_lut : denoise->identity_lut;
+
+    const int16_t* step = denoise->step_lut + 255;
+
+    for (uint32_t i = 0; i < words; i++, uyvy += 4, history += 2) {
+        uint32_t w;
+        uint16_t h;
+        memcpy(&w, uyvy, 4);
+        memcpy(&h, history, 2);
+
+        int h0 = h & 0xFF;
+        int h1 = h >> 8;
+        h0 += step[(int)((w >> 8) & 0xFF) - h0];
+        h1 += step[(int)(w >> 24) - h1];
+
+        h = (uint16_t)(h0 | (h1 << 8));
+        w = (uint32_t)clut[w & 0xFF] |
+            ((uint32_t)ylut[h0] << 8) |
+            ((uint32_t)clut[(w >> 16) & 0xFF] << 16) |
+            ((uint32_t)ylut[h1] << 24);
+
+        memcpy(history, &h, 2);
+        memcpy(uyvy, &w, 4);
+    }
+
+    video_tone_release(tone, table);
+    denoise->stats.lines_filtered++;
+}
+
+// ============================================================================
+// Status and Statistics Functions
+// ============================================================================
+
+video_denoise_stats_t video_denoise_get_stats(video_denoise_t* denoise) {
+    if (denoise) {
+        return denoise->stats;
+    }
+    video_denoise_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+void video_denoise_print_stats(video_denoise_t* denoise) {
+    if (!denoise) return;
+
+    Serial.println("=== Noise Reduction Statistics ===");
+    Serial.printf("Strength: %d/16, motion threshold %d\n", denoise->config.strength,
+                  denoise->config.motion_threshold);
+    Serial.printf("Lines Filtered: %lu\n", denoise->stats.lines_filtered);
+    Serial.printf("Lines Seeded: %lu\n", denoise->stats.lines_seeded);
+    Serial.println("==================================");
+}
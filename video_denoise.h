@@ -0,0 +1,80 @@
+#ifndef VIDEO_DENOISE_H
+#define VIDEO_DENOISE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "video_tone.h"
+
+// ============================================================================
+// Temporal Noise Reduction Configuration
+// ============================================================================
+
+#define VIDEO_DENOISE_WEIGHT_MAX           16    // History weights are in 16ths
+#define VIDEO_DENOISE_DEFAULT_STRENGTH     12    // History kept for static pixels (12/16)
+#define VIDEO_DENOISE_DEFAULT_THRESHOLD    24    // Luma change that counts as full motion
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Temporal noise reduction configuration
+typedef struct {
+    uint16_t width;                // Pixels per line
+    uint16_t height;               // Rows per frame
+    uint8_t strength;              // History weight of a static pixel in 16ths (0 = off)
+    uint8_t motion_threshold;      // Difference at which the history weight reaches zero
+} video_denoise_config_t;
+
+// Temporal noise reduction statistics
+typedef struct {
+    uint32_t lines_filtered;       // Lines blended with their history
+    uint32_t lines_seeded;         // Lines that (re)started their history
+} video_denoise_stats_t;
+
+// Recursive (IIR) temporal filter on luma
+// Each pixel moves towards the new sample by a step taken from a table indexed
+// by the frame difference: small differences (grain) are mostly averaged away,
+// large ones (motion) pass through so moving objects do not smear. The history
+// is one 8-bit plane of the filtered, pre-tone luma.
+typedef struct {
+    video_denoise_config_t config;
+
+    uint8_t* history;              // Filtered luma, width x height
+    uint8_t* row_seeded;           // Rows holding history from an earlier frame
+    int16_t step_lut[511];         // Difference (new - history + 255) -> history step
+    uint8_t identity_lut[256];     // Pass-through tables when no tone curve is applied
+
+    video_denoise_stats_t stats;
+} video_denoise_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core noise reduction functions
+bool video_denoise_init(video_denoise_t* denoise, const video_denoise_config_t* config);
+void video_denoise_deinit(video_denoise_t* denoise);
+void video_denoise_reset(video_denoise_t* denoise);
+void video_denoise_set_strength(video_denoise_t* denoise, uint8_t strength, uint8_t motion_threshold);
+
+// Per-line application, fused with the tone curve (tone may be NULL)
+void video_denoise_apply_uyvy(video_denoise_t* denoise, video_tone_t* tone,
+                              uint8_t* uyvy, uint16_t width, uint16_t row);
+
+// Status and statistics functions
+video_denoise_stats_t video_denoise_get_stats(video_denoise_t* denoise);
+void video_denoise_print_stats(video_denoise_t* denoise);
+
+// ============================================================================
+// Default Configuration
+// ============================================================================
+
+static const video_denoise_config_t VIDEO_DENOISE_DEFAULT_CONFIG = {
+    .width = 720,
+    .height = 576,
+    .strength = VIDEO_DENOISE_DEFAULT_STRENGTH,
+    .motion_threshold = VIDEO_DENOISE_DEFAULT_THRESHOLD
+};
+
+#endif // VIDEO_DENOISE_H
@@ -0,0 +1,167 @@
+#include "video_fused.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Pre-Instantiated Chains
+// ============================================================================
+
+void IRAM_ATTR video_fused_uyvy_palette_rgb565(const video_fused_context_t* ctx, const uint8_t* uyvy,
+                                               uint16_t* rgb565, uint16_t width) {
+    video_fused_line<video_fused_read_uyvy, video_fused_write_rgb565,
+                     video_fused_luma_lut, video_fused_palette>(ctx, uyvy, (uint8_t*)rgb565, width);
+}
+
+void IRAM_ATTR video_fused_uyvy_tone_rgb565(const video_fused_context_t* ctx, const uint8_t* uyvy,
+                                            uint16_t* rgb565, uint16_t width) {
+    video_fused_line<video_fused_read_uyvy, video_fused_write_rgb565,
+                     video_fused_tone, video_fused_ycbcr_to_rgb, video_fused_pack_rgb565>(
+        ctx, uyvy, (uint8_t*)rgb565, width);
+}
+
+void IRAM_ATTR video_fused_uyvy_tone_rgb888(const video_fused_context_t* ctx, const uint8_t* uyvy,
+                                            uint8_t* rgb888, uint16_t width) {
+    video_fused_line<video_fused_read_uyvy, video_fused_write_rgb888,
+                     video_fused_tone, video_fused_ycbcr_to_rgb>(ctx, uyvy, rgb888, width);
+}
+
+static void uyvy_palette_rgb888(const video_fused_context_t* ctx, const uint8_t* uyvy,
+                                uint8_t* rgb888, uint16_t width) {
+    video_fused_line<video_fused_read_uyvy, video_fused_write_rgb888,
+                     video_fused_luma_lut, video_fused_palette_rgb>(ctx, uyvy, rgb888, width);
+}
+
+bool video_fused_image(const video_fused_context_t* ctx, const video_image_t* src, const video_image_t* dst) {
+    if (!ctx || !ctx->tone || !video_image_is_valid(src) || !video_image_is_valid(dst) ||
+        src->format != VIDEO_PIXEL_UYVY || src->width != dst->width || src->height != dst->height) {
+        return false;
+    }
+
+    bool palette = ctx->palette && ctx->palette->id != VIDEO_PALETTE_NONE;
+
+    for (uint16_t row = 0; row < src->height; row++) {
+        const uint8_t* in = video_image_row(src, row);
+        uint8_t* out = video_image_row(dst, row);
+
+        if (dst->format == VIDEO_PIXEL_RGB565) {
+            if (palette) {
+                video_fused_uyvy_palette_rgb565(ctx, in, (uint16_t*)out, src->width);
+            } else {
+                video_fused_uyvy_tone_rgb565(ctx, in, (uint16_t*)out, src->width);
+            }
+        } else if (dst->format == VIDEO_PIXEL_RGB888) {
+            if (palette) {
+                uyvy_palette_rgb888(ctx, in, out, src->width);
+            } else {
+                video_fused_uyvy_tone_rgb888(ctx, in, out, src->width);
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+static uint32_t bench_checksum(const uint8_t* data, size_t length) {
+    uint32_t sum = 0;
+    for (size_t i = 0; i < length; i++) {
+        sum = (sum << 1 | sum >> 31) ^ data[i];
+    }
+    return sum;
+}
+
+void video_fused_run_benchmark(uint16_t frames) {
+    const uint16_t width = 720;
+    const uint16_t height = 576;
+    const size_t uyvy_bytes = (size_t)width * height * 2;
+    const size_t rgb565_bytes = (size_t)width * height * 2;
+
+    if (frames == 0) frames = 1;
+
+    uint8_t* source = (uint8_t*)malloc(uyvy_bytes);
+    uint8_t* work = (uint8_t*)malloc(uyvy_bytes);
+    uint8_t* out = (uint8_t*)malloc(rgb565_bytes);
+    video_palette_t* palette = (video_palette_t*)malloc(sizeof(video_palette_t));
+    if (!source || !work || !out || !palette) {
+        Serial.println("ERROR: Failed to allocate benchmark buffers");
+        if (source) free(source);
+        if (work) free(work);
+        if (out) free(out);
+        if (palette) free(palette);
+        return;
+    }
+
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < uyvy_bytes; i++) {
+        seed = seed * 1103515245 + 12345;
+        source[i] = (i & 1) ? 16 + (seed >> 16) % 220 : 96 + (seed >> 16) % 64;
+    }
+
+    video_tone_t tone;
+    video_tone_params_t params = VIDEO_TONE_DEFAULT_PARAMS;
+    params.contrast = 160;
+    params.saturation = 150;
+    params.gamma = 8;
+    video_tone_init(&tone, &params);
+    video_palette_init(palette, VIDEO_PALETTE_IRONBOW);
+
+    video_fused_context_t ctx = { video_tone_acquire(&tone), nullptr };
+    video_image_t src = video_image_make(source, width, height, VIDEO_PIXEL_UYVY);
+    video_image_t tmp = video_image_make(work, width, height, VIDEO_PIXEL_UYVY);
+    video_image_t dst = video_image_make(out, width, height, VIDEO_PIXEL_RGB565);
+
+    Serial.println("=== Fused Kernel Benchmark ===");
+    Serial.printf("%dx%d UYVY to RGB565, %d frames per chain\n", width, height, frames);
+
+    for (int chain = 0; chain < 2; chain++) {
+        const char* name = chain == 0 ? "UYVY -> luma LUT -> palette -> RGB565" :
+                                        "UYVY -> tone -> RGB -> RGB565";
+        ctx.palette = chain == 0 ? video_palette_acquire(palette) : nullptr;
+
+        // Separate passes: tone curve in place, then the conversion
+        memcpy(work, source, uyvy_bytes);
+        video_tone_apply_image(&tone, &tmp);
+        if (chain == 0) {
+            video_palette_map_image(ctx.palette, &tmp, &dst);
+        } else {
+            video_image_convert(&tmp, &dst);
+        }
+        uint32_t reference = bench_checksum(out, rgb565_bytes);
+
+        uint32_t start = micros();
+        for (uint16_t f = 0; f < frames; f++) {
+            video_tone_apply_image(&tone, &tmp);
+            if (chain == 0) {
+                video_palette_map_image(ctx.palette, &tmp, &dst);
+            } else {
+                video_image_convert(&tmp, &dst);
+            }
+        }
+        uint32_t separate_us = (micros() - start) / frames;
+
+        memset(out, 0, rgb565_bytes);
+        start = micros();
+        for (uint16_t f = 0; f < frames; f++) {
+            video_fused_image(&ctx, &src, &dst);
+        }
+        uint32_t fused_us = (micros() - start) / frames;
+        uint32_t checksum = bench_checksum(out, rgb565_bytes);
+
+        Serial.println(name);
+        Serial.printf("  Separate: %lu us per frame\n", separate_us);
+        Serial.printf("  Fused:    %lu us per frame, %.2fx, output %s\n", fused_us,
+                      fused_us ? (float)separate_us / fused_us : 0.0f,
+                      checksum == reference ? "identical" : "DIFFERS");
+        video_palette_release(palette, ctx.palette);
+    }
+    Serial.println("==============================");
+
+    video_tone_release(&tone, ctx.tone);
+    free(palette);
+    free(out);
+    free(work);
+    free(source);
+}
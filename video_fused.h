@@ -0,0 +1,193 @@
+#ifndef VIDEO_FUSED_H
+#define VIDEO_FUSED_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "video_tone.h"
+#include "video_palette.h"
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Working state of one 4:2:2 pixel pair as it passes through a fused chain
+// Each operation reads the fields the previous ones filled in. Fields a chain
+// never reads are removed by the compiler.
+typedef struct {
+    uint8_t y[2];                  // Luma of the left and right pixel
+    uint8_t cb;                    // Shared chroma
+    uint8_t cr;
+    uint8_t rgb[2][3];             // R, G, B per pixel
+    uint16_t rgb565[2];            // Packed output per pixel
+} video_fused_pair_t;
+
+// Tables the operations read (only those a chain uses need to be set)
+typedef struct {
+    const video_tone_table_t* tone;
+    const video_palette_table_t* palette;
+} video_fused_context_t;
+
+// ============================================================================
+// Fused Operations
+// ============================================================================
+
+// Every source, operation and sink is a struct with one static inline
+// function. A chain is a list of them as template arguments; the compiler
+// inlines the list into a single loop over the line, so the intermediate
+// values stay in registers instead of making a pass through memory each.
+
+#define VIDEO_FUSED_INLINE static inline __attribute__((always_inline))
+
+// Sources
+struct video_fused_read_uyvy {
+    VIDEO_FUSED_INLINE void read(const uint8_t* in, video_fused_pair_t* p) {
+        p->cb = in[0]; p->y[0] = in[1]; p->cr = in[2]; p->y[1] = in[3];
+    }
+    static const uint8_t in_bytes = 4;
+};
+
+struct video_fused_read_yuyv {
+    VIDEO_FUSED_INLINE void read(const uint8_t* in, video_fused_pair_t* p) {
+        p->y[0] = in[0]; p->cb = in[1]; p->y[1] = in[2]; p->cr = in[3];
+    }
+    static const uint8_t in_bytes = 4;
+};
+
+// Operations
+struct video_fused_luma_lut {      // Tone curve on luma only
+    VIDEO_FUSED_INLINE void apply(const video_fused_context_t* ctx, video_fused_pair_t* p) {
+        p->y[0] = ctx->tone->luma_lut[p->y[0]];
+        p->y[1] = ctx->tone->luma_lut[p->y[1]];
+    }
+};
+
+struct video_fused_tone {          // Tone curve on luma and chroma
+    VIDEO_FUSED_INLINE void apply(const video_fused_context_t* ctx, video_fused_pair_t* p) {
+        p->y[0] = ctx->tone->luma_lut[p->y[0]];
+        p->y[1] = ctx->tone->luma_lut[p->y[1]];
+        p->cb = ctx->tone->chroma_lut[p->cb];
+        p->cr = ctx->tone->chroma_lut[p->cr];
+    }
+};
+
+struct video_fused_palette {       // Luma to palette colour (fills rgb565)
+    VIDEO_FUSED_INLINE void apply(const video_fused_context_t* ctx, video_fused_pair_t* p) {
+        p->rgb565[0] = ctx->palette->rgb565[p->y[0]];
+        p->rgb565[1] = ctx->palette->rgb565[p->y[1]];
+    }
+};
+
+struct video_fused_palette_rgb {   // Luma to palette colour (fills rgb)
+    VIDEO_FUSED_INLINE void apply(const video_fused_context_t* ctx, video_fused_pair_t* p) {
+        for (int i = 0; i < 2; i++) {
+            const uint8_t* c = ctx->palette->rgb888[p->y[i]];
+            p->rgb[i][0] = c[0]; p->rgb[i][1] = c[1]; p->rgb[i][2] = c[2];
+        }
+    }
+};
+
+struct video_fused_ycbcr_to_rgb {  // BT.601 in 8.8 fixed point (same as video_image_convert)
+    VIDEO_FUSED_INLINE uint8_t clamp(int value) {
+        return (value < 0) ? 0 : (value > 255) ? 255 : value;
+    }
+    VIDEO_FUSED_INLINE void apply(const video_fused_context_t* ctx, video_fused_pair_t* p) {
+        (void)ctx;
+        int cb = p->cb - 128;
+        int cr = p->cr - 128;
+        int r = 359 * cr;
+        int g = -88 * cb - 183 * cr;
+        int b = 454 * cb;
+        for (int i = 0; i < 2; i++) {
+            int l = (p->y[i] - 16) << 8;
+            p->rgb[i][0] = clamp((l + r) >> 8);
+            p->rgb[i][1] = clamp((l + g) >> 8);
+            p->rgb[i][2] = clamp((l + b) >> 8);
+        }
+    }
+};
+
+struct video_fused_pack_rgb565 {   // rgb to rgb565
+    VIDEO_FUSED_INLINE void apply(const video_fused_context_t* ctx, video_fused_pair_t* p) {
+        (void)ctx;
+        for (int i = 0; i < 2; i++) {
+            p->rgb565[i] = ((p->rgb[i][0] & 0xF8) << 8) | ((p->rgb[i][1] & 0xFC) << 3) | (p->rgb[i][2] >> 3);
+        }
+    }
+};
+
+// Sinks
+struct video_fused_write_rgb565 {
+    VIDEO_FUSED_INLINE void write(uint8_t* out, const video_fused_pair_t* p) {
+        uint16_t* o = (uint16_t*)out;
+        o[0] = p->rgb565[0]; o[1] = p->rgb565[1];
+    }
+    static const uint8_t out_bytes = 4;
+};
+
+struct video_fused_write_rgb888 {
+    VIDEO_FUSED_INLINE void write(uint8_t* out, const video_fused_pair_t* p) {
+        out[0] = p->rgb[0][0]; out[1] = p->rgb[0][1]; out[2] = p->rgb[0][2];
+        out[3] = p->rgb[1][0]; out[4] = p->rgb[1][1]; out[5] = p->rgb[1][2];
+    }
+    static const uint8_t out_bytes = 6;
+};
+
+struct video_fused_write_uyvy {
+    VIDEO_FUSED_INLINE void write(uint8_t* out, const video_fused_pair_t* p) {
+        out[0] = p->cb; out[1] = p->y[0]; out[2] = p->cr; out[3] = p->y[1];
+    }
+    static const uint8_t out_bytes = 4;
+};
+
+// Operation list, applied first to last
+template <typename... Ops>
+struct video_fused_ops;
+
+template <>
+struct video_fused_ops<> {
+    VIDEO_FUSED_INLINE void apply(const video_fused_context_t*, video_fused_pair_t*) {}
+};
+
+template <typename Op, typename... Rest>
+struct video_fused_ops<Op, Rest...> {
+    VIDEO_FUSED_INLINE void apply(const video_fused_context_t* ctx, video_fused_pair_t* p) {
+        Op::apply(ctx, p);
+        video_fused_ops<Rest...>::apply(ctx, p);
+    }
+};
+
+// One line through the whole chain (width is rounded down to whole pairs)
+template <typename Source, typename Sink, typename... Ops>
+static inline void video_fused_line(const video_fused_context_t* ctx, const uint8_t* in,
+                                    uint8_t* out, uint16_t width) {
+    // A local copy, so stores to the output cannot force the tables to be reloaded
+    const video_fused_context_t tables = *ctx;
+    for (uint16_t i = 0; i < width / 2; i++, in += Source::in_bytes, out += Sink::out_bytes) {
+        video_fused_pair_t p;
+        Source::read(in, &p);
+        video_fused_ops<Ops...>::apply(&tables, &p);
+        Sink::write(out, &p);
+    }
+}
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Pre-instantiated chains, one line at a time
+void video_fused_uyvy_palette_rgb565(const video_fused_context_t* ctx, const uint8_t* uyvy,
+                                     uint16_t* rgb565, uint16_t width);   // Luma LUT, palette
+void video_fused_uyvy_tone_rgb565(const video_fused_context_t* ctx, const uint8_t* uyvy,
+                                  uint16_t* rgb565, uint16_t width);      // Tone, RGB, pack
+void video_fused_uyvy_tone_rgb888(const video_fused_context_t* ctx, const uint8_t* uyvy,
+                                  uint8_t* rgb888, uint16_t width);       // Tone, RGB
+
+// Whole frame through a pre-instantiated chain chosen by the output format
+// (a palette other than VIDEO_PALETTE_NONE replaces true colour, as in frame conversion)
+bool video_fused_image(const video_fused_context_t* ctx, const video_image_t* src, const video_image_t* dst);
+
+// Benchmark against the separate passes
+void video_fused_run_benchmark(uint16_t frames);
+
+#endif // VIDEO_FUSED_H
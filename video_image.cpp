@@ -0,0 +1,260 @@
+#include "video_image.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+// Bytes per pixel for each VIDEO_PIXEL_* (4:2:2 formats average two)
+static const uint8_t PIXEL_BPP[VIDEO_PIXEL_COUNT] = { 3, 3, 2, 1, 2, 2 };
+
+static inline uint8_t clamp_u8(int value) {
+    return (value < 0) ? 0 : (value > 255) ? 255 : value;
+}
+
+// BT.601 YCbCr to RGB in 8.8 fixed point (same coefficients as bt656_ycbcr_to_rgb)
+static inline void ycbcr_to_rgb_fixed(uint8_t y, int cb, int cr, uint8_t* rgb) {
+    int l = (y - 16) << 8;
+    rgb[0] = clamp_u8((l + 359 * cr) >> 8);
+    rgb[1] = clamp_u8((l - 88 * cb - 183 * cr) >> 8);
+    rgb[2] = clamp_u8((l + 454 * cb) >> 8);
+}
+
+static inline uint16_t pack_rgb565(const uint8_t* rgb) {
+    return ((rgb[0] & 0xF8) << 8) | ((rgb[1] & 0xFC) << 3) | (rgb[2] >> 3);
+}
+
+// Byte offsets of Y0, Cb, Y1, Cr within a 4:2:2 pixel pair
+typedef struct {
+    uint8_t y0, cb, y1, cr;
+} pair_layout_t;
+
+static const pair_layout_t UYVY_LAYOUT = { 1, 0, 3, 2 };
+static const pair_layout_t YUYV_LAYOUT = { 0, 1, 2, 3 };
+
+// Convert one row of 4:2:2 pixel pairs into `format`
+static void IRAM_ATTR convert_row_422(const uint8_t* src, const pair_layout_t* in,
+                                      uint8_t* out, uint8_t format, uint16_t width) {
+    uint16_t pairs = width / 2;
+
+    switch (format) {
+        case VIDEO_PIXEL_YCBCR:
+            for (uint16_t i = 0; i < pairs; i++, src += 4, out += 6) {
+                out[0] = src[in->y0]; out[1] = src[in->cb]; out[2] = src[in->cr];
+                out[3] = src[in->y1]; out[4] = src[in->cb]; out[5] = src[in->cr];
+            }
+            break;
+
+        case VIDEO_PIXEL_RGB888:
+            for (uint16_t i = 0; i < pairs; i++, src += 4, out += 6) {
+                ycbcr_to_rgb_fixed(src[in->y0], src[in->cb] - 128, src[in->cr] - 128, out);
+                ycbcr_to_rgb_fixed(src[in->y1], src[in->cb] - 128, src[in->cr] - 128, out + 3);
+            }
+            break;
+
+        case VIDEO_PIXEL_RGB565: {
+            uint16_t* rgb565 = (uint16_t*)out;
+            uint8_t rgb[6];
+            for (uint16_t i = 0; i < pairs; i++, src += 4, rgb565 += 2) {
+                ycbcr_to_rgb_fixed(src[in->y0], src[in->cb] - 128, src[in->cr] - 128, rgb);
+                ycbcr_to_rgb_fixed(src[in->y1], src[in->cb] - 128, src[in->cr] - 128, rgb + 3);
+                rgb565[0] = pack_rgb565(rgb);
+                rgb565[1] = pack_rgb565(rgb + 3);
+            }
+            break;
+        }
+
+        case VIDEO_PIXEL_GRAY:
+            for (uint16_t i = 0; i < pairs; i++, src += 4, out += 2) {
+                out[0] = src[in->y0];
+                out[1] = src[in->y1];
+            }
+            break;
+
+        case VIDEO_PIXEL_UYVY:
+        case VIDEO_PIXEL_YUYV: {
+            const pair_layout_t* o = (format == VIDEO_PIXEL_UYVY) ? &UYVY_LAYOUT : &YUYV_LAYOUT;
+            for (uint16_t i = 0; i < pairs; i++, src += 4, out += 4) {
+                out[o->y0] = src[in->y0]; out[o->cb] = src[in->cb];
+                out[o->y1] = src[in->y1]; out[o->cr] = src[in->cr];
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+// Grey rows expand to any colour format with neutral chroma
+static void IRAM_ATTR convert_row_gray(const uint8_t* src, uint8_t* out, uint8_t format, uint16_t width) {
+    switch (format) {
+        case VIDEO_PIXEL_YCBCR:
+            for (uint16_t x = 0; x < width; x++, out += 3) {
+                out[0] = src[x]; out[1] = 128; out[2] = 128;
+            }
+            break;
+
+        case VIDEO_PIXEL_RGB888:
+            for (uint16_t x = 0; x < width; x++, out += 3) {
+                ycbcr_to_rgb_fixed(src[x], 0, 0, out);
+            }
+            break;
+
+        case VIDEO_PIXEL_RGB565: {
+            uint16_t* rgb565 = (uint16_t*)out;
+            uint8_t rgb[3];
+            for (uint16_t x = 0; x < width; x++) {
+                ycbcr_to_rgb_fixed(src[x], 0, 0, rgb);
+                rgb565[x] = pack_rgb565(rgb);
+            }
+            break;
+        }
+
+        case VIDEO_PIXEL_UYVY:
+        case VIDEO_PIXEL_YUYV: {
+            const pair_layout_t* o = (format == VIDEO_PIXEL_UYVY) ? &UYVY_LAYOUT : &YUYV_LAYOUT;
+            for (uint16_t x = 0; x + 1 < width; x += 2, out += 4) {
+                out[o->y0] = src[x]; out[o->y1] = src[x + 1];
+                out[o->cb] = 128; out[o->cr] = 128;
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+// ============================================================================
+// View Construction
+// ============================================================================
+
+video_image_t video_image_make(uint8_t* data, uint16_t width, uint16_t height, uint8_t format) {
+    return video_image_make_strided(data, width, height,
+                                    (uint32_t)width * video_image_bytes_per_pixel(format), format);
+}
+
+video_image_t video_image_make_strided(uint8_t* data, uint16_t width, uint16_t height,
+                                       uint32_t stride, uint8_t format) {
+    video_image_t image;
+    image.data = data;
+    image.width = width;
+    image.height = height;
+    image.stride = stride;
+    image.format = format;
+    return image;
+}
+
+bool video_image_is_valid(const video_image_t* image) {
+    return image && image->data && image->width > 0 && image->height > 0 &&
+           image->format < VIDEO_PIXEL_COUNT && image->stride >= video_image_row_bytes(image);
+}
+
+uint8_t video_image_bytes_per_pixel(uint8_t format) {
+    return (format < VIDEO_PIXEL_COUNT) ? PIXEL_BPP[format] : 0;
+}
+
+bool video_image_is_422(uint8_t format) {
+    return format == VIDEO_PIXEL_UYVY || format == VIDEO_PIXEL_YUYV;
+}
+
+// ============================================================================
+// Zero-Copy Slices
+// ============================================================================
+
+// Sub-rectangle clipped to the source. 4:2:2 crops start on an even pixel and
+// keep an even width so chroma pairs are never split.
+video_image_t video_image_crop(const video_image_t* image, uint16_t x, uint16_t y,
+                               uint16_t width, uint16_t height) {
+    video_image_t crop = video_image_make_strided(nullptr, 0, 0, 0, VIDEO_PIXEL_GRAY);
+    if (!video_image_is_valid(image) || x >= image->width || y >= image->height) {
+        return crop;
+    }
+
+    if (video_image_is_422(image->format)) {
+        x &= ~1;
+    }
+    if (width > image->width - x) width = image->width - x;
+    if (height > image->height - y) height = image->height - y;
+    if (video_image_is_422(image->format)) {
+        width &= ~1;
+    }
+
+    crop = *image;
+    crop.data = video_image_row(image, y) + (uint32_t)x * video_image_bytes_per_pixel(image->format);
+    crop.width = width;
+    crop.height = height;
+    return crop;
+}
+
+video_image_t video_image_rows(const video_image_t* image, uint16_t first_row, uint16_t row_count) {
+    return video_image_crop(image, 0, first_row, image ? image->width : 0, row_count);
+}
+
+// One field of a woven frame (field 0 = even rows, 1 = odd rows)
+video_image_t video_image_field(const video_image_t* image, uint8_t field) {
+    video_image_t view = video_image_make_strided(nullptr, 0, 0, 0, VIDEO_PIXEL_GRAY);
+    if (!video_image_is_valid(image) || field > 1 || image->height <= field) {
+        return view;
+    }
+
+    view = *image;
+    view.data = video_image_row(image, field);
+    view.height = (image->height - field + 1) / 2;
+    view.stride = image->stride * 2;
+    return view;
+}
+
+// ============================================================================
+// Kernels
+// ============================================================================
+
+// Copy pixels between views of the same format and size
+bool video_image_copy(const video_image_t* src, const video_image_t* dst) {
+    if (!video_image_is_valid(src) || !video_image_is_valid(dst) || src->format != dst->format ||
+        src->width != dst->width || src->height != dst->height) {
+        return false;
+    }
+
+    uint32_t row_bytes = video_image_row_bytes(src);
+    if (src->stride == row_bytes && dst->stride == row_bytes) {
+        memcpy(dst->data, src->data, row_bytes * src->height);
+        return true;
+    }
+
+    for (uint16_t row = 0; row < src->height; row++) {
+        memcpy(video_image_row(dst, row), video_image_row(src, row), row_bytes);
+    }
+    return true;
+}
+
+// Convert between formats. Sources may be UYVY, YUYV or grey; any format is
+// accepted as a destination. Views must have the same dimensions.
+bool video_image_convert(const video_image_t* src, const video_image_t* dst) {
+    if (!video_image_is_valid(src) || !video_image_is_valid(dst) ||
+        src->width != dst->width || src->height != dst->height) {
+        return false;
+    }
+
+    if (src->format == dst->format) {
+        return video_image_copy(src, dst);
+    }
+
+    if (video_image_is_422(src->format)) {
+        const pair_layout_t* in = (src->format == VIDEO_PIXEL_UYVY) ? &UYVY_LAYOUT : &YUYV_LAYOUT;
+        for (uint16_t row = 0; row < src->height; row++) {
+            convert_row_422(video_image_row(src, row), in, video_image_row(dst, row), dst->format, src->width);
+        }
+        return true;
+    }
+
+    if (src->format == VIDEO_PIXEL_GRAY) {
+        for (uint16_t row = 0; row < src->height; row++) {
+            convert_row_gray(video_image_row(src, row), video_image_row(dst, row), dst->format, src->width);
+        }
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,68 @@
+#ifndef VIDEO_IMAGE_H
+#define VIDEO_IMAGE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// ============================================================================
+// Pixel Formats
+// ============================================================================
+
+// Values 0-4 match FRAME_FORMAT_* so frame buffer formats can be used directly
+#define VIDEO_PIXEL_YCBCR          0         // Y Cb Cr, 3 bytes per pixel
+#define VIDEO_PIXEL_RGB888         1         // R G B, 3 bytes per pixel
+#define VIDEO_PIXEL_RGB565         2         // 16-bit RGB, native endian
+#define VIDEO_PIXEL_GRAY           3         // 8-bit luma
+#define VIDEO_PIXEL_UYVY           4         // Cb Y0 Cr Y1 (BT.656 order)
+#define VIDEO_PIXEL_YUYV           5         // Y0 Cb Y1 Cr (TVP5150 parallel order)
+#define VIDEO_PIXEL_COUNT          6
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Non-owning view of a 2D image
+// Rows are `stride` bytes apart, so a view can describe a crop, a single field
+// or any sub-rectangle of a larger frame without copying it.
+typedef struct {
+    uint8_t* data;                 // First pixel of the first row (not owned)
+    uint16_t width;                // Pixels per row
+    uint16_t height;               // Rows
+    uint32_t stride;               // Bytes from one row to the next
+    uint8_t format;                // VIDEO_PIXEL_*
+} video_image_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// View construction
+video_image_t video_image_make(uint8_t* data, uint16_t width, uint16_t height, uint8_t format);
+video_image_t video_image_make_strided(uint8_t* data, uint16_t width, uint16_t height,
+                                       uint32_t stride, uint8_t format);
+bool video_image_is_valid(const video_image_t* image);
+uint8_t video_image_bytes_per_pixel(uint8_t format);
+bool video_image_is_422(uint8_t format);
+
+// Zero-copy slices (the result shares the source's memory)
+video_image_t video_image_crop(const video_image_t* image, uint16_t x, uint16_t y,
+                               uint16_t width, uint16_t height);
+video_image_t video_image_rows(const video_image_t* image, uint16_t first_row, uint16_t row_count);
+video_image_t video_image_field(const video_image_t* image, uint8_t field);
+
+// Kernels
+bool video_image_copy(const video_image_t* src, const video_image_t* dst);
+bool video_image_convert(const video_image_t* src, const video_image_t* dst);
+
+// Row access
+static inline uint8_t* video_image_row(const video_image_t* image, uint16_t row) {
+    return image->data + (uint32_t)row * image->stride;
+}
+
+// Bytes of pixel data in one row (excluding any stride padding)
+static inline uint32_t video_image_row_bytes(const video_image_t* image) {
+    return (uint32_t)image->width * video_image_bytes_per_pixel(image->format);
+}
+
+#endif // VIDEO_IMAGE_H
@@ -0,0 +1,255 @@
+#include "video_palette.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+// Iron-bow control points: luma, R, G, B
+static const uint8_t IRONBOW_POINTS[][4] = {
+    {   0,   0,   0,   0 },
+    {  40,  20,   0,  90 },
+    {  90, 120,   0, 150 },
+    { 140, 200,  40, 100 },
+    { 190, 250, 130,  20 },
+    { 230, 255, 210,  60 },
+    { 255, 255, 255, 230 }
+};
+
+// Piecewise-linear interpolation through the iron-bow control points
+static void ironbow_color(uint8_t v, uint8_t* rgb) {
+    const int count = sizeof(IRONBOW_POINTS) / sizeof(IRONBOW_POINTS[0]);
+    for (int i = 1; i < count; i++) {
+        const uint8_t* lo = IRONBOW_POINTS[i - 1];
+        const uint8_t* hi = IRONBOW_POINTS[i];
+        if (v <= hi[0]) {
+            int span = hi[0] - lo[0];
+            int t = v - lo[0];
+            for (int c = 0; c < 3; c++) {
+                rgb[c] = lo[c + 1] + ((hi[c + 1] - lo[c + 1]) * t) / span;
+            }
+            return;
+        }
+    }
+}
+
+// Colour for one luma value
+static void palette_color(video_palette_id_t id, uint8_t v, uint8_t* rgb) {
+    switch (id) {
+        case VIDEO_PALETTE_GREEN_P43:
+            // P43 phosphor peaks at ~545 nm: mostly green with a little red
+            rgb[0] = (v * 90) >> 8;
+            rgb[1] = v;
+            rgb[2] = (v * 40) >> 8;
+            break;
+
+        case VIDEO_PALETTE_BLACK_HOT:
+            rgb[0] = rgb[1] = rgb[2] = 255 - v;
+            break;
+
+        case VIDEO_PALETTE_IRONBOW:
+            ironbow_color(v, rgb);
+            break;
+
+        case VIDEO_PALETTE_AMBER:
+            rgb[0] = v;
+            rgb[1] = (v * 176) >> 8;
+            rgb[2] = 0;
+            break;
+
+        case VIDEO_PALETTE_WHITE_HOT:
+        case VIDEO_PALETTE_NONE:
+        default:
+            rgb[0] = rgb[1] = rgb[2] = v;
+            break;
+    }
+}
+
+static void build_table(video_palette_table_t* table, video_palette_id_t id) {
+    for (int v = 0; v < 256; v++) {
+        uint8_t* rgb = table->rgb888[v];
+        palette_color(id, v, rgb);
+        table->rgb565[v] = ((rgb[0] & 0xF8) << 8) | ((rgb[1] & 0xFC) << 3) | (rgb[2] >> 3);
+    }
+    table->id = id;
+}
+
+// ============================================================================
+// Core Palette Functions
+// ============================================================================
+
+void video_palette_init(video_palette_t* palette, video_palette_id_t id) {
+    if (!palette) return;
+
+    memset(palette, 0, sizeof(video_palette_t));
+    build_table(&palette->tables[0], id);
+    palette->pending = id;
+    palette->active = 0;
+}
+
+bool video_palette_select(video_palette_t* palette, video_palette_id_t id) {
+    if (!palette || id >= VIDEO_PALETTE_COUNT) return false;
+
+    __atomic_store_n(&palette->pending, (uint8_t)id, __ATOMIC_SEQ_CST);
+    return video_palette_update(palette);
+}
+
+// Build the pending palette into the idle table and publish it, unless a
+// consumer still holds that table or another thread is building
+bool video_palette_update(video_palette_t* palette) {
+    if (!palette) return false;
+
+    uint8_t idle = 0;
+    if (!__atomic_compare_exchange_n(&palette->building, &idle, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        return false;
+    }
+
+    bool published = false;
+    while (true) {
+        uint8_t current = __atomic_load_n(&palette->active, __ATOMIC_ACQUIRE);
+        video_palette_id_t id = (video_palette_id_t)__atomic_load_n(&palette->pending, __ATOMIC_SEQ_CST);
+        if (palette->tables[current].id == id) break;
+
+        uint8_t next = current ^ 1;
+        if (__atomic_load_n(&palette->readers[next], __ATOMIC_SEQ_CST) != 0) break;
+
+        // Build into the idle table, then publish it in one store
+        build_table(&palette->tables[next], id);
+        __atomic_store_n(&palette->active, next, __ATOMIC_SEQ_CST);
+        published = true;
+    }
+
+    __atomic_store_n(&palette->building, 0, __ATOMIC_RELEASE);
+    return published;
+}
+
+video_palette_id_t video_palette_get_selected(video_palette_t* palette) {
+    if (!palette) return VIDEO_PALETTE_NONE;
+    return (video_palette_id_t)__atomic_load_n(&palette->pending, __ATOMIC_ACQUIRE);
+}
+
+// Count this consumer on the live table, retrying if a swap slipped in
+// between reading the index and counting (see video_tone_acquire)
+const video_palette_table_t* video_palette_acquire(video_palette_t* palette) {
+    if (!palette) return nullptr;
+
+    while (true) {
+        uint8_t index = __atomic_load_n(&palette->active, __ATOMIC_ACQUIRE);
+        __atomic_add_fetch(&palette->readers[index], 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&palette->active, __ATOMIC_SEQ_CST) == index) {
+            return &palette->tables[index];
+        }
+        __atomic_sub_fetch(&palette->readers[index], 1, __ATOMIC_RELEASE);
+    }
+}
+
+void video_palette_release(video_palette_t* palette, const video_palette_table_t* table) {
+    if (!palette || !table) return;
+    __atomic_sub_fetch(&palette->readers[table - palette->tables], 1, __ATOMIC_RELEASE);
+}
+
+// ============================================================================
+// Per-Line Mapping
+// ============================================================================
+
+// Each UYVY word (Cb Y0 Cr Y1) yields two RGB565 pixels written as one 32-bit store
+void IRAM_ATTR video_palette_map_uyvy_rgb565(const video_palette_table_t* table, const uint8_t* uyvy,
+                                             uint16_t* rgb565, uint16_t width) {
+    if (!table || !uyvy || !rgb565) return;
+
+    const uint16_t* lut = table->rgb565;
+    uint32_t words = width / 2;
+
+    for (uint32_t i = 0; i < words; i++) {
+        uint32_t w;
+        memcpy(&w, uyvy + i * 4, 4);
+        uint32_t out = (uint32_t)lut[(w >> 8) & 0xFF] | ((uint32_t)lut[w >> 24] << 16);
+        memcpy(rgb565 + i * 2, &out, 4);
+    }
+
+    if (width & 1) {
+        rgb565[width - 1] = lut[uyvy[(width - 1) * 2 + 1]];
+    }
+}
+
+void IRAM_ATTR video_palette_map_uyvy_rgb888(const video_palette_table_t* table, const uint8_t* uyvy,
+                                             uint8_t* rgb888, uint16_t width) {
+    if (!table || !uyvy || !rgb888) return;
+
+    for (uint16_t x = 0; x < width; x++) {
+        const uint8_t* rgb = table->rgb888[uyvy[x * 2 + 1]];
+        rgb888[0] = rgb[0];
+        rgb888[1] = rgb[1];
+        rgb888[2] = rgb[2];
+        rgb888 += 3;
+    }
+}
+
+void IRAM_ATTR video_palette_map_luma_rgb565(const video_palette_table_t* table, const uint8_t* luma,
+                                             uint16_t* rgb565, size_t count) {
+    if (!table || !luma || !rgb565) return;
+
+    const uint16_t* lut = table->rgb565;
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        uint32_t w;
+        memcpy(&w, luma + i, 4);
+        uint32_t lo = (uint32_t)lut[w & 0xFF] | ((uint32_t)lut[(w >> 8) & 0xFF] << 16);
+        uint32_t hi = (uint32_t)lut[(w >> 16) & 0xFF] | ((uint32_t)lut[w >> 24] << 16);
+        memcpy(rgb565 + i, &lo, 4);
+        memcpy(rgb565 + i + 2, &hi, 4);
+    }
+
+    for (; i < count; i++) {
+        rgb565[i] = lut[luma[i]];
+    }
+}
+
+// Map a UYVY or grey view into an RGB565 or RGB888 view of the same size
+bool video_palette_map_image(const video_palette_table_t* table, const video_image_t* src, const video_image_t* dst) {
+    if (!table || !video_image_is_valid(src) || !video_image_is_valid(dst) ||
+        src->width != dst->width || src->height != dst->height) {
+        return false;
+    }
+    if ((src->format != VIDEO_PIXEL_UYVY && src->format != VIDEO_PIXEL_GRAY) ||
+        (dst->format != VIDEO_PIXEL_RGB565 && dst->format != VIDEO_PIXEL_RGB888)) {
+        return false;
+    }
+
+    for (uint16_t row = 0; row < src->height; row++) {
+        const uint8_t* in = video_image_row(src, row);
+        uint8_t* out = video_image_row(dst, row);
+
+        if (src->format == VIDEO_PIXEL_UYVY) {
+            if (dst->format == VIDEO_PIXEL_RGB565) {
+                video_palette_map_uyvy_rgb565(table, in, (uint16_t*)out, src->width);
+            } else {
+                video_palette_map_uyvy_rgb888(table, in, out, src->width);
+            }
+        } else if (dst->format == VIDEO_PIXEL_RGB565) {
+            video_palette_map_luma_rgb565(table, in, (uint16_t*)out, src->width);
+        } else {
+            for (uint16_t x = 0; x < src->width; x++, out += 3) {
+                memcpy(out, table->rgb888[in[x]], 3);
+            }
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// Utility Functions
+// ============================================================================
+
+const char* video_palette_to_string(video_palette_id_t id) {
+    switch (id) {
+        case VIDEO_PALETTE_NONE: return "NONE";
+        case VIDEO_PALETTE_GREEN_P43: return "GREEN_P43";
+        case VIDEO_PALETTE_WHITE_HOT: return "WHITE_HOT";
+        case VIDEO_PALETTE_BLACK_HOT: return "BLACK_HOT";
+        case VIDEO_PALETTE_IRONBOW: return "IRONBOW";
+        case VIDEO_PALETTE_AMBER: return "AMBER";
+        default: return "UNKNOWN";
+    }
+}
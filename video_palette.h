@@ -0,0 +1,72 @@
+#ifndef VIDEO_PALETTE_H
+#define VIDEO_PALETTE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "video_image.h"
+
+// ============================================================================
+// Palette Configuration
+// ============================================================================
+
+// Available palettes
+typedef enum {
+    VIDEO_PALETTE_NONE,            // No mapping (true colour output)
+    VIDEO_PALETTE_GREEN_P43,       // Green phosphor (P43 image intensifier)
+    VIDEO_PALETTE_WHITE_HOT,       // Grey ramp, bright = hot
+    VIDEO_PALETTE_BLACK_HOT,       // Inverted grey ramp
+    VIDEO_PALETTE_IRONBOW,         // Black-blue-magenta-orange-yellow-white
+    VIDEO_PALETTE_AMBER,           // Amber monochrome
+    VIDEO_PALETTE_COUNT
+} video_palette_id_t;
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Precomputed luma-to-colour table
+typedef struct {
+    uint16_t rgb565[256];          // Luma to RGB565
+    uint8_t rgb888[256][3];        // Luma to R, G, B
+    video_palette_id_t id;         // Palette the table was built for
+} video_palette_table_t;
+
+// Palette stage with double-buffered tables
+// The active table is published with a single atomic store, so consumers
+// never wait on a swap; the new palette takes effect from the next line.
+// A selection is built only once no consumer holds the idle table, until
+// then it waits as pending for the next select or update call.
+typedef struct {
+    video_palette_table_t tables[2];
+    volatile uint8_t active;       // Index of the table consumers read
+    volatile uint32_t readers[2];  // Consumers holding each table
+    volatile uint8_t pending;      // Latest selected palette id
+    volatile uint8_t building;     // A rebuild is in progress (one builder at a time)
+} video_palette_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core palette functions. select and update return true when they publish a
+// new table; get_selected reports the latest selection, live or pending.
+void video_palette_init(video_palette_t* palette, video_palette_id_t id);
+bool video_palette_select(video_palette_t* palette, video_palette_id_t id);
+bool video_palette_update(video_palette_t* palette);
+video_palette_id_t video_palette_get_selected(video_palette_t* palette);
+
+// Hold the live table while mapping with it; every acquire needs a release
+const video_palette_table_t* video_palette_acquire(video_palette_t* palette);
+void video_palette_release(video_palette_t* palette, const video_palette_table_t* table);
+
+// Per-line mapping (luma taken from UYVY or a plain luma plane)
+void video_palette_map_uyvy_rgb565(const video_palette_table_t* table, const uint8_t* uyvy, uint16_t* rgb565, uint16_t width);
+void video_palette_map_uyvy_rgb888(const video_palette_table_t* table, const uint8_t* uyvy, uint8_t* rgb888, uint16_t width);
+void video_palette_map_luma_rgb565(const video_palette_table_t* table, const uint8_t* luma, uint16_t* rgb565, size_t count);
+bool video_palette_map_image(const video_palette_table_t* table, const video_image_t* src, const video_image_t* dst);
+
+// Utility functions
+const char* video_palette_to_string(video_palette_id_t id);
+
+#endif // VIDEO_PALETTE_H
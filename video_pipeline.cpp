@@ -0,0 +1,377 @@
+#include "video_pipeline.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+#define QUEUE_MASK (VIDEO_PIPELINE_QUEUE_SLOTS - 1)
+
+// Items waiting in the queue (either side may ask)
+static uint32_t queue_depth(video_pipeline_queue_t* queue) {
+    return __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE) - __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE);
+}
+
+// Producer side; the release store hands the item's contents over with it
+static bool queue_push(video_pipeline_queue_t* queue, video_pipeline_item_t* item) {
+    uint32_t tail = queue->tail;
+    if (tail - __atomic_load_n(&queue->head, __ATOMIC_ACQUIRE) >= VIDEO_PIPELINE_QUEUE_SLOTS) {
+        return false;
+    }
+    queue->slots[tail & QUEUE_MASK] = item;
+    __atomic_store_n(&queue->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+// Consumer side
+static video_pipeline_item_t* queue_pop(video_pipeline_queue_t* queue) {
+    uint32_t head = queue->head;
+    if (head == __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE)) {
+        return nullptr;
+    }
+    video_pipeline_item_t* item = queue->slots[head & QUEUE_MASK];
+    __atomic_store_n(&queue->head, head + 1, __ATOMIC_RELEASE);
+    return item;
+}
+
+static bool is_stopping(video_pipeline_t* pipeline) {
+    return __atomic_load_n(&pipeline->stopping, __ATOMIC_RELAXED);
+}
+
+// Wake the other side if it went to sleep on this queue. The fence orders the
+// push or pop before the waiters check; the sleeper orders its waiters increment
+// before its last look at the queue, so one of the two always sees the other.
+static void queue_wake(video_pipeline_queue_t* queue) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&queue->waiters, __ATOMIC_RELAXED)) {
+        pthread_mutex_lock(&queue->lock);
+        pthread_cond_broadcast(&queue->cond);
+        pthread_mutex_unlock(&queue->lock);
+    }
+}
+
+static void queue_sleep_begin(video_pipeline_queue_t* queue) {
+    pthread_mutex_lock(&queue->lock);
+    __atomic_add_fetch(&queue->waiters, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static void queue_sleep_end(video_pipeline_queue_t* queue) {
+    __atomic_sub_fetch(&queue->waiters, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&queue->lock);
+}
+
+// Queues are bounded, so a stage ahead of its successor waits here
+static bool push_wait(video_pipeline_stage_t* stage, video_pipeline_queue_t* queue, video_pipeline_item_t* item) {
+    item->queued_us = micros();
+    if (!queue_push(queue, item)) {
+        stage->stats.blocked++;
+        queue_sleep_begin(queue);
+        bool pushed;
+        while (!(pushed = queue_push(queue, item)) && !is_stopping(stage->pipeline)) {
+            pthread_cond_wait(&queue->cond, &queue->lock);
+        }
+        queue_sleep_end(queue);
+        if (!pushed) return false;
+    }
+    queue_wake(queue);
+    return true;
+}
+
+// `depth` receives the items that were waiting when the stage came for one
+static video_pipeline_item_t* pop_wait(video_pipeline_stage_t* stage, uint32_t* depth) {
+    video_pipeline_queue_t* queue = &stage->input;
+    *depth = queue_depth(queue);
+    video_pipeline_item_t* item = queue_pop(queue);
+    if (!item) {
+        stage->stats.starved++;
+        queue_sleep_begin(queue);
+        while (!(item = queue_pop(queue)) && !is_stopping(stage->pipeline)) {
+            pthread_cond_wait(&queue->cond, &queue->lock);
+        }
+        queue_sleep_end(queue);
+        if (!item) return nullptr;
+    }
+    queue_wake(queue);
+    return item;
+}
+
+static void* stage_main(void* arg) {
+    video_pipeline_stage_t* stage = (video_pipeline_stage_t*)arg;
+    video_pipeline_t* pipeline = stage->pipeline;
+    bool first = stage->index == 0;
+    bool last = stage->index == pipeline->stage_count - 1;
+    video_pipeline_queue_t* output = last ? &pipeline->stages[0].input : &pipeline->stages[stage->index + 1].input;
+
+    while (true) {
+        uint32_t depth;
+        video_pipeline_item_t* item = pop_wait(stage, &depth);
+        if (!item) return nullptr;
+        uint32_t popped_us = micros();
+
+        if (first) {
+            item->sequence = pipeline->sequence++;
+            item->start_us = popped_us;
+            item->queued_us = popped_us;
+            item->first_row = 0;
+            item->rows = 0;
+            item->length = 0;
+            item->dropped = false;
+            frame_buffer_reset(&item->frame);
+        }
+
+        if (!item->last) {
+            bool keep = item->dropped || stage->process(item);
+            uint32_t done_us = micros();
+
+            if (first && !keep) {
+                // End of input: the marker travels down the chain and stops each stage
+                item->last = true;
+            } else {
+                stage->stats.items++;
+                stage->stats.busy_us += done_us - popped_us;
+                stage->stats.occupancy_sum += depth;
+                if (depth > stage->stats.occupancy_high) {
+                    stage->stats.occupancy_high = depth;
+                }
+                uint32_t latency = done_us - item->queued_us;
+                stage->stats.latency_sum_us += latency;
+                if (latency > stage->stats.latency_max_us) {
+                    stage->stats.latency_max_us = latency;
+                }
+                if (!keep) {
+                    item->dropped = true;
+                    stage->stats.dropped++;
+                }
+            }
+
+            if (last && !item->last) {
+                uint32_t total = done_us - item->start_us;
+                pipeline->stats.items++;
+                pipeline->stats.dropped += item->dropped;
+                pipeline->stats.latency_sum_us += total;
+                if (total > pipeline->stats.latency_max_us) {
+                    pipeline->stats.latency_max_us = total;
+                }
+            }
+        }
+
+        if (item->last) {
+            if (last) {
+                uint32_t elapsed = micros() - pipeline->start_us;
+                __atomic_store_n(&pipeline->stats.elapsed_us, elapsed ? elapsed : 1, __ATOMIC_RELEASE);
+            } else {
+                push_wait(stage, output, item);
+            }
+            return nullptr;
+        }
+        if (!push_wait(stage, output, item)) return nullptr;
+    }
+}
+
+// ============================================================================
+// Core Pipeline Functions
+// ============================================================================
+
+bool video_pipeline_init(video_pipeline_t* pipeline, const video_pipeline_config_t* config) {
+    if (!pipeline || !config || config->items == 0 || config->items > VIDEO_PIPELINE_MAX_ITEMS ||
+        config->items > VIDEO_PIPELINE_QUEUE_SLOTS) {
+        Serial.println("ERROR: Invalid pipeline configuration");
+        return false;
+    }
+
+    memset(pipeline, 0, sizeof(video_pipeline_t));
+    pipeline->config = *config;
+
+    pipeline->items = (video_pipeline_item_t*)calloc(config->items, sizeof(video_pipeline_item_t));
+    if (!pipeline->items) {
+        Serial.println("ERROR: Failed to allocate pipeline items");
+        return false;
+    }
+
+    for (uint8_t i = 0; i < config->items; i++) {
+        video_pipeline_item_t* item = &pipeline->items[i];
+        bool ok = frame_buffer_init(&item->frame, config->width, config->height);
+        if (ok && config->raw_bytes) {
+            item->data = (uint8_t*)malloc(config->raw_bytes);
+            item->capacity = config->raw_bytes;
+            ok = item->data != nullptr;
+        }
+        if (!ok) {
+            Serial.println("ERROR: Failed to allocate pipeline item buffers");
+            video_pipeline_deinit(pipeline);
+            return false;
+        }
+    }
+
+    Serial.printf("Pipeline initialized: %d items of %dx%d, %lu raw bytes each\n",
+                  config->items, config->width, config->height, (uint32_t)config->raw_bytes);
+    return true;
+}
+
+void video_pipeline_deinit(video_pipeline_t* pipeline) {
+    if (!pipeline) return;
+
+    video_pipeline_wait(pipeline);
+    if (pipeline->items) {
+        for (uint8_t i = 0; i < pipeline->config.items; i++) {
+            if (pipeline->items[i].frame.uyvy_buffer) {
+                frame_buffer_deinit(&pipeline->items[i].frame);
+            }
+            free(pipeline->items[i].data);
+        }
+        free(pipeline->items);
+    }
+    memset(pipeline, 0, sizeof(video_pipeline_t));
+}
+
+// Stages run in the order they are added; the first one fills items (capture)
+// and the last one finishes with them (sink)
+bool video_pipeline_add_stage(video_pipeline_t* pipeline, const char* name, video_pipeline_stage_fn process) {
+    if (!pipeline || !process || pipeline->running) {
+        Serial.println("ERROR: Invalid pipeline stage");
+        return false;
+    }
+    if (pipeline->stage_count >= VIDEO_PIPELINE_MAX_STAGES) {
+        Serial.println("ERROR: Too many pipeline stages");
+        return false;
+    }
+
+    video_pipeline_stage_t* stage = &pipeline->stages[pipeline->stage_count];
+    memset(stage, 0, sizeof(video_pipeline_stage_t));
+    stage->name = name ? name : "stage";
+    stage->process = process;
+    stage->pipeline = pipeline;
+    stage->index = pipeline->stage_count++;
+    return true;
+}
+
+// ============================================================================
+// Run Control
+// ============================================================================
+
+static void destroy_queues(video_pipeline_t* pipeline) {
+    for (uint8_t s = 0; s < pipeline->stage_count; s++) {
+        pthread_mutex_destroy(&pipeline->stages[s].input.lock);
+        pthread_cond_destroy(&pipeline->stages[s].input.cond);
+    }
+}
+
+bool video_pipeline_start(video_pipeline_t* pipeline) {
+    if (!pipeline || !pipeline->items || pipeline->running || pipeline->stage_count == 0) {
+        return false;
+    }
+
+    memset(&pipeline->stats, 0, sizeof(video_pipeline_stats_t));
+    for (uint8_t s = 0; s < pipeline->stage_count; s++) {
+        video_pipeline_stage_t* stage = &pipeline->stages[s];
+        memset(&stage->input, 0, sizeof(video_pipeline_queue_t));
+        memset(&stage->stats, 0, sizeof(video_pipeline_stage_stats_t));
+        pthread_mutex_init(&stage->input.lock, nullptr);
+        pthread_cond_init(&stage->input.cond, nullptr);
+    }
+
+    // Every item starts out free, waiting for the first stage
+    for (uint8_t i = 0; i < pipeline->config.items; i++) {
+        pipeline->items[i].last = false;
+        queue_push(&pipeline->stages[0].input, &pipeline->items[i]);
+    }
+    pipeline->sequence = 0;
+    pipeline->start_us = micros();
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, VIDEO_PIPELINE_STACK_SIZE);
+
+    // A stage that fails to start would stall the chain, so start all or none
+    pipeline->stopping = false;
+    uint8_t started = 0;
+    for (uint8_t s = 0; s < pipeline->stage_count; s++) {
+        if (pthread_create(&pipeline->stages[s].thread, &attr, stage_main, &pipeline->stages[s]) != 0) {
+            break;
+        }
+        started++;
+    }
+    pthread_attr_destroy(&attr);
+
+    if (started < pipeline->stage_count) {
+        Serial.println("ERROR: Failed to start pipeline stage");
+        __atomic_store_n(&pipeline->stopping, true, __ATOMIC_RELAXED);
+        for (uint8_t s = 0; s < pipeline->stage_count; s++) {
+            video_pipeline_queue_t* queue = &pipeline->stages[s].input;
+            pthread_mutex_lock(&queue->lock);
+            pthread_cond_broadcast(&queue->cond);
+            pthread_mutex_unlock(&queue->lock);
+        }
+        for (uint8_t s = 0; s < started; s++) {
+            pthread_join(pipeline->stages[s].thread, nullptr);
+        }
+        destroy_queues(pipeline);
+        return false;
+    }
+
+    pipeline->running = true;
+    return true;
+}
+
+// False once the end of stream marker has passed the last stage
+bool video_pipeline_is_running(video_pipeline_t* pipeline) {
+    return pipeline && pipeline->running && __atomic_load_n(&pipeline->stats.elapsed_us, __ATOMIC_ACQUIRE) == 0;
+}
+
+void video_pipeline_wait(video_pipeline_t* pipeline) {
+    if (!pipeline || !pipeline->running) return;
+
+    for (uint8_t s = 0; s < pipeline->stage_count; s++) {
+        pthread_join(pipeline->stages[s].thread, nullptr);
+    }
+    destroy_queues(pipeline);
+    pipeline->running = false;
+}
+
+// ============================================================================
+// Status and Statistics Functions
+// ============================================================================
+
+video_pipeline_stage_stats_t video_pipeline_get_stage_stats(video_pipeline_t* pipeline, uint8_t stage) {
+    if (pipeline && stage < pipeline->stage_count) {
+        return pipeline->stages[stage].stats;
+    }
+    video_pipeline_stage_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+video_pipeline_stats_t video_pipeline_get_stats(video_pipeline_t* pipeline) {
+    if (pipeline) {
+        return pipeline->stats;
+    }
+    video_pipeline_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+void video_pipeline_print_stats(video_pipeline_t* pipeline) {
+    if (!pipeline) return;
+
+    video_pipeline_stats_t* stats = &pipeline->stats;
+    uint32_t elapsed = stats->elapsed_us ? stats->elapsed_us : micros() - pipeline->start_us;
+    if (elapsed == 0) elapsed = 1;
+
+    Serial.println("=== Pipeline Statistics ===");
+    Serial.printf("Items: %lu (%lu dropped) in %lu us, %.1f per second\n",
+                  stats->items, stats->dropped, elapsed, stats->items * 1000000.0f / elapsed);
+    if (stats->items > 0) {
+        Serial.printf("End-to-end Latency: mean %lu us, max %lu us\n",
+                      (uint32_t)(stats->latency_sum_us / stats->items), stats->latency_max_us);
+    }
+    for (uint8_t s = 0; s < pipeline->stage_count; s++) {
+        video_pipeline_stage_t* stage = &pipeline->stages[s];
+        video_pipeline_stage_stats_t* st = &stage->stats;
+        uint32_t n = st->items ? st->items : 1;
+        Serial.printf("%-8s: %lu items, busy %.1f%%, queue mean %.2f max %lu, latency mean %lu max %lu us, "
+                      "starved %lu, blocked %lu\n",
+                      stage->name, st->items, st->busy_us * 100.0f / elapsed,
+                      (float)st->occupancy_sum / n, st->occupancy_high,
+                      (uint32_t)(st->latency_sum_us / n), st->latency_max_us, st->starved, st->blocked);
+    }
+    Serial.println("===========================");
+}
@@ -0,0 +1,143 @@
+#ifndef VIDEO_PIPELINE_H
+#define VIDEO_PIPELINE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "bt656_example.h"
+
+// ============================================================================
+// Pipeline Configuration
+// ============================================================================
+
+#define VIDEO_PIPELINE_MAX_STAGES  8         // Stages (threads) per pipeline
+#define VIDEO_PIPELINE_MAX_ITEMS   8         // Items in flight
+#define VIDEO_PIPELINE_QUEUE_SLOTS 8         // Queue capacity (power of two, >= items)
+#define VIDEO_PIPELINE_STACK_SIZE  8192      // Stage thread stack (bytes)
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Unit of work handed from stage to stage
+// Each item owns a frame and, when configured, a buffer of raw capture bytes.
+// A stage that covers only part of the frame sets first_row / rows for the next one.
+typedef struct {
+    frame_buffer_t frame;          // Decoded frame
+    uint8_t* data;                 // Raw capture bytes (NULL if raw_bytes is 0)
+    size_t capacity;               // Bytes available at data
+    size_t length;                 // Bytes filled by the capture stage
+    uint16_t first_row;            // Rows of the frame the item covers
+    uint16_t rows;                 // (0 = whole frame)
+    uint32_t sequence;             // Order in which the first stage filled the item
+    uint32_t start_us;             // When the first stage took the item
+    uint32_t queued_us;            // When the item entered its current queue
+    bool dropped;                  // A stage discarded it; later stages pass it on
+    bool last;                     // End of stream marker
+} video_pipeline_item_t;
+
+// Stage function: fill or transform the item. The first stage returns false at
+// the end of its input; later stages return false to drop the item.
+typedef bool (*video_pipeline_stage_fn)(video_pipeline_item_t* item);
+
+// Bounded single-producer single-consumer queue of items
+// Push and pop are lock-free. Only a side that finds the queue full (or empty)
+// takes the lock and sleeps on the condition until the other side moves.
+typedef struct {
+    video_pipeline_item_t* slots[VIDEO_PIPELINE_QUEUE_SLOTS];
+    volatile uint32_t head;        // Next slot to read (consumer)
+    volatile uint32_t tail;        // Next slot to write (producer)
+    volatile uint32_t waiters;     // Sides asleep on cond (0 keeps the fast path lock-free)
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} video_pipeline_queue_t;
+
+// Per-stage statistics
+typedef struct {
+    uint32_t items;                // Items processed
+    uint32_t dropped;              // Items the stage discarded
+    uint32_t starved;              // Sleeps on an empty input queue
+    uint32_t blocked;              // Sleeps on a full output queue
+    uint32_t occupancy_high;       // Most items seen waiting in the input queue
+    uint64_t occupancy_sum;        // Input queue depth summed over items (for the mean)
+    uint64_t busy_us;              // Time inside the stage function
+    uint64_t latency_sum_us;       // Queue wait plus processing, summed over items
+    uint32_t latency_max_us;
+} video_pipeline_stage_stats_t;
+
+typedef struct video_pipeline video_pipeline_t;
+
+typedef struct {
+    const char* name;
+    video_pipeline_stage_fn process;
+    video_pipeline_queue_t input;  // Filled by the previous stage (free items for the first)
+    video_pipeline_t* pipeline;
+    uint8_t index;
+    pthread_t thread;
+    video_pipeline_stage_stats_t stats;
+} video_pipeline_stage_t;
+
+// Pipeline configuration
+typedef struct {
+    uint8_t items;                 // Items in flight (1..VIDEO_PIPELINE_MAX_ITEMS)
+    uint16_t width;                // Frame size of each item
+    uint16_t height;
+    size_t raw_bytes;              // Raw capture buffer per item (0 = none)
+} video_pipeline_config_t;
+
+// Pipeline statistics
+typedef struct {
+    uint32_t items;                // Items that left the last stage
+    uint32_t dropped;              // ... of which some stage discarded
+    uint64_t latency_sum_us;       // First stage to end of last stage
+    uint32_t latency_max_us;
+    uint32_t elapsed_us;           // Start to end of stream
+} video_pipeline_stats_t;
+
+// Chain of stages, each on its own thread, joined by bounded queues
+// The last stage hands items back to the first through the first stage's
+// input queue, so the items circulate and nothing is allocated while running.
+struct video_pipeline {
+    video_pipeline_config_t config;
+    video_pipeline_item_t* items;
+    video_pipeline_stage_t stages[VIDEO_PIPELINE_MAX_STAGES];
+    uint8_t stage_count;
+    uint32_t sequence;             // Next item sequence (first stage only)
+    uint32_t start_us;
+    bool running;                  // Stage threads started and not yet joined
+    volatile bool stopping;        // Stages give up waiting (failed start)
+    video_pipeline_stats_t stats;  // Updated by the last stage
+};
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core pipeline functions
+bool video_pipeline_init(video_pipeline_t* pipeline, const video_pipeline_config_t* config);
+void video_pipeline_deinit(video_pipeline_t* pipeline);
+bool video_pipeline_add_stage(video_pipeline_t* pipeline, const char* name, video_pipeline_stage_fn process);
+
+// Run control
+bool video_pipeline_start(video_pipeline_t* pipeline);
+bool video_pipeline_is_running(video_pipeline_t* pipeline);
+void video_pipeline_wait(video_pipeline_t* pipeline);
+
+// Status and statistics functions
+video_pipeline_stage_stats_t video_pipeline_get_stage_stats(video_pipeline_t* pipeline, uint8_t stage);
+video_pipeline_stats_t video_pipeline_get_stats(video_pipeline_t* pipeline);
+void video_pipeline_print_stats(video_pipeline_t* pipeline);
+
+// ============================================================================
+// Default Configuration
+// ============================================================================
+
+static const video_pipeline_config_t VIDEO_PIPELINE_DEFAULT_CONFIG = {
+    .items = 4,
+    .width = FRAME_WIDTH,
+    .height = FRAME_HEIGHT,
+    .raw_bytes = 0
+};
+
+#endif // VIDEO_PIPELINE_H
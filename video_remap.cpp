@@ -0,0 +1,324 @@
+#include "video_remap.h"
+#include <Arduino.h>
+#include <math.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+// Coordinates are handled in 16.16 fixed point while a frame is remapped
+#define COORD_SHIFT    16
+#define COORD_ONE      (1L << COORD_SHIFT)
+#define COORD_HALF     (1L << (COORD_SHIFT - 1))
+
+// RGB565 spread over a word with a 5-bit gap above each channel (green moved
+// to the upper half), so all three channels blend with one multiply
+#define RGB565_SPREAD  0x07E0F81FUL
+
+typedef struct {
+    int32_t x;
+    int32_t y;
+} coord_t;
+
+static bool is_supported_format(uint8_t format) {
+    return format == VIDEO_PIXEL_GRAY || format == VIDEO_PIXEL_RGB888 ||
+           format == VIDEO_PIXEL_YCBCR || format == VIDEO_PIXEL_RGB565;
+}
+
+// Source position (16.16) of output coordinate `pos` under a plain scale;
+// pixel centres are aligned, as in the scaler
+static int32_t scaled_position(int32_t pos, uint16_t src_size, uint16_t dst_size) {
+    int64_t numerator = (int64_t)(2 * pos + 1) * src_size * COORD_HALF;
+    return (int32_t)(numerator / dst_size) - COORD_HALF;
+}
+
+static int16_t to_point(float displacement) {
+    float scaled = displacement * (1 << VIDEO_REMAP_POINT_BITS);
+    if (scaled > 32767.0f) return 32767;
+    if (scaled < -32768.0f) return -32768;
+    return (int16_t)lroundf(scaled);
+}
+
+// Source position (16.16) of a control point (displacements are scaled with a
+// multiply, since left-shifting a negative value is undefined)
+static inline coord_t grid_position(const video_remap_t* remap, uint16_t gx, uint16_t gy) {
+    const video_remap_config_t* cfg = &remap->config;
+    const video_remap_point_t* point = &remap->grid[(uint32_t)gy * remap->grid_width + gx];
+    coord_t c;
+    c.x = scaled_position((int32_t)gx << cfg->grid_shift, cfg->src_width, cfg->dst_width) +
+          (int32_t)point->dx * (1 << (COORD_SHIFT - VIDEO_REMAP_POINT_BITS));
+    c.y = scaled_position((int32_t)gy << cfg->grid_shift, cfg->src_height, cfg->dst_height) +
+          (int32_t)point->dy * (1 << (COORD_SHIFT - VIDEO_REMAP_POINT_BITS));
+    return c;
+}
+
+// Clamp a coordinate to the sampled range; false if it lies more than half a
+// pixel outside the image
+static inline bool clamp_coord(int32_t* value, uint16_t size) {
+    int32_t last = (int32_t)(size - 1) << COORD_SHIFT;
+    if (*value < 0) {
+        if (*value < -COORD_HALF) return false;
+        *value = 0;
+    } else if (*value > last) {
+        if (*value > last + COORD_HALF) return false;
+        *value = last;
+    }
+    return true;
+}
+
+static inline uint32_t spread_rgb565(uint16_t pixel) {
+    return (pixel | ((uint32_t)pixel << 16)) & RGB565_SPREAD;
+}
+
+static inline uint32_t blend_rgb565(uint32_t a, uint32_t b, uint32_t weight) {
+    return ((a * (32 - weight) + b * weight) >> 5) & RGB565_SPREAD;
+}
+
+// One output run with the source position stepping linearly; returns the
+// number of pixels that fell outside the source
+static uint32_t IRAM_ATTR remap_span(const video_image_t* src, uint8_t* out, uint16_t count,
+                                     coord_t pos, coord_t step, uint8_t bpp, const uint8_t* fill) {
+    uint32_t outside = 0;
+
+    for (uint16_t i = 0; i < count; i++, out += bpp, pos.x += step.x, pos.y += step.y) {
+        int32_t sx = pos.x;
+        int32_t sy = pos.y;
+        if (!clamp_coord(&sx, src->width) || !clamp_coord(&sy, src->height)) {
+            memcpy(out, fill, bpp);
+            outside++;
+            continue;
+        }
+
+        uint16_t x0 = sx >> COORD_SHIFT;
+        uint16_t y0 = sy >> COORD_SHIFT;
+        uint32_t fx = (sx >> 8) & 0xFF;
+        uint32_t fy = (sy >> 8) & 0xFF;
+        uint32_t right = (x0 + 1 < src->width) ? bpp : 0;
+        uint32_t below = (y0 + 1 < src->height) ? src->stride : 0;
+        const uint8_t* p = video_image_row(src, y0) + (uint32_t)x0 * bpp;
+
+        if (src->format == VIDEO_PIXEL_RGB565) {
+            uint16_t p00, p01, p10, p11;
+            memcpy(&p00, p, 2);
+            memcpy(&p01, p + right, 2);
+            memcpy(&p10, p + below, 2);
+            memcpy(&p11, p + below + right, 2);
+            uint32_t top = blend_rgb565(spread_rgb565(p00), spread_rgb565(p01), fx >> 3);
+            uint32_t bottom = blend_rgb565(spread_rgb565(p10), spread_rgb565(p11), fx >> 3);
+            uint32_t mixed = blend_rgb565(top, bottom, fy >> 3);
+            uint16_t pixel = (uint16_t)(mixed | (mixed >> 16));
+            memcpy(out, &pixel, 2);
+            continue;
+        }
+
+        for (uint8_t c = 0; c < bpp; c++) {
+            const uint8_t* q = p + c;
+            int32_t top = (q[0] << 8) + (q[right] - q[0]) * (int32_t)fx;
+            int32_t bottom = (q[below] << 8) + (q[below + right] - q[below]) * (int32_t)fx;
+            out[c] = ((top << 8) + (bottom - top) * (int32_t)fy + 32768) >> 16;
+        }
+    }
+
+    return outside;
+}
+
+// ============================================================================
+// Core Remap Functions
+// ============================================================================
+
+bool video_remap_init(video_remap_t* remap, const video_remap_config_t* config) {
+    if (!remap || !config || config->src_width == 0 || config->src_height == 0 ||
+        config->dst_width == 0 || config->dst_height == 0 ||
+        !is_supported_format(config->format) || config->grid_shift < 3 || config->grid_shift > 6) {
+        Serial.println("ERROR: Invalid remap configuration");
+        return false;
+    }
+
+    memset(remap, 0, sizeof(video_remap_t));
+    remap->config = *config;
+
+    // One point past the last full cell so every output tile has four corners
+    remap->grid_width = ((config->dst_width - 1) >> config->grid_shift) + 2;
+    remap->grid_height = ((config->dst_height - 1) >> config->grid_shift) + 2;
+
+    uint32_t grid_bytes = (uint32_t)remap->grid_width * remap->grid_height * sizeof(video_remap_point_t);
+    remap->grid = (video_remap_point_t*)calloc(1, grid_bytes);
+    if (!remap->grid) {
+        Serial.println("ERROR: Failed to allocate remap grid");
+        return false;
+    }
+
+    Serial.printf("Lens remap initialized: %dx%d -> %dx%d, %dx%d grid (%lu bytes)\n",
+                  config->src_width, config->src_height, config->dst_width, config->dst_height,
+                  remap->grid_width, remap->grid_height, grid_bytes);
+    return true;
+}
+
+void video_remap_deinit(video_remap_t* remap) {
+    if (!remap) return;
+
+    if (remap->grid) free(remap->grid);
+
+    memset(remap, 0, sizeof(video_remap_t));
+}
+
+// ============================================================================
+// Grid Construction Functions
+// ============================================================================
+
+// Radial model r' = r (1 + k1 r^2 + k2 r^4) / zoom, with r measured in output
+// pixels and normalised to the half diagonal. Negative k1 stretches the edges,
+// which pre-compensates eyepiece barrel distortion; zoom > 1 crops the empty
+// corners that correction leaves. All zero with zoom 1 is a plain scale.
+bool video_remap_build_radial(video_remap_t* remap, float k1, float k2, float zoom) {
+    if (!remap || !remap->grid || zoom <= 0.0f) return false;
+
+    const video_remap_config_t* cfg = &remap->config;
+    float half_width = cfg->dst_width * 0.5f;
+    float half_height = cfg->dst_height * 0.5f;
+    float inv_radius2 = 1.0f / (half_width * half_width + half_height * half_height);
+    float scale_x = (float)cfg->src_width / cfg->dst_width;
+    float scale_y = (float)cfg->src_height / cfg->dst_height;
+
+    for (uint16_t gy = 0; gy < remap->grid_height; gy++) {
+        float dy = (float)(gy << cfg->grid_shift) + 0.5f - half_height;
+        for (uint16_t gx = 0; gx < remap->grid_width; gx++) {
+            float dx = (float)(gx << cfg->grid_shift) + 0.5f - half_width;
+            float r2 = (dx * dx + dy * dy) * inv_radius2;
+            float factor = (1.0f + k1 * r2 + k2 * r2 * r2) / zoom;
+
+            // Displacement from the plain scaled position, in source pixels
+            video_remap_point_t* point = &remap->grid[(uint32_t)gy * remap->grid_width + gx];
+            point->dx = to_point(dx * (factor - 1.0f) * scale_x);
+            point->dy = to_point(dy * (factor - 1.0f) * scale_y);
+        }
+    }
+
+    Serial.printf("Lens remap grid built: k1 %.3f, k2 %.3f, zoom %.3f\n", k1, k2, zoom);
+    return true;
+}
+
+// Place one control point (at output pixel gx << grid_shift, gy << grid_shift)
+// at a measured source position, e.g. from a calibration chart
+bool video_remap_set_point(video_remap_t* remap, uint16_t gx, uint16_t gy, float src_x, float src_y) {
+    if (!remap || !remap->grid || gx >= remap->grid_width || gy >= remap->grid_height) return false;
+
+    const video_remap_config_t* cfg = &remap->config;
+    float base_x = (float)scaled_position((int32_t)gx << cfg->grid_shift, cfg->src_width, cfg->dst_width) / COORD_ONE;
+    float base_y = (float)scaled_position((int32_t)gy << cfg->grid_shift, cfg->src_height, cfg->dst_height) / COORD_ONE;
+
+    video_remap_point_t* point = &remap->grid[(uint32_t)gy * remap->grid_width + gx];
+    point->dx = to_point(src_x - base_x);
+    point->dy = to_point(src_y - base_y);
+    return true;
+}
+
+// ============================================================================
+// Per-Frame Functions
+// ============================================================================
+
+// Output is walked one grid cell at a time. Within a cell the source position
+// is bilinear in the four corners: each row starts on the left edge and steps
+// by a constant towards the right edge. There is no gather unit on the target,
+// so the stepping replaces per-pixel coordinate lookups.
+static uint32_t IRAM_ATTR remap_cells(const video_remap_t* remap, const video_image_t* src,
+                                      const video_image_t* dst, uint16_t x0, uint16_t y0,
+                                      uint16_t x1, uint16_t y1) {
+    static const uint8_t black[3] = { 0, 0, 0 };
+    static const uint8_t black_ycbcr[3] = { 16, 128, 128 };
+    const video_remap_config_t* cfg = &remap->config;
+    const uint8_t* fill = (cfg->format == VIDEO_PIXEL_YCBCR) ? black_ycbcr : black;
+    const uint8_t bpp = video_image_bytes_per_pixel(cfg->format);
+    const uint8_t shift = cfg->grid_shift;
+    const uint16_t cell = 1 << shift;
+    uint32_t outside = 0;
+
+    for (uint16_t ty = y0, gy = y0 >> shift; ty < y1; ty += cell, gy++) {
+        uint16_t rows = (y1 - ty < cell) ? y1 - ty : cell;
+
+        for (uint16_t tx = x0, gx = x0 >> shift; tx < x1; tx += cell, gx++) {
+            uint16_t cols = (x1 - tx < cell) ? x1 - tx : cell;
+
+            coord_t p00 = grid_position(remap, gx, gy);
+            coord_t p10 = grid_position(remap, gx + 1, gy);
+            coord_t p01 = grid_position(remap, gx, gy + 1);
+            coord_t p11 = grid_position(remap, gx + 1, gy + 1);
+
+            // Edge deltas reach ~2^27 for the full displacement range, so the
+            // interpolation products need 64 bits
+            for (uint16_t j = 0; j < rows; j++) {
+                coord_t left, right, step;
+                left.x = p00.x + (int32_t)(((int64_t)(p01.x - p00.x) * j) >> shift);
+                left.y = p00.y + (int32_t)(((int64_t)(p01.y - p00.y) * j) >> shift);
+                right.x = p10.x + (int32_t)(((int64_t)(p11.x - p10.x) * j) >> shift);
+                right.y = p10.y + (int32_t)(((int64_t)(p11.y - p10.y) * j) >> shift);
+                step.x = (right.x - left.x) >> shift;
+                step.y = (right.y - left.y) >> shift;
+
+                uint8_t* out = video_image_row(dst, ty + j) + (uint32_t)tx * bpp;
+                outside += remap_span(src, out, cols, left, step, bpp, fill);
+            }
+        }
+    }
+    return outside;
+}
+
+static bool images_match(const video_remap_t* remap, const video_image_t* src, const video_image_t* dst) {
+    if (!remap || !remap->grid || !video_image_is_valid(src) || !video_image_is_valid(dst)) return false;
+
+    const video_remap_config_t* cfg = &remap->config;
+    return src->format == cfg->format && dst->format == cfg->format &&
+           src->width == cfg->src_width && src->height == cfg->src_height &&
+           dst->width == cfg->dst_width && dst->height == cfg->dst_height;
+}
+
+bool IRAM_ATTR video_remap_apply(video_remap_t* remap, const video_image_t* src, const video_image_t* dst) {
+    if (!images_match(remap, src, dst)) return false;
+
+    uint32_t outside = remap_cells(remap, src, dst, 0, 0, dst->width, dst->height);
+
+    remap->stats.frames++;
+    remap->stats.pixels_outside = outside;
+    return true;
+}
+
+// One rectangle of the output, for callers that split a frame across threads.
+// x and y must be multiples of the grid spacing. Leaves the statistics alone,
+// so several regions of one frame may run at the same time.
+bool video_remap_apply_region(const video_remap_t* remap, const video_image_t* src, const video_image_t* dst,
+                              uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
+    if (!images_match(remap, src, dst)) return false;
+
+    uint16_t cell_mask = (1 << remap->config.grid_shift) - 1;
+    if ((x & cell_mask) || (y & cell_mask) || x >= dst->width || y >= dst->height) return false;
+
+    uint16_t x1 = (dst->width - x < width) ? dst->width : x + width;
+    uint16_t y1 = (dst->height - y < height) ? dst->height : y + height;
+    remap_cells(remap, src, dst, x, y, x1, y1);
+    return true;
+}
+
+// ============================================================================
+// Status and Statistics Functions
+// ============================================================================
+
+video_remap_stats_t video_remap_get_stats(video_remap_t* remap) {
+    if (remap) {
+        return remap->stats;
+    }
+    video_remap_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+void video_remap_print_stats(video_remap_t* remap) {
+    if (!remap) return;
+
+    Serial.println("=== Lens Remap Statistics ===");
+    Serial.printf("Size: %dx%d -> %dx%d\n", remap->config.src_width, remap->config.src_height,
+                  remap->config.dst_width, remap->config.dst_height);
+    Serial.printf("Grid: %dx%d points, every %d pixels\n", remap->grid_width, remap->grid_height,
+                  1 << remap->config.grid_shift);
+    Serial.printf("Frames: %lu\n", remap->stats.frames);
+    Serial.printf("Pixels Outside: %lu\n", remap->stats.pixels_outside);
+    Serial.println("=============================");
+}
@@ -0,0 +1,89 @@
+#ifndef VIDEO_REMAP_H
+#define VIDEO_REMAP_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "video_image.h"
+
+// ============================================================================
+// Remap Configuration
+// ============================================================================
+
+#define VIDEO_REMAP_GRID_SHIFT      4         // One control point every 16 output pixels
+#define VIDEO_REMAP_POINT_BITS      5         // Displacements in 1/32 pixel (+-1024 px range)
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Remap configuration
+typedef struct {
+    uint16_t src_width;            // Source frame size
+    uint16_t src_height;
+    uint16_t dst_width;            // Output (display) size
+    uint16_t dst_height;
+    uint8_t format;                // VIDEO_PIXEL_GRAY, RGB888, YCBCR or RGB565
+    uint8_t grid_shift;            // Control point spacing as a power of two (3..6)
+} video_remap_config_t;
+
+// Control point: source position minus the plain scaled position, in 1/32 pixel
+typedef struct {
+    int16_t dx;
+    int16_t dy;
+} video_remap_point_t;
+
+// Remap statistics
+typedef struct {
+    uint32_t frames;               // Frames remapped
+    uint32_t pixels_outside;       // Output pixels that fell outside the source (last frame)
+} video_remap_stats_t;
+
+// Geometric correction through a displacement grid
+// The grid holds the source position of every control point; positions in
+// between are interpolated linearly across each tile, so a pixel costs one
+// add per axis plus a bilinear sample. Output is produced tile by tile so each
+// tile reads a compact region of the source.
+typedef struct {
+    video_remap_config_t config;
+    video_remap_point_t* grid;     // grid_width x grid_height points
+    uint16_t grid_width;
+    uint16_t grid_height;
+    video_remap_stats_t stats;
+} video_remap_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core remap functions (the grid starts as a plain scale)
+bool video_remap_init(video_remap_t* remap, const video_remap_config_t* config);
+void video_remap_deinit(video_remap_t* remap);
+
+// Grid construction: radial lens model, or individual points from a calibration
+bool video_remap_build_radial(video_remap_t* remap, float k1, float k2, float zoom);
+bool video_remap_set_point(video_remap_t* remap, uint16_t gx, uint16_t gy, float src_x, float src_y);
+
+// Per-frame application (src and dst in the configured format and sizes)
+bool video_remap_apply(video_remap_t* remap, const video_image_t* src, const video_image_t* dst);
+bool video_remap_apply_region(const video_remap_t* remap, const video_image_t* src, const video_image_t* dst,
+                              uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+
+// Status and statistics functions
+video_remap_stats_t video_remap_get_stats(video_remap_t* remap);
+void video_remap_print_stats(video_remap_t* remap);
+
+// ============================================================================
+// Default Configuration
+// ============================================================================
+
+static const video_remap_config_t VIDEO_REMAP_DEFAULT_CONFIG = {
+    .src_width = 720,
+    .src_height = 576,
+    .dst_width = 320,
+    .dst_height = 240,
+    .format = VIDEO_PIXEL_RGB565,
+    .grid_shift = VIDEO_REMAP_GRID_SHIFT
+};
+
+#endif // VIDEO_REMAP_H
@@ -0,0 +1,369 @@
+#include "video_scaler.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+#define WEIGHT_ONE      (1 << VIDEO_SCALER_WEIGHT_BITS)
+
+// One interleaved channel of a pixel format: where it sits and which filter it uses
+typedef struct {
+    uint8_t offset;                // Byte of the first sample
+    uint8_t step;                  // Bytes between samples
+    bool chroma;                   // Half-rate 4:2:2 chroma
+} plane_layout_t;
+
+static uint8_t get_planes(uint8_t format, plane_layout_t* planes) {
+    switch (format) {
+        case VIDEO_PIXEL_GRAY:
+            planes[0] = { 0, 1, false };
+            return 1;
+
+        case VIDEO_PIXEL_RGB888:
+        case VIDEO_PIXEL_YCBCR:
+            planes[0] = { 0, 3, false };
+            planes[1] = { 1, 3, false };
+            planes[2] = { 2, 3, false };
+            return 3;
+
+        case VIDEO_PIXEL_UYVY:
+            planes[0] = { 1, 2, false };
+            planes[1] = { 0, 4, true };
+            planes[2] = { 2, 4, true };
+            return 3;
+
+        case VIDEO_PIXEL_YUYV:
+            planes[0] = { 0, 2, false };
+            planes[1] = { 1, 4, true };
+            planes[2] = { 3, 4, true };
+            return 3;
+
+        default:
+            return 0;
+    }
+}
+
+static void free_axis(video_scaler_axis_t* axis) {
+    if (axis->start) free(axis->start);
+    if (axis->count) free(axis->count);
+    if (axis->offset) free(axis->offset);
+    if (axis->weights) free(axis->weights);
+    memset(axis, 0, sizeof(video_scaler_axis_t));
+}
+
+// Build the filter taps mapping `src` samples onto `dst` samples
+static bool build_axis(video_scaler_axis_t* axis, uint16_t src, uint16_t dst, video_scaler_mode_t mode) {
+    memset(axis, 0, sizeof(video_scaler_axis_t));
+    if (src == 0 || dst == 0) return false;
+
+    bool area = (mode == VIDEO_SCALER_AREA) ||
+                (mode == VIDEO_SCALER_AUTO && src >= (uint32_t)dst * VIDEO_SCALER_AREA_RATIO);
+    uint32_t span = (src + dst - 1) / dst + 2;   // Taps per output, upper bound
+    if (span > VIDEO_SCALER_MAX_TAPS) {
+        return false;
+    }
+
+    axis->start = (uint16_t*)malloc(dst * sizeof(uint16_t));
+    axis->count = (uint8_t*)malloc(dst);
+    axis->offset = (uint16_t*)malloc(dst * sizeof(uint16_t));
+    axis->weights = (uint16_t*)malloc(dst * span * sizeof(uint16_t));
+    if (!axis->start || !axis->count || !axis->offset || !axis->weights || dst * span > 0xFFFF) {
+        free_axis(axis);
+        return false;
+    }
+
+    const uint32_t scale = ((uint32_t)src << 16) / dst;    // Source step per output, Q16
+    uint32_t used = 0;
+
+    for (uint16_t i = 0; i < dst; i++) {
+        uint16_t* w = axis->weights + used;
+        uint8_t taps = 0;
+        uint16_t first;
+
+        if (area) {
+            // Output i covers [begin, end) of the source; each source sample is
+            // weighted by how much of that interval it overlaps
+            uint32_t begin = i * scale;
+            uint32_t end = (i == dst - 1) ? ((uint32_t)src << 16) : (i + 1) * scale;
+            uint32_t length = end - begin;
+            first = begin >> 16;
+
+            for (uint32_t j = first; (j << 16) < end; j++) {
+                uint32_t lo = (j << 16) > begin ? (j << 16) : begin;
+                uint32_t hi = ((j + 1) << 16) < end ? ((j + 1) << 16) : end;
+                w[taps++] = ((uint64_t)(hi - lo) * WEIGHT_ONE + length / 2) / length;
+            }
+        } else {
+            // Sample centre of output i in source coordinates
+            int32_t centre = (int32_t)(((uint64_t)(2 * i + 1) * scale) >> 1) - 0x8000;
+            if (centre < 0) centre = 0;
+            first = centre >> 16;
+            uint32_t frac = centre & 0xFFFF;
+
+            if (first >= src - 1) {
+                first = src - 1;
+                frac = 0;
+            }
+
+            uint16_t w1 = (frac + 2) >> 2;   // Q16 -> Q14
+            if (w1 == 0) {
+                w[taps++] = WEIGHT_ONE;
+            } else {
+                w[taps++] = WEIGHT_ONE - w1;
+                w[taps++] = w1;
+            }
+        }
+
+        // Rounding may leave the taps off by a few units; fold that into the largest
+        int32_t sum = 0;
+        uint8_t largest = 0;
+        for (uint8_t k = 0; k < taps; k++) {
+            sum += w[k];
+            if (w[k] > w[largest]) largest = k;
+        }
+        w[largest] += WEIGHT_ONE - sum;
+
+        axis->start[i] = first;
+        axis->count[i] = taps;
+        axis->offset[i] = used;
+        if (taps > axis->max_taps) axis->max_taps = taps;
+        used += taps;
+    }
+
+    axis->outputs = dst;
+    return true;
+}
+
+// Filter one channel of a source line into Q8 samples of an intermediate row
+static void IRAM_ATTR scale_plane(const uint8_t* src, uint8_t src_step, uint16_t* dst, uint8_t dst_step,
+                                  const video_scaler_axis_t* axis) {
+    for (uint16_t i = 0; i < axis->outputs; i++, dst += dst_step) {
+        const uint8_t* in = src + axis->start[i] * src_step;
+        const uint16_t* w = axis->weights + axis->offset[i];
+        uint32_t acc;
+
+        if (axis->count[i] == 2) {
+            acc = w[0] * in[0] + w[1] * in[src_step];
+        } else {
+            acc = 0;
+            for (uint8_t k = 0; k < axis->count[i]; k++, in += src_step) {
+                acc += w[k] * *in;
+            }
+        }
+        *dst = (acc + (1 << 5)) >> 6;   // Q14 x 8-bit -> Q8
+    }
+}
+
+// Filter the ring rows feeding output row `row` and deliver the result
+static void IRAM_ATTR emit_row(video_scaler_t* scaler, uint16_t row) {
+    const video_scaler_axis_t* axis = &scaler->rows;
+    const uint16_t* w = axis->weights + axis->offset[row];
+    uint8_t taps = axis->count[row];
+    const uint16_t* lines[VIDEO_SCALER_MAX_TAPS];
+
+    for (uint8_t k = 0; k < taps; k++) {
+        lines[k] = scaler->ring + ((axis->start[row] + k) % scaler->ring_rows) * scaler->row_samples;
+    }
+
+    uint8_t* out = scaler->destination.data ? video_image_row(&scaler->destination, row) : scaler->output_row;
+    const uint32_t round = 1UL << (VIDEO_SCALER_WEIGHT_BITS + 8 - 1);
+
+    if (taps == 1) {
+        for (uint16_t j = 0; j < scaler->row_samples; j++) {
+            out[j] = (lines[0][j] + 0x80) >> 8;
+        }
+    } else if (taps == 2) {
+        const uint32_t w0 = w[0], w1 = w[1];
+        for (uint16_t j = 0; j < scaler->row_samples; j++) {
+            out[j] = (w0 * lines[0][j] + w1 * lines[1][j] + round) >> (VIDEO_SCALER_WEIGHT_BITS + 8);
+        }
+    } else {
+        for (uint16_t j = 0; j < scaler->row_samples; j++) {
+            uint32_t acc = round;
+            for (uint8_t k = 0; k < taps; k++) {
+                acc += (uint32_t)w[k] * lines[k][j];
+            }
+            out[j] = acc >> (VIDEO_SCALER_WEIGHT_BITS + 8);
+        }
+    }
+
+    scaler->stats.lines_out++;
+
+    if (scaler->line_callback) {
+        video_image_t line = video_image_make(out, scaler->config.dst_width, 1, scaler->config.format);
+        scaler->line_callback(&line, row);
+    }
+}
+
+// ============================================================================
+// Core Scaler Functions
+// ============================================================================
+
+bool video_scaler_init(video_scaler_t* scaler, const video_scaler_config_t* config) {
+    if (!scaler || !config) {
+        Serial.println("ERROR: Invalid scaler pointer");
+        return false;
+    }
+
+    memset(scaler, 0, sizeof(video_scaler_t));
+    scaler->config = *config;
+    const video_scaler_config_t* cfg = &scaler->config;
+
+    plane_layout_t planes[3];
+    if (get_planes(cfg->format, planes) == 0) {
+        Serial.println("ERROR: Scaler pixel format not supported");
+        return false;
+    }
+
+    bool subsampled = video_image_is_422(cfg->format);
+    if (subsampled && ((cfg->src_width | cfg->dst_width) & 1)) {
+        Serial.println("ERROR: 4:2:2 scaling needs even widths");
+        return false;
+    }
+
+    bool ok = build_axis(&scaler->columns, cfg->src_width, cfg->dst_width, cfg->mode) &&
+              build_axis(&scaler->rows, cfg->src_height, cfg->dst_height, cfg->mode);
+    if (ok && subsampled) {
+        ok = build_axis(&scaler->chroma, cfg->src_width / 2, cfg->dst_width / 2, cfg->mode);
+    }
+    if (!ok) {
+        Serial.println("ERROR: Invalid scaler ratio");
+        video_scaler_deinit(scaler);
+        return false;
+    }
+
+    scaler->ring_rows = scaler->rows.max_taps;
+    scaler->row_samples = (uint32_t)cfg->dst_width * video_image_bytes_per_pixel(cfg->format);
+    scaler->ring = (uint16_t*)malloc((size_t)scaler->ring_rows * scaler->row_samples * sizeof(uint16_t));
+    scaler->output_row = (uint8_t*)malloc(scaler->row_samples);
+
+    if (!scaler->ring || !scaler->output_row) {
+        Serial.println("ERROR: Failed to allocate scaler buffers");
+        video_scaler_deinit(scaler);
+        return false;
+    }
+
+    Serial.printf("Scaler initialized: %dx%d -> %dx%d, %d-row window\n",
+                  cfg->src_width, cfg->src_height, cfg->dst_width, cfg->dst_height, scaler->ring_rows);
+    return true;
+}
+
+void video_scaler_deinit(video_scaler_t* scaler) {
+    if (!scaler) return;
+
+    free_axis(&scaler->columns);
+    free_axis(&scaler->chroma);
+    free_axis(&scaler->rows);
+    if (scaler->ring) free(scaler->ring);
+    if (scaler->output_row) free(scaler->output_row);
+
+    memset(scaler, 0, sizeof(video_scaler_t));
+}
+
+void video_scaler_set_line_callback(video_scaler_t* scaler, void (*callback)(const video_image_t* line, uint16_t row)) {
+    if (scaler) {
+        scaler->line_callback = callback;
+    }
+}
+
+// Write output rows straight into `destination` (NULL = internal row buffer)
+void video_scaler_set_destination(video_scaler_t* scaler, const video_image_t* destination) {
+    if (!scaler) return;
+
+    if (destination && video_image_is_valid(destination) &&
+        destination->format == scaler->config.format &&
+        destination->width == scaler->config.dst_width &&
+        destination->height == scaler->config.dst_height) {
+        scaler->destination = *destination;
+    } else {
+        scaler->destination.data = nullptr;
+    }
+}
+
+// ============================================================================
+// Streaming Functions
+// ============================================================================
+
+void video_scaler_begin_frame(video_scaler_t* scaler) {
+    if (scaler) {
+        scaler->next_src_row = 0;
+        scaler->next_dst_row = 0;
+    }
+}
+
+void IRAM_ATTR video_scaler_push_line(video_scaler_t* scaler, const uint8_t* line) {
+    if (!scaler || !scaler->ring || !line) return;
+
+    uint16_t src_row = scaler->next_src_row;
+    uint16_t* slot = scaler->ring + (src_row % scaler->ring_rows) * scaler->row_samples;
+
+    // Horizontal pass, channel by channel, into the ring
+    plane_layout_t planes[3];
+    uint8_t plane_count = get_planes(scaler->config.format, planes);
+    for (uint8_t p = 0; p < plane_count; p++) {
+        const video_scaler_axis_t* axis = planes[p].chroma ? &scaler->chroma : &scaler->columns;
+        scale_plane(line + planes[p].offset, planes[p].step, slot + planes[p].offset, planes[p].step, axis);
+    }
+    scaler->stats.lines_in++;
+
+    // Vertical pass for every output row whose last source row has now arrived
+    const video_scaler_axis_t* rows = &scaler->rows;
+    while (scaler->next_dst_row < rows->outputs) {
+        uint16_t r = scaler->next_dst_row;
+        if (rows->start[r] + rows->count[r] - 1 > src_row) break;
+        emit_row(scaler, r);
+        scaler->next_dst_row++;
+    }
+
+    if (++scaler->next_src_row >= scaler->config.src_height) {
+        scaler->stats.frames_scaled++;
+        video_scaler_begin_frame(scaler);
+    }
+}
+
+bool video_scaler_scale_image(video_scaler_t* scaler, const video_image_t* src, const video_image_t* dst) {
+    if (!scaler || !video_image_is_valid(src) || src->format != scaler->config.format ||
+        src->width != scaler->config.src_width || src->height != scaler->config.src_height) {
+        return false;
+    }
+
+    video_image_t previous = scaler->destination;
+    video_scaler_set_destination(scaler, dst);
+    bool ok = dst == nullptr || scaler->destination.data != nullptr;
+
+    if (ok) {
+        video_scaler_begin_frame(scaler);
+        for (uint16_t row = 0; row < src->height; row++) {
+            video_scaler_push_line(scaler, video_image_row(src, row));
+        }
+    }
+
+    scaler->destination = previous;
+    return ok;
+}
+
+// ============================================================================
+// Status and Statistics Functions
+// ============================================================================
+
+video_scaler_stats_t video_scaler_get_stats(video_scaler_t* scaler) {
+    if (scaler) {
+        return scaler->stats;
+    }
+    video_scaler_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+void video_scaler_print_stats(video_scaler_t* scaler) {
+    if (!scaler) return;
+
+    Serial.println("=== Scaler Statistics ===");
+    Serial.printf("Scale: %dx%d -> %dx%d\n", scaler->config.src_width, scaler->config.src_height,
+                  scaler->config.dst_width, scaler->config.dst_height);
+    Serial.printf("Taps: %d horizontal, %d vertical\n", scaler->columns.max_taps, scaler->rows.max_taps);
+    Serial.printf("Frames Scaled: %lu\n", scaler->stats.frames_scaled);
+    Serial.printf("Lines In: %lu\n", scaler->stats.lines_in);
+    Serial.printf("Lines Out: %lu\n", scaler->stats.lines_out);
+    Serial.println("=========================");
+}
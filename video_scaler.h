@@ -0,0 +1,100 @@
+#ifndef VIDEO_SCALER_H
+#define VIDEO_SCALER_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "video_image.h"
+
+// ============================================================================
+// Scaler Configuration
+// ============================================================================
+
+#define VIDEO_SCALER_WEIGHT_BITS   14        // Filter coefficients in Q14 (taps sum to 1 << 14)
+#define VIDEO_SCALER_AREA_RATIO    2         // AUTO switches to area averaging at 2:1 and beyond
+#define VIDEO_SCALER_MAX_TAPS      64        // Longest filter per output sample (limits the ratio)
+
+// Filter selection per axis
+typedef enum {
+    VIDEO_SCALER_AUTO = 0,         // Bilinear, or area averaging for large downscales
+    VIDEO_SCALER_BILINEAR,         // Two-tap interpolation between sample centres
+    VIDEO_SCALER_AREA              // Box filter weighted by exact source coverage
+} video_scaler_mode_t;
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Scaler configuration
+typedef struct {
+    uint16_t src_width;            // Input pixels per line
+    uint16_t src_height;           // Input lines per frame
+    uint16_t dst_width;            // Output pixels per line
+    uint16_t dst_height;           // Output lines per frame
+    uint8_t format;                // VIDEO_PIXEL_* (any except RGB565)
+    video_scaler_mode_t mode;      // Filter selection
+} video_scaler_config_t;
+
+// Precomputed filter for one axis: output i reads count[i] inputs from start[i]
+typedef struct {
+    uint16_t* start;               // First input sample per output
+    uint8_t* count;                // Taps per output
+    uint16_t* offset;              // First weight per output
+    uint16_t* weights;             // Q14 coefficients
+    uint16_t outputs;              // Output samples
+    uint8_t max_taps;              // Longest filter
+} video_scaler_axis_t;
+
+// Scaler statistics
+typedef struct {
+    uint32_t frames_scaled;        // Frames completed
+    uint32_t lines_in;             // Source lines pushed
+    uint32_t lines_out;            // Output lines produced
+} video_scaler_stats_t;
+
+// Streaming separable scaler
+// Each source line is filtered horizontally into a small ring of 16-bit rows as
+// it arrives; an output line is produced as soon as its last source row is in.
+typedef struct {
+    video_scaler_config_t config;
+    video_scaler_axis_t columns;   // Full-rate channels (luma, RGB)
+    video_scaler_axis_t chroma;    // Half-rate 4:2:2 chroma
+    video_scaler_axis_t rows;      // Vertical filter
+
+    uint16_t* ring;                // Horizontally scaled rows, Q8
+    uint8_t ring_rows;             // Rows held (vertical max taps)
+    uint16_t row_samples;          // Samples per output row (bytes in output format)
+    uint8_t* output_row;           // Output line when no destination is set
+
+    uint16_t next_src_row;         // Row the next push_line() call provides
+    uint16_t next_dst_row;         // Next output row to produce
+    video_image_t destination;     // Output frame (data NULL = callback only)
+
+    video_scaler_stats_t stats;    // Scaler statistics
+
+    // Called with each output line (a one-row view) and its row index
+    void (*line_callback)(const video_image_t* line, uint16_t row);
+} video_scaler_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core scaler functions
+bool video_scaler_init(video_scaler_t* scaler, const video_scaler_config_t* config);
+void video_scaler_deinit(video_scaler_t* scaler);
+void video_scaler_set_line_callback(video_scaler_t* scaler, void (*callback)(const video_image_t* line, uint16_t row));
+void video_scaler_set_destination(video_scaler_t* scaler, const video_image_t* destination);
+
+// Streaming: push source lines top to bottom; a frame restarts after the last one
+void video_scaler_begin_frame(video_scaler_t* scaler);
+void video_scaler_push_line(video_scaler_t* scaler, const uint8_t* line);
+
+// Whole image through the same streaming path
+bool video_scaler_scale_image(video_scaler_t* scaler, const video_image_t* src, const video_image_t* dst);
+
+// Status and statistics functions
+video_scaler_stats_t video_scaler_get_stats(video_scaler_t* scaler);
+void video_scaler_print_stats(video_scaler_t* scaler);
+
+#endif // VIDEO_SCALER_H
@@ -0,0 +1,322 @@
+#include "video_sharpen.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+// Blurred luma is kept in 16 bits, so two samples are summed per 32-bit word.
+// The largest vertical sum (255 x 16 x 16) still fits its lane.
+#define SAMPLE_LANES   0x0000FFFF
+
+static inline uint8_t clamp_u8(int value) {
+    return (value < 0) ? 0 : (value > 255) ? 255 : value;
+}
+
+// Detail beyond the threshold is scaled by amount; the threshold is subtracted
+// first so the response has no step at the threshold
+static void rebuild_detail_lut(video_sharpen_t* sharpen) {
+    int amount = sharpen->config.amount;
+    int threshold = sharpen->config.threshold;
+
+    for (int d = -255; d <= 255; d++) {
+        int magnitude = d < 0 ? -d : d;
+        int change = 0;
+        if (magnitude > threshold) {
+            change = ((magnitude - threshold) * amount + VIDEO_SHARPEN_AMOUNT_UNITY / 2) / VIDEO_SHARPEN_AMOUNT_UNITY;
+        }
+        sharpen->detail_lut[d + 255] = d < 0 ? -change : change;
+    }
+}
+
+// Horizontal binomial blur of the luma in a UYVY line (edges replicated)
+static void IRAM_ATTR blur_line(const uint8_t* uyvy, uint16_t* out, uint16_t width, uint8_t radius) {
+    const uint8_t* y = uyvy + 1;       // Luma every second byte
+    uint16_t last = width - 1;
+
+    if (radius == 1) {
+        out[0] = 3 * y[0] + y[2 * (width > 1)];
+        for (uint16_t x = 1; x < last; x++) {
+            out[x] = y[2 * x - 2] + 2 * y[2 * x] + y[2 * x + 2];
+        }
+        if (last > 0) out[last] = y[2 * last - 2] + 3 * y[2 * last];
+        return;
+    }
+
+    for (uint16_t x = 0; x < width; x++) {
+        if (x >= 2 && x + 2 <= last) {
+            const uint8_t* p = y + 2 * x;
+            out[x] = p[-4] + 4 * p[-2] + 6 * p[0] + 4 * p[2] + p[4];
+            continue;
+        }
+        uint16_t sum = 0;
+        static const uint8_t weights[5] = { 1, 4, 6, 4, 1 };
+        for (int k = -2; k <= 2; k++) {
+            int xx = (int)x + k;
+            if (xx < 0) xx = 0;
+            if (xx > last) xx = last;
+            sum += weights[k + 2] * y[2 * xx];
+        }
+        out[x] = sum;
+    }
+}
+
+// Sharpen line `center` of the current sequence, with the vertical taps
+// clamped to the lines 0..`newest` available
+static void IRAM_ATTR emit_line(video_sharpen_t* sharpen, uint16_t center, uint16_t newest) {
+    const video_sharpen_config_t* cfg = &sharpen->config;
+    const uint8_t radius = cfg->radius;
+    const uint16_t* taps[VIDEO_SHARPEN_WINDOW];
+
+    for (int k = -radius; k <= radius; k++) {
+        int n = (int)center + k;
+        if (n < 0) n = 0;
+        if (n > newest) n = newest;
+        taps[k + radius] = sharpen->blurred + (uint32_t)(n % sharpen->window) * cfg->width;
+    }
+
+    uint8_t slot = center % sharpen->window;
+    const uint8_t* raw = sharpen->lines + slot * sharpen->line_bytes;
+    uint8_t* out = sharpen->output_line;
+    const int16_t* lut = sharpen->detail_lut + 255;
+
+    // Total weight 16 (radius 1) or 256 (radius 2)
+    const uint8_t shift = (radius == 1) ? 4 : 8;
+    const uint32_t round = 0x00010001UL << (shift - 1);
+
+    memcpy(out, raw, sharpen->line_bytes);
+
+    for (uint16_t x = 0; x + 2 <= cfg->width; x += 2) {
+        uint32_t t[VIDEO_SHARPEN_WINDOW];
+        for (uint8_t k = 0; k < sharpen->window; k++) {
+            memcpy(&t[k], taps[k] + x, 4);
+        }
+
+        // Rounded blur of both samples, computed in their 16-bit lanes
+        uint32_t lanes = (radius == 1) ? t[0] + 2 * t[1] + t[2]
+                                       : t[0] + 4 * t[1] + 6 * t[2] + 4 * t[3] + t[4];
+        lanes += round;
+        uint8_t blur0 = (lanes & SAMPLE_LANES) >> shift;
+        uint8_t blur1 = (lanes >> 16) >> shift;
+
+        uint8_t y0 = raw[2 * x + 1];
+        uint8_t y1 = raw[2 * x + 3];
+        out[2 * x + 1] = clamp_u8(y0 + lut[y0 - blur0]);
+        out[2 * x + 3] = clamp_u8(y1 + lut[y1 - blur1]);
+    }
+
+    sharpen->stats.lines_out++;
+    if (sharpen->line_callback) {
+        video_image_t line = video_image_make(out, cfg->width, 1, VIDEO_PIXEL_UYVY);
+        sharpen->line_callback(&line, sharpen->rows[slot]);
+    }
+}
+
+// ============================================================================
+// Core Unsharp Mask Functions
+// ============================================================================
+
+bool video_sharpen_init(video_sharpen_t* sharpen, const video_sharpen_config_t* config) {
+    if (!sharpen || !config || config->width < 2 || (config->width & 1) ||
+        config->radius < 1 || config->radius > VIDEO_SHARPEN_MAX_RADIUS) {
+        Serial.println("ERROR: Invalid unsharp mask configuration");
+        return false;
+    }
+
+    memset(sharpen, 0, sizeof(video_sharpen_t));
+    sharpen->config = *config;
+    sharpen->window = 2 * config->radius + 1;
+    sharpen->line_bytes = (uint32_t)config->width * 2;
+    sharpen->last_row = -1;
+
+    sharpen->lines = (uint8_t*)malloc(sharpen->window * sharpen->line_bytes);
+    sharpen->blurred = (uint16_t*)malloc(sharpen->window * config->width * sizeof(uint16_t));
+    sharpen->output_line = (uint8_t*)malloc(sharpen->line_bytes);
+
+    if (!sharpen->lines || !sharpen->blurred || !sharpen->output_line) {
+        Serial.println("ERROR: Failed to allocate unsharp mask buffers");
+        video_sharpen_deinit(sharpen);
+        return false;
+    }
+
+    rebuild_detail_lut(sharpen);
+
+    Serial.printf("Unsharp mask initialized: radius %d, amount %d/16, threshold %d\n",
+                  config->radius, config->amount, config->threshold);
+    return true;
+}
+
+void video_sharpen_deinit(video_sharpen_t* sharpen) {
+    if (!sharpen) return;
+
+    if (sharpen->lines) free(sharpen->lines);
+    if (sharpen->blurred) free(sharpen->blurred);
+    if (sharpen->output_line) free(sharpen->output_line);
+
+    memset(sharpen, 0, sizeof(video_sharpen_t));
+}
+
+// Runtime adjustment; the table is only rebuilt when something changed
+void video_sharpen_set_params(video_sharpen_t* sharpen, uint8_t amount, uint8_t threshold) {
+    if (!sharpen) return;
+
+    if (sharpen->config.amount != amount || sharpen->config.threshold != threshold) {
+        sharpen->config.amount = amount;
+        sharpen->config.threshold = threshold;
+        rebuild_detail_lut(sharpen);
+    }
+}
+
+void video_sharpen_set_line_callback(video_sharpen_t* sharpen,
+                                     void (*callback)(const video_image_t* line, uint16_t row)) {
+    if (sharpen) {
+        sharpen->line_callback = callback;
+    }
+}
+
+// ============================================================================
+// Streaming Functions
+// ============================================================================
+
+void IRAM_ATTR video_sharpen_push_line(video_sharpen_t* sharpen, const uint8_t* uyvy, uint16_t row) {
+    if (!sharpen || !sharpen->lines || !uyvy) return;
+
+    // Rows that do not continue downwards belong to the next field or frame
+    if (sharpen->last_row >= 0 && (int32_t)row <= sharpen->last_row) {
+        video_sharpen_flush(sharpen);
+    }
+    sharpen->last_row = row;
+    sharpen->stats.lines_in++;
+
+    uint16_t n = sharpen->pushed++;
+    uint8_t slot = n % sharpen->window;
+    memcpy(sharpen->lines + slot * sharpen->line_bytes, uyvy, sharpen->line_bytes);
+    blur_line(uyvy, sharpen->blurred + (uint32_t)slot * sharpen->config.width,
+              sharpen->config.width, sharpen->config.radius);
+    sharpen->rows[slot] = row;
+
+    if (n >= sharpen->config.radius) {
+        emit_line(sharpen, n - sharpen->config.radius, n);
+    }
+}
+
+// Produce the last `radius` lines of the sequence (bottom edge replicated)
+void video_sharpen_flush(video_sharpen_t* sharpen) {
+    if (!sharpen || sharpen->pushed == 0) return;
+
+    uint16_t newest = sharpen->pushed - 1;
+    uint16_t first = (sharpen->pushed > sharpen->config.radius) ? sharpen->pushed - sharpen->config.radius : 0;
+    for (uint16_t center = first; center <= newest; center++) {
+        emit_line(sharpen, center, newest);
+    }
+
+    sharpen->pushed = 0;
+    sharpen->last_row = -1;
+    sharpen->stats.sequences++;
+}
+
+// ============================================================================
+// Whole View Functions
+// ============================================================================
+
+// Columns blurred vertically per pass (keeps the buffer small enough for a worker stack)
+#define REGION_CHUNK   128
+
+// The blur is separable and exact in integers, so summing columns first and
+// rows second gives the same result as the streaming rows-first order
+bool IRAM_ATTR video_sharpen_apply_region(const video_sharpen_t* sharpen, const video_image_t* src,
+                                          const video_image_t* dst, uint16_t x, uint16_t y,
+                                          uint16_t width, uint16_t height) {
+    if (!sharpen || sharpen->window == 0 || !video_image_is_valid(src) || !video_image_is_valid(dst) ||
+        src->format != VIDEO_PIXEL_UYVY || dst->format != VIDEO_PIXEL_UYVY ||
+        src->width != dst->width || src->height != dst->height || src->data == dst->data ||
+        (x & 1) || (width & 1) || x + width > src->width || y + height > src->height) {
+        return false;
+    }
+
+    const uint8_t radius = sharpen->config.radius;
+    const uint8_t shift = (radius == 1) ? 4 : 8;
+    const uint16_t round = 1 << (shift - 1);
+    const int last_col = src->width - 1;
+    const int last_row = src->height - 1;
+    const int16_t* lut = sharpen->detail_lut + 255;
+    uint16_t columns[REGION_CHUNK + 2 * VIDEO_SHARPEN_MAX_RADIUS];
+
+    for (uint16_t r = y; r < y + height; r++) {
+        const uint8_t* taps[VIDEO_SHARPEN_WINDOW];
+        for (int k = -radius; k <= radius; k++) {
+            int n = (int)r + k;
+            if (n < 0) n = 0;
+            if (n > last_row) n = last_row;
+            taps[k + radius] = video_image_row(src, n) + 1;   // Luma every second byte
+        }
+        const uint8_t* raw = video_image_row(src, r);
+        uint8_t* out = video_image_row(dst, r);
+        memcpy(out + 2 * x, raw + 2 * x, 2 * width);
+
+        for (uint16_t c0 = x; c0 < x + width; c0 += REGION_CHUNK) {
+            uint16_t n = (x + width - c0 < REGION_CHUNK) ? x + width - c0 : REGION_CHUNK;
+
+            for (uint16_t i = 0; i < n + 2 * radius; i++) {
+                int c = (int)c0 + i - radius;
+                if (c < 0) c = 0;
+                if (c > last_col) c = last_col;
+                const uint16_t o = 2 * c;
+                columns[i] = (radius == 1) ? taps[0][o] + 2 * taps[1][o] + taps[2][o]
+                                           : taps[0][o] + 4 * taps[1][o] + 6 * taps[2][o] +
+                                             4 * taps[3][o] + taps[4][o];
+            }
+
+            for (uint16_t i = 0; i < n; i++) {
+                const uint16_t* t = columns + i;
+                uint32_t sum = (radius == 1) ? t[0] + 2 * t[1] + t[2]
+                                             : t[0] + 4 * t[1] + 6 * t[2] + 4 * t[3] + t[4];
+                uint8_t blur = (sum + round) >> shift;
+                uint32_t o = 2 * (uint32_t)(c0 + i) + 1;
+                uint8_t luma = raw[o];
+                out[o] = clamp_u8(luma + lut[luma - blur]);
+            }
+        }
+    }
+    return true;
+}
+
+// The tile's source rectangle is its output grown by the halo, so clamping to
+// that view is clamping to the frame wherever the halo was cut by an edge
+void video_sharpen_tile(const video_image_t* src, const video_image_t* dst,
+                        const video_tile_t* tile, void* user) {
+    video_image_t in = video_tiles_source(src, tile);
+    video_image_t out = video_tiles_source(dst, tile);
+    video_sharpen_apply_region((const video_sharpen_t*)user, &in, &out, tile->x - tile->in_x,
+                               tile->y - tile->in_y, tile->width, tile->height);
+}
+
+// The views hold the strip and its context, cut at the frame edges
+void video_sharpen_strip(const video_image_t* src, const video_image_t* dst,
+                         uint16_t first_row, uint16_t rows, void* user) {
+    video_sharpen_apply_region((const video_sharpen_t*)user, src, dst, 0, first_row, src->width, rows);
+}
+
+// ============================================================================
+// Status and Statistics Functions
+// ============================================================================
+
+video_sharpen_stats_t video_sharpen_get_stats(video_sharpen_t* sharpen) {
+    if (sharpen) {
+        return sharpen->stats;
+    }
+    video_sharpen_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+void video_sharpen_print_stats(video_sharpen_t* sharpen) {
+    if (!sharpen) return;
+
+    Serial.println("=== Unsharp Mask Statistics ===");
+    Serial.printf("Radius: %d, amount %d/16, threshold %d\n", sharpen->config.radius,
+                  sharpen->config.amount, sharpen->config.threshold);
+    Serial.printf("Lines In: %lu\n", sharpen->stats.lines_in);
+    Serial.printf("Lines Out: %lu\n", sharpen->stats.lines_out);
+    Serial.printf("Sequences: %lu\n", sharpen->stats.sequences);
+    Serial.println("===============================");
+}
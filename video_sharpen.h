@@ -0,0 +1,110 @@
+#ifndef VIDEO_SHARPEN_H
+#define VIDEO_SHARPEN_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "video_image.h"
+#include "video_tiles.h"
+#include "video_strip.h"
+
+// ============================================================================
+// Unsharp Mask Configuration
+// ============================================================================
+
+#define VIDEO_SHARPEN_MAX_RADIUS       2     // 5x5 binomial blur at most
+#define VIDEO_SHARPEN_WINDOW           (2 * VIDEO_SHARPEN_MAX_RADIUS + 1)
+#define VIDEO_SHARPEN_AMOUNT_UNITY     16    // Amount is in 16ths (16 = add the full detail once)
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Unsharp mask configuration
+typedef struct {
+    uint16_t width;                // Pixels per line (UYVY)
+    uint8_t radius;                // Blur radius: 1 = [1 2 1], 2 = [1 4 6 4 1]
+    uint8_t amount;                // Detail gain in 16ths
+    uint8_t threshold;             // Detail below this is left alone (keeps grain down)
+} video_sharpen_config_t;
+
+// Unsharp mask statistics
+typedef struct {
+    uint32_t lines_in;             // Lines pushed
+    uint32_t lines_out;            // Lines produced
+    uint32_t sequences;            // Fields/frames flushed
+} video_sharpen_stats_t;
+
+// Streaming luma unsharp mask
+// Each pushed line is blurred horizontally into a small ring; once `radius`
+// further lines have arrived, the vertical blur is taken across the ring and
+// the line is sharpened by the difference. Lines pushed in increasing row
+// order are treated as vertical neighbours, so a field is filtered within
+// itself; a row that does not increase starts a new sequence.
+typedef struct {
+    video_sharpen_config_t config;
+
+    uint8_t* lines;                // Ring of raw UYVY lines
+    uint16_t* blurred;             // Ring of horizontally blurred luma (weight 4 or 16)
+    uint8_t* output_line;          // Sharpened line
+    uint16_t rows[VIDEO_SHARPEN_WINDOW];  // Frame row of each ring slot
+    uint32_t line_bytes;           // Bytes per UYVY line
+    uint8_t window;                // Lines in the ring (2 * radius + 1)
+
+    int16_t detail_lut[511];       // (luma - blur + 255) -> luma change
+    uint16_t pushed;               // Lines in the current sequence
+    int32_t last_row;              // Row of the last line pushed (-1 = none)
+
+    video_sharpen_stats_t stats;
+
+    // Called with each sharpened line (a one-row view) and its frame row
+    void (*line_callback)(const video_image_t* line, uint16_t row);
+} video_sharpen_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core unsharp mask functions
+bool video_sharpen_init(video_sharpen_t* sharpen, const video_sharpen_config_t* config);
+void video_sharpen_deinit(video_sharpen_t* sharpen);
+void video_sharpen_set_params(video_sharpen_t* sharpen, uint8_t amount, uint8_t threshold);
+void video_sharpen_set_line_callback(video_sharpen_t* sharpen,
+                                     void (*callback)(const video_image_t* line, uint16_t row));
+
+// Streaming: output lags `radius` lines behind input; flush at the end of each field
+void video_sharpen_push_line(video_sharpen_t* sharpen, const uint8_t* uyvy, uint16_t row);
+void video_sharpen_flush(video_sharpen_t* sharpen);
+
+// Whole views: sharpen a rectangle of dst (x and width even) from the same
+// rectangle of src, reading `radius` pixels around it with taps clamped to
+// src's edges. Over a whole view the result matches pushing its rows in order.
+// Pass one field of woven frames (video_image_field()), not the frame.
+bool video_sharpen_apply_region(const video_sharpen_t* sharpen, const video_image_t* src,
+                                const video_image_t* dst, uint16_t x, uint16_t y,
+                                uint16_t width, uint16_t height);
+
+// Tile stage for video_tiles_run() with halo = radius (even tile width); user is the video_sharpen_t
+void video_sharpen_tile(const video_image_t* src, const video_image_t* dst,
+                        const video_tile_t* tile, void* user);
+
+// Strip stage for video_strip_add_stage() with context = radius; user is the video_sharpen_t
+void video_sharpen_strip(const video_image_t* src, const video_image_t* dst,
+                         uint16_t first_row, uint16_t rows, void* user);
+
+// Status and statistics functions
+video_sharpen_stats_t video_sharpen_get_stats(video_sharpen_t* sharpen);
+void video_sharpen_print_stats(video_sharpen_t* sharpen);
+
+// ============================================================================
+// Default Configuration
+// ============================================================================
+
+static const video_sharpen_config_t VIDEO_SHARPEN_DEFAULT_CONFIG = {
+    .width = 720,
+    .radius = 1,
+    .amount = 12,
+    .threshold = 4
+};
+
+#endif // VIDEO_SHARPEN_H
@@ -0,0 +1,152 @@
+#include "video_stack.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+// Luma position within a pixel of each format stacking accepts (false if none)
+static bool luma_layout(uint8_t format, uint8_t* offset, uint8_t* step) {
+    switch (format) {
+        case VIDEO_PIXEL_UYVY: *offset = 1; *step = 2; return true;
+        case VIDEO_PIXEL_YUYV: *offset = 0; *step = 2; return true;
+        case VIDEO_PIXEL_GRAY: *offset = 0; *step = 1; return true;
+        default: return false;
+    }
+}
+
+// One row: add the new luma, drop the oldest, write the average
+static void IRAM_ATTR stack_row(const uint8_t* src, uint8_t src_step, uint8_t* dst, uint8_t dst_step,
+                                uint16_t* sums, uint8_t* plane, uint16_t width, uint32_t reciprocal) {
+    for (uint16_t x = 0; x < width; x++, src += src_step, dst += dst_step) {
+        uint8_t y = *src;
+        uint16_t sum = sums[x] + y - plane[x];
+        sums[x] = sum;
+        plane[x] = y;
+        *dst = (sum * reciprocal + 0x8000) >> 16;
+    }
+}
+
+// ============================================================================
+// Core Stacking Functions
+// ============================================================================
+
+bool video_stack_init(video_stack_t* stack, const video_stack_config_t* config) {
+    if (!stack || !config || config->width == 0 || config->height == 0 ||
+        config->depth < 2 || config->depth > VIDEO_STACK_MAX_DEPTH) {
+        Serial.println("ERROR: Invalid frame stacking configuration");
+        return false;
+    }
+
+    memset(stack, 0, sizeof(video_stack_t));
+    stack->config = *config;
+
+    uint32_t pixels = (uint32_t)config->width * config->height;
+    stack->sums = (uint16_t*)calloc(pixels, sizeof(uint16_t));
+    stack->planes = (uint8_t*)calloc(pixels, config->depth);
+
+    if (!stack->sums || !stack->planes) {
+        Serial.println("ERROR: Failed to allocate frame stack");
+        video_stack_deinit(stack);
+        return false;
+    }
+
+    Serial.printf("Frame stacking initialized: %dx%d, %d frames (%lu bytes)\n",
+                  config->width, config->height, config->depth,
+                  (uint32_t)(pixels * (config->depth + sizeof(uint16_t))));
+    return true;
+}
+
+void video_stack_deinit(video_stack_t* stack) {
+    if (!stack) return;
+
+    if (stack->sums) free(stack->sums);
+    if (stack->planes) free(stack->planes);
+
+    memset(stack, 0, sizeof(video_stack_t));
+}
+
+// Empty the stack (e.g. after the camera moved); averaging restarts from one frame
+void video_stack_reset(video_stack_t* stack) {
+    if (!stack || !stack->sums) return;
+
+    uint32_t pixels = (uint32_t)stack->config.width * stack->config.height;
+    memset(stack->sums, 0, pixels * sizeof(uint16_t));
+    memset(stack->planes, 0, pixels * stack->config.depth);
+    stack->oldest = 0;
+    stack->count = 0;
+    stack->stats.resets++;
+}
+
+// ============================================================================
+// Stacking
+// ============================================================================
+
+bool video_stack_process(video_stack_t* stack, const video_image_t* src, const video_image_t* dst) {
+    if (!stack || !stack->sums || !video_image_is_valid(src) || !video_image_is_valid(dst)) {
+        return false;
+    }
+
+    const video_stack_config_t* cfg = &stack->config;
+    uint8_t src_offset, src_step, dst_offset, dst_step;
+    if (src->width != cfg->width || src->height != cfg->height ||
+        dst->width != cfg->width || dst->height != cfg->height ||
+        !luma_layout(src->format, &src_offset, &src_step) ||
+        !luma_layout(dst->format, &dst_offset, &dst_step)) {
+        return false;
+    }
+
+    // Chroma can only be carried over into the same layout
+    bool copy_chroma = video_image_is_422(dst->format);
+    if (copy_chroma && src->format != dst->format) {
+        return false;
+    }
+
+    // During warm-up the plane being replaced is still zero, so the sum grows
+    if (stack->count < cfg->depth) {
+        stack->count++;
+        stack->reciprocal = (65536 + stack->count / 2) / stack->count;
+    }
+
+    uint32_t pixels = (uint32_t)cfg->width * cfg->height;
+    uint8_t* plane = stack->planes + pixels * stack->oldest;
+
+    for (uint16_t row = 0; row < cfg->height; row++) {
+        const uint8_t* in = video_image_row(src, row);
+        uint8_t* out = video_image_row(dst, row);
+
+        if (copy_chroma && in != out) {
+            memcpy(out, in, video_image_row_bytes(dst));
+        }
+
+        uint32_t start = (uint32_t)row * cfg->width;
+        stack_row(in + src_offset, src_step, out + dst_offset, dst_step,
+                  stack->sums + start, plane + start, cfg->width, stack->reciprocal);
+    }
+
+    stack->oldest = (stack->oldest + 1) % cfg->depth;
+    stack->stats.frames_added++;
+    return true;
+}
+
+// ============================================================================
+// Status and Statistics Functions
+// ============================================================================
+
+video_stack_stats_t video_stack_get_stats(video_stack_t* stack) {
+    if (stack) {
+        return stack->stats;
+    }
+    video_stack_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+void video_stack_print_stats(video_stack_t* stack) {
+    if (!stack) return;
+
+    Serial.println("=== Frame Stacking Statistics ===");
+    Serial.printf("Depth: %d (%d held)\n", stack->config.depth, stack->count);
+    Serial.printf("Frames Added: %lu\n", stack->stats.frames_added);
+    Serial.printf("Resets: %lu\n", stack->stats.resets);
+    Serial.println("=================================");
+}
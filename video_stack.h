@@ -0,0 +1,75 @@
+#ifndef VIDEO_STACK_H
+#define VIDEO_STACK_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "video_image.h"
+
+// ============================================================================
+// Frame Stacking Configuration
+// ============================================================================
+
+#define VIDEO_STACK_MAX_DEPTH      64        // 64 x 255 fits the 16-bit accumulators
+#define VIDEO_STACK_DEFAULT_DEPTH  8         // sqrt(8) = 2.8x SNR on a static scene
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Frame stacking configuration
+typedef struct {
+    uint16_t width;                // Pixels per line
+    uint16_t height;               // Rows per frame
+    uint8_t depth;                 // Frames averaged (2..VIDEO_STACK_MAX_DEPTH)
+} video_stack_config_t;
+
+// Frame stacking statistics
+typedef struct {
+    uint32_t frames_added;         // Frames pushed into the stack
+    uint32_t resets;               // Times the stack was emptied
+} video_stack_stats_t;
+
+// Running average of the last `depth` luma frames
+// A 16-bit sum per pixel gains the newest frame and loses the oldest, which is
+// kept in a ring of luma planes. The cost per frame does not depend on depth.
+typedef struct {
+    video_stack_config_t config;
+
+    uint16_t* sums;                // Per-pixel sum of the frames held
+    uint8_t* planes;               // `depth` luma planes, oldest at `oldest`
+    uint8_t oldest;                // Plane the next frame replaces
+    uint8_t count;                 // Frames currently held (<= depth)
+    uint32_t reciprocal;           // 65536 / count, for the average
+
+    video_stack_stats_t stats;
+} video_stack_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core stacking functions
+bool video_stack_init(video_stack_t* stack, const video_stack_config_t* config);
+void video_stack_deinit(video_stack_t* stack);
+void video_stack_reset(video_stack_t* stack);
+
+// Add `src` (UYVY, YUYV or grey) and write the average into `dst` in the same
+// pass. A 4:2:2 `dst` takes its chroma from `src`; `dst` may be `src`.
+bool video_stack_process(video_stack_t* stack, const video_image_t* src, const video_image_t* dst);
+
+// Status and statistics functions
+video_stack_stats_t video_stack_get_stats(video_stack_t* stack);
+void video_stack_print_stats(video_stack_t* stack);
+
+// ============================================================================
+// Default Configuration
+// ============================================================================
+
+static const video_stack_config_t VIDEO_STACK_DEFAULT_CONFIG = {
+    .width = 720,
+    .height = 576,
+    .depth = VIDEO_STACK_DEFAULT_DEPTH
+};
+
+#endif // VIDEO_STACK_H
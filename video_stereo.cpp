@@ -0,0 +1,104 @@
+#include "video_stereo.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Core Pairing Functions
+// ============================================================================
+
+bool video_stereo_init(video_stereo_t* stereo, const video_stereo_config_t* config,
+                       frame_ring_t* left_ring, frame_ring_t* right_ring) {
+    if (!stereo || !config || !left_ring || !right_ring || left_ring == right_ring) {
+        Serial.println("ERROR: Invalid stereo pairing configuration");
+        return false;
+    }
+
+    memset(stereo, 0, sizeof(video_stereo_t));
+    stereo->config = *config;
+    stereo->left_ring = left_ring;
+    stereo->right_ring = right_ring;
+
+    Serial.printf("Stereo pairing initialized: tolerance %lu us\n", config->tolerance_us);
+    return true;
+}
+
+void video_stereo_deinit(video_stereo_t* stereo) {
+    if (stereo) {
+        memset(stereo, 0, sizeof(video_stereo_t));
+    }
+}
+
+// Forget held frames, e.g. after one camera lost sync
+void video_stereo_reset(video_stereo_t* stereo) {
+    if (stereo) {
+        stereo->left = nullptr;
+        stereo->right = nullptr;
+    }
+}
+
+// Deliver the next matched pair, if the two rings hold one. Frames acquired
+// here belong to the consumer until the following call.
+bool video_stereo_acquire_pair(video_stereo_t* stereo, video_stereo_pair_t* pair) {
+    if (!stereo || !stereo->left_ring || !pair) return false;
+
+    if (!stereo->left) stereo->left = frame_ring_acquire_latest(stereo->left_ring);
+    if (!stereo->right) stereo->right = frame_ring_acquire_latest(stereo->right_ring);
+
+    while (stereo->left && stereo->right) {
+        int64_t skew = (int64_t)stereo->left->timestamp - (int64_t)stereo->right->timestamp;
+        uint32_t magnitude = (uint32_t)(skew < 0 ? -skew : skew);
+
+        if (magnitude <= stereo->config.tolerance_us) {
+            pair->left = stereo->left;
+            pair->right = stereo->right;
+            pair->skew_us = (int32_t)skew;
+
+            stereo->left = nullptr;
+            stereo->right = nullptr;
+            stereo->stats.pairs++;
+            stereo->stats.total_skew_us += magnitude;
+            if (magnitude > stereo->stats.max_skew_us) {
+                stereo->stats.max_skew_us = magnitude;
+            }
+            return true;
+        }
+
+        // Only the side that is behind can still catch up
+        if (skew < 0) {
+            stereo->stats.left_dropped++;
+            stereo->left = frame_ring_acquire_latest(stereo->left_ring);
+        } else {
+            stereo->stats.right_dropped++;
+            stereo->right = frame_ring_acquire_latest(stereo->right_ring);
+        }
+    }
+
+    return false;
+}
+
+// ============================================================================
+// Status and Statistics Functions
+// ============================================================================
+
+video_stereo_stats_t video_stereo_get_stats(video_stereo_t* stereo) {
+    if (stereo) {
+        return stereo->stats;
+    }
+    video_stereo_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+void video_stereo_print_stats(video_stereo_t* stereo) {
+    if (!stereo) return;
+
+    Serial.println("=== Stereo Pairing Statistics ===");
+    Serial.printf("Tolerance: %lu us\n", stereo->config.tolerance_us);
+    Serial.printf("Pairs: %lu\n", stereo->stats.pairs);
+    Serial.printf("Left Dropped: %lu\n", stereo->stats.left_dropped);
+    Serial.printf("Right Dropped: %lu\n", stereo->stats.right_dropped);
+    if (stereo->stats.pairs > 0) {
+        Serial.printf("Skew: mean %lu us, max %lu us\n",
+                      (uint32_t)(stereo->stats.total_skew_us / stereo->stats.pairs),
+                      stereo->stats.max_skew_us);
+    }
+    Serial.println("=================================");
+}
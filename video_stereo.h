@@ -0,0 +1,77 @@
+#ifndef VIDEO_STEREO_H
+#define VIDEO_STEREO_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "frame_ring.h"
+
+// ============================================================================
+// Stereo Pairing Configuration
+// ============================================================================
+
+#define VIDEO_STEREO_DEFAULT_TOLERANCE_US  8000   // Under half a PAL field (20 ms)
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Stereo pairing configuration
+typedef struct {
+    uint32_t tolerance_us;         // Largest timestamp difference accepted as one pair
+} video_stereo_config_t;
+
+// Left and right frames captured together, handed downstream as one unit.
+// Both stay valid until the next video_stereo_acquire_pair() call.
+typedef struct {
+    frame_buffer_t* left;
+    frame_buffer_t* right;
+    int32_t skew_us;               // Left timestamp minus right timestamp
+} video_stereo_pair_t;
+
+// Stereo pairing statistics
+typedef struct {
+    uint32_t pairs;                // Pairs delivered
+    uint32_t left_dropped;         // Left frames with no right frame close enough
+    uint32_t right_dropped;        // Right frames with no left frame close enough
+    uint32_t max_skew_us;          // Largest |skew| of a delivered pair
+    uint64_t total_skew_us;        // Sum of |skew| over delivered pairs
+} video_stereo_stats_t;
+
+// Pairs the newest frames of two frame rings by timestamp
+// One frame per side is held while it waits for a partner. When the two held
+// frames are too far apart the older one can never match anything newer, so it
+// is dropped and replaced by that side's next frame.
+typedef struct {
+    video_stereo_config_t config;
+    frame_ring_t* left_ring;
+    frame_ring_t* right_ring;
+    frame_buffer_t* left;          // Held left frame (NULL = none)
+    frame_buffer_t* right;         // Held right frame (NULL = none)
+    video_stereo_stats_t stats;
+} video_stereo_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core pairing functions (consumer side of both rings)
+bool video_stereo_init(video_stereo_t* stereo, const video_stereo_config_t* config,
+                       frame_ring_t* left_ring, frame_ring_t* right_ring);
+void video_stereo_deinit(video_stereo_t* stereo);
+void video_stereo_reset(video_stereo_t* stereo);
+bool video_stereo_acquire_pair(video_stereo_t* stereo, video_stereo_pair_t* pair);
+
+// Status and statistics functions
+video_stereo_stats_t video_stereo_get_stats(video_stereo_t* stereo);
+void video_stereo_print_stats(video_stereo_t* stereo);
+
+// ============================================================================
+// Default Configuration
+// ============================================================================
+
+static const video_stereo_config_t VIDEO_STEREO_DEFAULT_CONFIG = {
+    .tolerance_us = VIDEO_STEREO_DEFAULT_TOLERANCE_US
+};
+
+#endif // VIDEO_STEREO_H
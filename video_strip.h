@@ -0,0 +1,120 @@
+#ifndef VIDEO_STRIP_H
+#define VIDEO_STRIP_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "video_image.h"
+
+// ============================================================================
+// Strip Processing Configuration
+// ============================================================================
+
+#define VIDEO_STRIP_MAX_STAGES     8         // Stages per chain
+#define VIDEO_STRIP_DEFAULT_ROWS   32        // Rows per strip (fastest in video_strip_run_benchmark)
+#define VIDEO_STRIP_MAX_CONTEXT    32        // Largest vertical context a stage may declare
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Stage function: write rows [first_row, first_row + rows) of dst from src
+// Both views hold the same frame rows: the strip plus up to the stage's
+// declared context above and below it, cut where the frame ends. A stage
+// clamps its taps to the view, which is clamping to the frame edge. The
+// source rows are always complete when it is called. `user` is the pointer
+// given to video_strip_add_stage().
+typedef void (*video_strip_stage_fn)(const video_image_t* src, const video_image_t* dst,
+                                     uint16_t first_row, uint16_t rows, void* user);
+
+// Per-stage statistics
+typedef struct {
+    uint32_t calls;                // Strips processed
+    uint32_t rows;                 // Rows written
+    uint64_t busy_us;              // Time inside the stage function
+} video_strip_stage_stats_t;
+
+typedef struct {
+    const char* name;
+    video_strip_stage_fn process;
+    void* user;
+    uint8_t context_rows;          // Source rows needed above and below each output row
+    uint8_t format;                // VIDEO_PIXEL_* of the rows it writes
+    video_strip_stage_stats_t stats;
+} video_strip_stage_t;
+
+// Rows of the image between two stages
+// Only the rows still to be read are kept: when the writer reaches the end of
+// the buffer, the rows its reader still needs move to the front.
+typedef struct {
+    uint8_t* data;
+    uint32_t stride;
+    uint16_t capacity;             // Rows allocated
+    uint16_t base;                 // Frame row held in buffer row 0
+} video_strip_buffer_t;
+
+// Strip configuration
+typedef struct {
+    uint16_t strip_rows;           // Rows per strip (0 = whole frame per stage)
+} video_strip_config_t;
+
+// Chain statistics
+typedef struct {
+    uint32_t frames;               // Frames run through the chain
+    uint32_t strips;               // Scheduling steps over all frames
+    uint32_t last_frame_us;
+    uint32_t max_frame_us;
+    uint32_t buffer_bytes;         // Intermediate rows allocated
+    uint32_t slides;               // Times retained rows moved to a buffer's front
+} video_strip_stats_t;
+
+// Chain of stages run strip by strip
+// The first stage reads the source frame and the last writes the output
+// frame; between them each stage writes into a buffer of a strip plus the
+// context rows around it, so no intermediate frame is stored. Each strip is
+// taken through every stage before the next one is started, so the rows one
+// stage writes are still in cache when the next stage reads them. A stage
+// that needs context below its output rows trails the stage before it by
+// that many rows.
+typedef struct {
+    video_strip_config_t config;
+    video_strip_stage_t stages[VIDEO_STRIP_MAX_STAGES];
+    uint8_t stage_count;
+    video_strip_buffer_t buffers[VIDEO_STRIP_MAX_STAGES - 1];  // After each stage but the last
+    uint16_t buffer_width;         // Frame size the buffers were built for (0 = none)
+    uint16_t buffer_height;
+    video_strip_stats_t stats;
+} video_strip_chain_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core strip functions (deinit frees the intermediate buffers)
+bool video_strip_init(video_strip_chain_t* chain, const video_strip_config_t* config);
+void video_strip_deinit(video_strip_chain_t* chain);
+bool video_strip_add_stage(video_strip_chain_t* chain, const char* name, video_strip_stage_fn process,
+                           uint8_t context_rows, uint8_t format, void* user);
+void video_strip_set_rows(video_strip_chain_t* chain, uint16_t strip_rows);
+
+// Run one frame from src to dst (same size; dst in the last stage's format).
+// Buffers are allocated on the first run and again when the frame size, the
+// strip size or the stages change. A single stage with context may not
+// write over its own source.
+bool video_strip_run(video_strip_chain_t* chain, const video_image_t* src, const video_image_t* dst);
+
+// Status and statistics functions
+video_strip_stats_t video_strip_get_stats(video_strip_chain_t* chain);
+void video_strip_reset_stats(video_strip_chain_t* chain);
+void video_strip_print_stats(video_strip_chain_t* chain);
+void video_strip_run_benchmark(uint16_t frames);
+
+// ============================================================================
+// Default Configuration
+// ============================================================================
+
+static const video_strip_config_t VIDEO_STRIP_DEFAULT_CONFIG = {
+    .strip_rows = VIDEO_STRIP_DEFAULT_ROWS
+};
+
+#endif // VIDEO_STRIP_H
@@ -0,0 +1,516 @@
+#include "video_tiles.h"
+#include "video_remap.h"
+#include "video_sharpen.h"
+#include <Arduino.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+#define DEQUE_MASK (VIDEO_TILES_DEQUE_SLOTS - 1)
+
+// Owner only
+static void deque_push(video_tiles_deque_t* deque, uint16_t tile) {
+    int32_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED);
+    deque->slots[bottom & DEQUE_MASK] = tile;
+    __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELEASE);
+}
+
+// Owner only; races a thief only for the last tile
+static bool deque_pop(video_tiles_deque_t* deque, uint16_t* tile) {
+    int32_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_RELAXED) - 1;
+    __atomic_store_n(&deque->bottom, bottom, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int32_t top = __atomic_load_n(&deque->top, __ATOMIC_RELAXED);
+
+    if (top > bottom) {
+        __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+        return false;
+    }
+
+    *tile = deque->slots[bottom & DEQUE_MASK];
+    if (top < bottom) return true;
+
+    bool won = __atomic_compare_exchange_n(&deque->top, &top, top + 1, false,
+                                           __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+    __atomic_store_n(&deque->bottom, bottom + 1, __ATOMIC_RELAXED);
+    return won;
+}
+
+// Any other worker
+static bool deque_steal(video_tiles_deque_t* deque, uint16_t* tile) {
+    int32_t top = __atomic_load_n(&deque->top, __ATOMIC_ACQUIRE);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    int32_t bottom = __atomic_load_n(&deque->bottom, __ATOMIC_ACQUIRE);
+
+    if (top >= bottom) return false;
+
+    *tile = deque->slots[top & DEQUE_MASK];
+    return __atomic_compare_exchange_n(&deque->top, &top, top + 1, false,
+                                       __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+// Take the next batch from the injector: run the first tile, queue the rest.
+// They are pushed last-first so the owner continues in raster order while
+// thieves take the far end of the batch.
+static bool take_batch(video_tiles_t* scheduler, video_tiles_worker_t* worker, uint16_t* tile) {
+    uint32_t first = __atomic_fetch_add(&scheduler->next_tile, scheduler->config.batch, __ATOMIC_RELAXED);
+    if (first >= scheduler->tile_count) return false;
+
+    uint32_t end = first + scheduler->config.batch;
+    if (end > scheduler->tile_count) end = scheduler->tile_count;
+
+    for (uint32_t t = end - 1; t > first; t--) {
+        deque_push(&worker->deque, (uint16_t)t);
+    }
+    worker->stats.batches++;
+    *tile = (uint16_t)first;
+    return true;
+}
+
+static bool steal_tile(video_tiles_t* scheduler, video_tiles_worker_t* worker, uint16_t* tile) {
+    uint8_t count = scheduler->config.workers;
+    for (uint8_t i = 1; i < count; i++) {
+        video_tiles_worker_t* victim = &scheduler->workers[(worker->index + i) % count];
+        if (deque_steal(&victim->deque, tile)) {
+            worker->stats.steals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void run_tile(video_tiles_t* scheduler, video_tiles_worker_t* worker, uint16_t tile) {
+    uint32_t start = micros();
+    scheduler->stage(&scheduler->src, &scheduler->dst, &scheduler->tiles[tile], scheduler->user);
+    worker->stats.busy_us += micros() - start;
+    worker->stats.tiles++;
+
+    // The last tile wakes the workers waiting for it
+    if (__atomic_sub_fetch(&scheduler->remaining, 1, __ATOMIC_ACQ_REL) == 0) {
+        pthread_mutex_lock(&scheduler->lock);
+        pthread_cond_broadcast(&scheduler->done_cond);
+        pthread_mutex_unlock(&scheduler->lock);
+    }
+}
+
+// Until every tile is finished: own deque, then injector, then other deques.
+// Once all three are empty the tiles left are held by other workers, who
+// finish them, so this one sleeps until the last tile wakes it.
+static void work(video_tiles_t* scheduler, video_tiles_worker_t* worker) {
+    uint16_t tile;
+    while (deque_pop(&worker->deque, &tile) ||
+           take_batch(scheduler, worker, &tile) ||
+           steal_tile(scheduler, worker, &tile)) {
+        run_tile(scheduler, worker, tile);
+    }
+
+    pthread_mutex_lock(&scheduler->lock);
+    if (__atomic_load_n(&scheduler->remaining, __ATOMIC_ACQUIRE) > 0) {
+        worker->stats.idle_waits++;
+        do {
+            pthread_cond_wait(&scheduler->done_cond, &scheduler->lock);
+        } while (__atomic_load_n(&scheduler->remaining, __ATOMIC_ACQUIRE) > 0);
+    }
+    pthread_mutex_unlock(&scheduler->lock);
+}
+
+static void* worker_main(void* arg) {
+    video_tiles_worker_t* worker = (video_tiles_worker_t*)arg;
+    video_tiles_t* scheduler = worker->scheduler;
+    uint32_t seen = 0;
+
+    while (true) {
+        pthread_mutex_lock(&scheduler->lock);
+        while (scheduler->generation == seen && !scheduler->quit) {
+            pthread_cond_wait(&scheduler->start_cond, &scheduler->lock);
+        }
+        bool quit = scheduler->quit;
+        seen = scheduler->generation;
+        pthread_mutex_unlock(&scheduler->lock);
+
+        if (quit) break;
+
+        work(scheduler, worker);
+
+        pthread_mutex_lock(&scheduler->lock);
+        if (--scheduler->active == 0) {
+            pthread_cond_broadcast(&scheduler->done_cond);
+        }
+        pthread_mutex_unlock(&scheduler->lock);
+    }
+    return nullptr;
+}
+
+static void stop_threads(video_tiles_t* scheduler) {
+    pthread_mutex_lock(&scheduler->lock);
+    scheduler->quit = true;
+    pthread_cond_broadcast(&scheduler->start_cond);
+    pthread_mutex_unlock(&scheduler->lock);
+
+    for (uint8_t w = 1; w <= scheduler->threads; w++) {
+        pthread_join(scheduler->workers[w].thread, nullptr);
+    }
+    scheduler->threads = 0;
+}
+
+// Split dst into tiles; false if there are more than VIDEO_TILES_MAX_TILES
+static bool build_tiles(video_tiles_t* scheduler, uint8_t halo) {
+    const video_image_t* src = &scheduler->src;
+    const video_image_t* dst = &scheduler->dst;
+    bool same_size = (src->width == dst->width && src->height == dst->height);
+    bool pairs = video_image_is_422(src->format);
+    uint16_t tile_width = scheduler->config.tile_width;
+    uint16_t tile_height = scheduler->config.tile_height;
+    uint16_t count = 0;
+
+    for (uint16_t y = 0; y < dst->height; y += tile_height) {
+        for (uint16_t x = 0; x < dst->width; x += tile_width) {
+            if (count >= VIDEO_TILES_MAX_TILES) return false;
+
+            video_tile_t* tile = &scheduler->tiles[count++];
+            tile->x = x;
+            tile->y = y;
+            tile->width = (dst->width - x < tile_width) ? dst->width - x : tile_width;
+            tile->height = (dst->height - y < tile_height) ? dst->height - y : tile_height;
+
+            if (same_size) {
+                uint16_t x1 = (dst->width - (x + tile->width) > halo) ? x + tile->width + halo : dst->width;
+                uint16_t y1 = (dst->height - (y + tile->height) > halo) ? y + tile->height + halo : dst->height;
+                tile->in_x = (x > halo) ? x - halo : 0;
+                tile->in_y = (y > halo) ? y - halo : 0;
+                if (pairs) {
+                    // Whole pixel pairs, so video_tiles_source() can crop exactly
+                    tile->in_x &= ~1;
+                    if ((x1 & 1) && x1 < dst->width) x1++;
+                }
+                tile->in_width = x1 - tile->in_x;
+                tile->in_height = y1 - tile->in_y;
+            } else {
+                tile->in_x = 0;
+                tile->in_y = 0;
+                tile->in_width = src->width;
+                tile->in_height = src->height;
+            }
+        }
+    }
+
+    scheduler->tile_count = count;
+    return true;
+}
+
+// ============================================================================
+// Core Scheduler Functions
+// ============================================================================
+
+bool video_tiles_init(video_tiles_t* scheduler, const video_tiles_config_t* config) {
+    if (!scheduler || !config) return false;
+
+    if (config->workers == 0 || config->workers > VIDEO_TILES_MAX_WORKERS ||
+        config->tile_width == 0 || config->tile_height == 0 ||
+        config->batch == 0 || config->batch > VIDEO_TILES_DEQUE_SLOTS) {
+        Serial.println("ERROR: Invalid tile scheduler configuration");
+        return false;
+    }
+
+    memset(scheduler, 0, sizeof(video_tiles_t));
+    scheduler->config = *config;
+
+    scheduler->tiles = (video_tile_t*)malloc(VIDEO_TILES_MAX_TILES * sizeof(video_tile_t));
+    if (!scheduler->tiles) {
+        Serial.println("ERROR: Failed to allocate tile list");
+        return false;
+    }
+
+    pthread_mutex_init(&scheduler->lock, nullptr);
+    pthread_cond_init(&scheduler->start_cond, nullptr);
+    pthread_cond_init(&scheduler->done_cond, nullptr);
+
+    for (uint8_t w = 0; w < config->workers; w++) {
+        scheduler->workers[w].scheduler = scheduler;
+        scheduler->workers[w].index = w;
+    }
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, VIDEO_TILES_STACK_SIZE);
+
+    // Worker 0 is whichever thread calls video_tiles_run()
+    bool started = true;
+    for (uint8_t w = 1; w < config->workers; w++) {
+        if (pthread_create(&scheduler->workers[w].thread, &attr, worker_main, &scheduler->workers[w]) != 0) {
+            started = false;
+            break;
+        }
+        scheduler->threads++;
+    }
+    pthread_attr_destroy(&attr);
+
+    if (!started) {
+        Serial.println("ERROR: Failed to start tile worker");
+        video_tiles_deinit(scheduler);
+        return false;
+    }
+
+    Serial.printf("Tile scheduler initialized: %d workers, %dx%d tiles, batch %d\n",
+                  config->workers, config->tile_width, config->tile_height, config->batch);
+    return true;
+}
+
+void video_tiles_deinit(video_tiles_t* scheduler) {
+    if (!scheduler || !scheduler->tiles) return;
+
+    stop_threads(scheduler);
+
+    pthread_cond_destroy(&scheduler->done_cond);
+    pthread_cond_destroy(&scheduler->start_cond);
+    pthread_mutex_destroy(&scheduler->lock);
+    free(scheduler->tiles);
+
+    memset(scheduler, 0, sizeof(video_tiles_t));
+}
+
+bool video_tiles_run(video_tiles_t* scheduler, video_tiles_stage_fn stage, uint8_t halo,
+                     const video_image_t* src, const video_image_t* dst, void* user) {
+    if (!scheduler || !scheduler->tiles || !stage ||
+        !video_image_is_valid(src) || !video_image_is_valid(dst)) {
+        return false;
+    }
+
+    if (halo > 0 && src->data == dst->data) {
+        Serial.println("ERROR: Tile stage with a halo cannot run in place");
+        return false;
+    }
+
+    scheduler->stage = stage;
+    scheduler->user = user;
+    scheduler->src = *src;
+    scheduler->dst = *dst;
+    if (!build_tiles(scheduler, halo)) {
+        Serial.println("ERROR: Too many tiles for the frame");
+        return false;
+    }
+
+    for (uint8_t w = 0; w < scheduler->config.workers; w++) {
+        scheduler->workers[w].deque.top = 0;
+        scheduler->workers[w].deque.bottom = 0;
+    }
+    scheduler->next_tile = 0;
+    scheduler->remaining = scheduler->tile_count;
+
+    uint32_t start = micros();
+
+    // The mutex publishes the run set up above to the workers
+    pthread_mutex_lock(&scheduler->lock);
+    scheduler->generation++;
+    scheduler->active = scheduler->threads;
+    pthread_cond_broadcast(&scheduler->start_cond);
+    pthread_mutex_unlock(&scheduler->lock);
+
+    work(scheduler, &scheduler->workers[0]);
+
+    pthread_mutex_lock(&scheduler->lock);
+    while (scheduler->active > 0) {
+        pthread_cond_wait(&scheduler->done_cond, &scheduler->lock);
+    }
+    pthread_mutex_unlock(&scheduler->lock);
+
+    uint32_t elapsed = micros() - start;
+    scheduler->stats.frames++;
+    scheduler->stats.tiles += scheduler->tile_count;
+    scheduler->stats.elapsed_us += elapsed;
+    if (elapsed > scheduler->stats.max_frame_us) {
+        scheduler->stats.max_frame_us = elapsed;
+    }
+    return true;
+}
+
+// ============================================================================
+// Status and Statistics Functions
+// ============================================================================
+
+video_tiles_stats_t video_tiles_get_stats(video_tiles_t* scheduler) {
+    if (scheduler) {
+        return scheduler->stats;
+    }
+    video_tiles_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+video_tiles_worker_stats_t video_tiles_get_worker_stats(video_tiles_t* scheduler, uint8_t worker) {
+    if (scheduler && worker < scheduler->config.workers) {
+        return scheduler->workers[worker].stats;
+    }
+    video_tiles_worker_stats_t empty_stats = {0};
+    return empty_stats;
+}
+
+void video_tiles_reset_stats(video_tiles_t* scheduler) {
+    if (!scheduler) return;
+
+    memset(&scheduler->stats, 0, sizeof(video_tiles_stats_t));
+    for (uint8_t w = 0; w < VIDEO_TILES_MAX_WORKERS; w++) {
+        memset(&scheduler->workers[w].stats, 0, sizeof(video_tiles_worker_stats_t));
+    }
+}
+
+void video_tiles_print_stats(video_tiles_t* scheduler) {
+    if (!scheduler) return;
+
+    video_tiles_stats_t* stats = &scheduler->stats;
+    uint64_t elapsed = stats->elapsed_us ? stats->elapsed_us : 1;
+    uint32_t frames = stats->frames ? stats->frames : 1;
+
+    Serial.println("=== Tile Scheduler Statistics ===");
+    Serial.printf("Workers: %d, %dx%d tiles, batch %d\n", scheduler->config.workers,
+                  scheduler->config.tile_width, scheduler->config.tile_height, scheduler->config.batch);
+    Serial.printf("Runs: %lu (%lu tiles), mean %lu us, max %lu us\n",
+                  stats->frames, stats->tiles, (uint32_t)(stats->elapsed_us / frames), stats->max_frame_us);
+
+    // Imbalance: the busiest worker against the mean (1.00 = perfectly even)
+    uint64_t busy_total = 0;
+    uint64_t busy_max = 0;
+    for (uint8_t w = 0; w < scheduler->config.workers; w++) {
+        video_tiles_worker_stats_t* ws = &scheduler->workers[w].stats;
+        busy_total += ws->busy_us;
+        if (ws->busy_us > busy_max) busy_max = ws->busy_us;
+        Serial.printf("Worker %d: %lu tiles (%lu stolen, %lu batches), busy %.1f%%, idle waits %lu\n",
+                      w, ws->tiles, ws->steals, ws->batches, ws->busy_us * 100.0f / elapsed, ws->idle_waits);
+    }
+    if (busy_total > 0) {
+        Serial.printf("Imbalance: %.2f\n", (float)busy_max * scheduler->config.workers / busy_total);
+    }
+    Serial.println("=================================");
+}
+
+// ============================================================================
+// Benchmark
+// ============================================================================
+
+static void bench_remap_tile(const video_image_t* src, const video_image_t* dst,
+                             const video_tile_t* tile, void* user) {
+    video_remap_apply_region((const video_remap_t*)user, src, dst, tile->x, tile->y, tile->width, tile->height);
+}
+
+static uint32_t bench_checksum(const video_image_t* image) {
+    uint32_t sum = 0;
+    for (uint16_t r = 0; r < image->height; r++) {
+        const uint8_t* p = video_image_row(image, r);
+        for (uint32_t i = 0; i < video_image_row_bytes(image); i++) {
+            sum = (sum << 1 | sum >> 31) ^ p[i];
+        }
+    }
+    return sum;
+}
+
+typedef struct {
+    const char* name;
+    video_tiles_stage_fn stage;
+    uint8_t halo;
+    const video_image_t* src;
+    const video_image_t* dst;
+    void* user;
+} bench_case_t;
+
+void video_tiles_run_benchmark(uint16_t frames) {
+    const uint16_t width = 720;
+    const uint16_t height = 576;
+
+    if (frames == 0) frames = 1;
+
+    uint8_t* uyvy_in = (uint8_t*)malloc((size_t)width * height * 2);
+    uint8_t* uyvy_out = (uint8_t*)malloc((size_t)width * height * 2);
+    uint8_t* rgb_in = (uint8_t*)malloc((size_t)width * height * 2);
+    uint8_t* rgb_out = (uint8_t*)malloc((size_t)width * height * 2);
+    video_tiles_t* scheduler = (video_tiles_t*)malloc(sizeof(video_tiles_t));
+    video_remap_t* remap = (video_remap_t*)malloc(sizeof(video_remap_t));
+    video_sharpen_t* sharpen = (video_sharpen_t*)malloc(sizeof(video_sharpen_t));
+    if (!uyvy_in || !uyvy_out || !rgb_in || !rgb_out || !scheduler || !remap || !sharpen) {
+        Serial.println("ERROR: Failed to allocate benchmark buffers");
+        if (uyvy_in) free(uyvy_in);
+        if (uyvy_out) free(uyvy_out);
+        if (rgb_in) free(rgb_in);
+        if (rgb_out) free(rgb_out);
+        if (scheduler) free(scheduler);
+        if (remap) free(remap);
+        if (sharpen) free(sharpen);
+        return;
+    }
+
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < (uint32_t)width * height; i++) {
+        seed = seed * 1103515245 + 12345;
+        uyvy_in[2 * i] = 96 + (i % width) / 16;
+        uyvy_in[2 * i + 1] = 64 + (i % width) / 8 + ((seed >> 16) & 31);
+        ((uint16_t*)rgb_in)[i] = (uint16_t)(seed >> 8);
+    }
+
+    video_image_t uyvy_src = video_image_make(uyvy_in, width, height, VIDEO_PIXEL_UYVY);
+    video_image_t uyvy_dst = video_image_make(uyvy_out, width, height, VIDEO_PIXEL_UYVY);
+    video_image_t rgb_src = video_image_make(rgb_in, width, height, VIDEO_PIXEL_RGB565);
+    video_image_t rgb_dst = video_image_make(rgb_out, width, height, VIDEO_PIXEL_RGB565);
+
+    video_remap_config_t remap_config = VIDEO_REMAP_DEFAULT_CONFIG;
+    remap_config.dst_width = width;
+    remap_config.dst_height = height;
+    bool remap_ready = video_remap_init(remap, &remap_config);
+    bool have_remap = remap_ready && video_remap_build_radial(remap, -0.2f, 0.0f, 1.1f);
+
+    video_sharpen_config_t sharpen_config = VIDEO_SHARPEN_DEFAULT_CONFIG;
+    sharpen_config.width = width;
+    bool have_sharpen = video_sharpen_init(sharpen, &sharpen_config);
+
+    const bench_case_t cases[] = {
+        { "unsharp", video_sharpen_tile, sharpen_config.radius, &uyvy_src, &uyvy_dst, sharpen },
+        { "remap", bench_remap_tile, 0, &rgb_src, &rgb_dst, remap },
+    };
+
+    Serial.println("=== Tile Scheduler Benchmark ===");
+    Serial.printf("%dx%d frames, %d runs per setting\n", width, height, frames);
+
+    for (uint8_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const bench_case_t* bc = &cases[c];
+        if (bc->stage == bench_remap_tile && !have_remap) continue;
+        if (bc->stage == video_sharpen_tile && !have_sharpen) continue;
+
+        uint32_t baseline_us = 0;
+        uint32_t reference = 0;
+        for (uint8_t workers = 1; workers <= VIDEO_TILES_MAX_WORKERS; workers *= 2) {
+            video_tiles_config_t config = VIDEO_TILES_DEFAULT_CONFIG;
+            config.workers = workers;
+            if (!video_tiles_init(scheduler, &config)) break;
+
+            video_tiles_run(scheduler, bc->stage, bc->halo, bc->src, bc->dst, bc->user);   // Warm up
+            video_tiles_reset_stats(scheduler);
+            for (uint16_t f = 0; f < frames; f++) {
+                video_tiles_run(scheduler, bc->stage, bc->halo, bc->src, bc->dst, bc->user);
+            }
+
+            uint32_t per_frame = (uint32_t)(scheduler->stats.elapsed_us / frames);
+            uint32_t checksum = bench_checksum(bc->dst);
+            if (workers == 1) {
+                baseline_us = per_frame;
+                reference = checksum;
+            }
+            Serial.printf("%-8s %d workers: %lu us per frame, %.2fx, output %s\n",
+                          bc->name, workers, per_frame,
+                          per_frame ? (float)baseline_us / per_frame : 0.0f,
+                          checksum == reference ? "identical" : "DIFFERS");
+
+            if (workers * 2 > VIDEO_TILES_MAX_WORKERS) {
+                video_tiles_print_stats(scheduler);
+            }
+            video_tiles_deinit(scheduler);
+        }
+    }
+
+    if (have_sharpen) video_sharpen_deinit(sharpen);
+    if (remap_ready) video_remap_deinit(remap);
+    free(sharpen);
+    free(remap);
+    free(scheduler);
+    free(rgb_out);
+    free(rgb_in);
+    free(uyvy_out);
+    free(uyvy_in);
+}
@@ -0,0 +1,156 @@
+#ifndef VIDEO_TILES_H
+#define VIDEO_TILES_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "video_image.h"
+
+// ============================================================================
+// Tile Scheduler Configuration
+// ============================================================================
+
+#define VIDEO_TILES_MAX_WORKERS    8         // Threads, including the caller's
+#define VIDEO_TILES_MAX_TILES      1024      // Tiles per frame
+#define VIDEO_TILES_DEQUE_SLOTS    64        // Per-worker deque (power of two, >= batch)
+#define VIDEO_TILES_STACK_SIZE     8192      // Worker thread stack (bytes)
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// One tile of the output and the part of the source it may read
+// The source rectangle is the output rectangle grown by the halo and clamped
+// to the frame (widened to whole pixel pairs for 4:2:2 sources). When source
+// and output differ in size it is the whole source.
+typedef struct {
+    uint16_t x;                    // Output rectangle
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+    uint16_t in_x;                 // Source rectangle
+    uint16_t in_y;
+    uint16_t in_width;
+    uint16_t in_height;
+} video_tile_t;
+
+// Stage function: write the tile's output rectangle of dst, reading src only
+// inside the tile's source rectangle. Runs on any worker, several at once.
+// `user` is the pointer passed to video_tiles_run().
+typedef void (*video_tiles_stage_fn)(const video_image_t* src, const video_image_t* dst,
+                                     const video_tile_t* tile, void* user);
+
+// Work-stealing deque of tile indices (Chase-Lev, fixed size)
+// The owner pushes and pops at the bottom; other workers steal from the top.
+typedef struct {
+    volatile int32_t top;
+    volatile int32_t bottom;
+    uint16_t slots[VIDEO_TILES_DEQUE_SLOTS];
+} video_tiles_deque_t;
+
+// Per-worker statistics
+typedef struct {
+    uint32_t tiles;                // Tiles processed
+    uint32_t steals;               // ... of which taken from another worker's deque
+    uint32_t batches;              // Batches taken from the injector
+    uint32_t idle_waits;           // Times it slept while the last tiles ran elsewhere
+    uint64_t busy_us;              // Time inside the stage function
+} video_tiles_worker_stats_t;
+
+typedef struct video_tiles video_tiles_t;
+
+typedef struct {
+    video_tiles_t* scheduler;
+    uint8_t index;                 // 0 is the caller's thread
+    pthread_t thread;
+    video_tiles_deque_t deque;
+    video_tiles_worker_stats_t stats;
+} video_tiles_worker_t;
+
+// Scheduler configuration
+typedef struct {
+    uint8_t workers;               // Threads including the caller (1..VIDEO_TILES_MAX_WORKERS)
+    uint16_t tile_width;           // Output tile size
+    uint16_t tile_height;
+    uint8_t batch;                 // Tiles taken from the injector at a time
+} video_tiles_config_t;
+
+// Scheduler statistics
+typedef struct {
+    uint32_t frames;               // Stage runs
+    uint32_t tiles;                // Tiles over all runs
+    uint64_t elapsed_us;           // Wall time over all runs
+    uint32_t max_frame_us;
+} video_tiles_stats_t;
+
+// Runs one stage over all tiles of a frame on a pool of workers
+// Tiles start in a global injector in raster order. A worker takes a batch of
+// neighbouring tiles into its own deque and works through it; a worker with
+// an empty deque and an empty injector steals from the top of another
+// worker's deque. A worker that finds nothing left to take sleeps until the
+// tiles still running elsewhere are done. The caller's thread works as
+// worker 0 and returns when every tile is done.
+struct video_tiles {
+    video_tiles_config_t config;
+    video_tiles_worker_t workers[VIDEO_TILES_MAX_WORKERS];
+    video_tile_t* tiles;           // VIDEO_TILES_MAX_TILES entries
+
+    // Current run
+    video_tiles_stage_fn stage;
+    void* user;
+    video_image_t src;
+    video_image_t dst;
+    uint16_t tile_count;
+    volatile uint32_t next_tile;   // Injector: first tile not yet handed out
+    volatile uint32_t remaining;   // Tiles not yet finished
+
+    // Worker wake-up
+    pthread_mutex_t lock;
+    pthread_cond_t start_cond;
+    pthread_cond_t done_cond;      // Broadcast when the last tile finishes or the last worker leaves
+    uint32_t generation;           // Incremented for every run
+    uint8_t active;                // Worker threads still in the current run
+    bool quit;
+    uint8_t threads;               // Worker threads started
+
+    video_tiles_stats_t stats;
+};
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core scheduler functions (init starts the worker threads, deinit joins them)
+bool video_tiles_init(video_tiles_t* scheduler, const video_tiles_config_t* config);
+void video_tiles_deinit(video_tiles_t* scheduler);
+
+// Run a stage over every tile of dst. A stage with a halo reads neighbouring
+// tiles' source pixels, so it may not write over its own source.
+bool video_tiles_run(video_tiles_t* scheduler, video_tiles_stage_fn stage, uint8_t halo,
+                     const video_image_t* src, const video_image_t* dst, void* user);
+
+// The tile's source rectangle as a view of src
+static inline video_image_t video_tiles_source(const video_image_t* src, const video_tile_t* tile) {
+    return video_image_crop(src, tile->in_x, tile->in_y, tile->in_width, tile->in_height);
+}
+
+// Status and statistics functions
+video_tiles_stats_t video_tiles_get_stats(video_tiles_t* scheduler);
+video_tiles_worker_stats_t video_tiles_get_worker_stats(video_tiles_t* scheduler, uint8_t worker);
+void video_tiles_reset_stats(video_tiles_t* scheduler);
+void video_tiles_print_stats(video_tiles_t* scheduler);
+void video_tiles_run_benchmark(uint16_t frames);
+
+// ============================================================================
+// Default Configuration
+// ============================================================================
+
+static const video_tiles_config_t VIDEO_TILES_DEFAULT_CONFIG = {
+    .workers = 2,
+    .tile_width = 64,
+    .tile_height = 64,
+    .batch = 4
+};
+
+#endif // VIDEO_TILES_H
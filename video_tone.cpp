@@ -0,0 +1,257 @@
+#include "video_tone.h"
+#include <Arduino.h>
+#include <math.h>
+
+// ============================================================================
+// Internal Helper Functions
+// ============================================================================
+
+static inline uint8_t clamp_u8(int value) {
+    return (value < 0) ? 0 : (value > 255) ? 255 : value;
+}
+
+// Build both lookup tables from a set of parameters
+static void build_table(video_tone_table_t* table, const video_tone_params_t* p) {
+    int offset = (int)p->brightness - VIDEO_TONE_NEUTRAL;
+    int gamma = p->gamma ? p->gamma : VIDEO_TONE_GAMMA_LINEAR;
+    float inv_gamma = (float)VIDEO_TONE_GAMMA_LINEAR / gamma;
+
+    for (int i = 0; i < 256; i++) {
+        // Contrast pivots around mid-grey, brightness shifts the result
+        int v = (((i - 128) * p->contrast) >> 7) + 128 + offset;
+        v = clamp_u8(v);
+
+        if (gamma != VIDEO_TONE_GAMMA_LINEAR) {
+            v = (int)(255.0f * powf(v / 255.0f, inv_gamma) + 0.5f);
+        }
+        table->luma_lut[i] = clamp_u8(v);
+
+        // Saturation scales chroma distance from the neutral axis
+        table->chroma_lut[i] = clamp_u8((((i - 128) * p->saturation) >> 7) + 128);
+    }
+
+    table->params = *p;
+    table->identity = (p->brightness == VIDEO_TONE_NEUTRAL &&
+                       p->contrast == VIDEO_TONE_NEUTRAL &&
+                       p->saturation == VIDEO_TONE_NEUTRAL &&
+                       gamma == VIDEO_TONE_GAMMA_LINEAR);
+}
+
+// ============================================================================
+// Core Tone Curve Functions
+// ============================================================================
+
+static uint32_t pack_params(const video_tone_params_t* params) {
+    uint32_t packed;
+    memcpy(&packed, params, sizeof(packed));
+    return packed;
+}
+
+void video_tone_init(video_tone_t* tone, const video_tone_params_t* params) {
+    if (!tone) return;
+
+    memset(tone, 0, sizeof(video_tone_t));
+    build_table(&tone->tables[0], params ? params : &VIDEO_TONE_DEFAULT_PARAMS);
+    tone->pending = pack_params(&tone->tables[0].params);
+    tone->active = 0;
+    tone->generation = 1;
+}
+
+// The parameters are four bytes, so the request is stored in one atomic word
+// and a builder always reads a whole set
+bool video_tone_set_params(video_tone_t* tone, const video_tone_params_t* params) {
+    if (!tone || !params) return false;
+
+    static_assert(sizeof(video_tone_params_t) == sizeof(uint32_t), "tone parameters must pack into a word");
+    __atomic_store_n(&tone->pending, pack_params(params), __ATOMIC_SEQ_CST);
+    return video_tone_update(tone);
+}
+
+// Build the pending parameters into the idle table and publish it, unless a
+// consumer still holds that table or another thread is building
+bool video_tone_update(video_tone_t* tone) {
+    if (!tone) return false;
+
+    uint8_t idle = 0;
+    if (!__atomic_compare_exchange_n(&tone->building, &idle, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        return false;
+    }
+
+    bool published = false;
+    while (true) {
+        uint8_t current = __atomic_load_n(&tone->active, __ATOMIC_ACQUIRE);
+        uint32_t request = __atomic_load_n(&tone->pending, __ATOMIC_SEQ_CST);
+
+        // Tables are only rebuilt when something actually changed
+        if (request == pack_params(&tone->tables[current].params)) break;
+
+        uint8_t next = current ^ 1;
+        if (__atomic_load_n(&tone->readers[next], __ATOMIC_SEQ_CST) != 0) break;
+
+        // Build into the idle table, then publish it in one store
+        video_tone_params_t params;
+        memcpy(&params, &request, sizeof(params));
+        build_table(&tone->tables[next], &params);
+        __atomic_store_n(&tone->active, next, __ATOMIC_SEQ_CST);
+        tone->generation++;
+        published = true;
+    }
+
+    __atomic_store_n(&tone->building, 0, __ATOMIC_RELEASE);
+    return published;
+}
+
+bool video_tone_is_pending(video_tone_t* tone) {
+    if (!tone) return false;
+    const video_tone_table_t* live = &tone->tables[__atomic_load_n(&tone->active, __ATOMIC_ACQUIRE)];
+    return __atomic_load_n(&tone->pending, __ATOMIC_ACQUIRE) != pack_params(&live->params);
+}
+
+// Count this consumer on the live table. If a swap happens between reading
+// the index and counting, the count may be on a table the builder already
+// found free, so it is undone and the new index taken instead.
+const video_tone_table_t* video_tone_acquire(video_tone_t* tone) {
+    if (!tone) return nullptr;
+
+    while (true) {
+        uint8_t index = __atomic_load_n(&tone->active, __ATOMIC_ACQUIRE);
+        __atomic_add_fetch(&tone->readers[index], 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&tone->active, __ATOMIC_SEQ_CST) == index) {
+            return &tone->tables[index];
+        }
+        __atomic_sub_fetch(&tone->readers[index], 1, __ATOMIC_RELEASE);
+    }
+}
+
+void video_tone_release(video_tone_t* tone, const video_tone_table_t* table) {
+    if (!tone || !table) return;
+    __atomic_sub_fetch(&tone->readers[table - tone->tables], 1, __ATOMIC_RELEASE);
+}
+
+// ============================================================================
+// Per-Line Application
+// ============================================================================
+
+// One pass over a UYVY line. Each 32-bit word holds Cb Y0 Cr Y1 (little endian),
+// so a word takes four lookups and a single store; two words per iteration.
+static inline void IRAM_ATTR map_uyvy(const video_tone_table_t* table, uint8_t* uyvy, uint16_t width) {
+    const uint8_t* ylut = table->luma_lut;
+    const uint8_t* clut = table->chroma_lut;
+    uint32_t words = width / 2;
+    uint32_t i = 0;
+
+    for (; i + 2 <= words; i += 2) {
+        uint8_t* p = uyvy + i * 4;
+        uint32_t w0, w1;
+        memcpy(&w0, p, 4);
+        memcpy(&w1, p + 4, 4);
+
+        w0 = (uint32_t)clut[w0 & 0xFF] |
+             ((uint32_t)ylut[(w0 >> 8) & 0xFF] << 8) |
+             ((uint32_t)clut[(w0 >> 16) & 0xFF] << 16) |
+             ((uint32_t)ylut[w0 >> 24] << 24);
+        w1 = (uint32_t)clut[w1 & 0xFF] |
+             ((uint32_t)ylut[(w1 >> 8) & 0xFF] << 8) |
+             ((uint32_t)clut[(w1 >> 16) & 0xFF] << 16) |
+             ((uint32_t)ylut[w1 >> 24] << 24);
+
+        memcpy(p, &w0, 4);
+        memcpy(p + 4, &w1, 4);
+    }
+
+    for (; i < words; i++) {
+        uint8_t* p = uyvy + i * 4;
+        p[0] = clut[p[0]];
+        p[1] = ylut[p[1]];
+        p[2] = clut[p[2]];
+        p[3] = ylut[p[3]];
+    }
+}
+
+static inline void IRAM_ATTR map_luma(const video_tone_table_t* table, uint8_t* luma, size_t count) {
+    const uint8_t* ylut = table->luma_lut;
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        uint32_t w;
+        memcpy(&w, luma + i, 4);
+        w = (uint32_t)ylut[w & 0xFF] |
+            ((uint32_t)ylut[(w >> 8) & 0xFF] << 8) |
+            ((uint32_t)ylut[(w >> 16) & 0xFF] << 16) |
+            ((uint32_t)ylut[w >> 24] << 24);
+        memcpy(luma + i, &w, 4);
+    }
+
+    for (; i < count; i++) {
+        luma[i] = ylut[luma[i]];
+    }
+}
+
+// Each call maps with one table, even if new parameters are published meanwhile
+void IRAM_ATTR video_tone_apply_uyvy(video_tone_t* tone, uint8_t* uyvy, uint16_t width) {
+    if (!tone || !uyvy) return;
+
+    const video_tone_table_t* table = video_tone_acquire(tone);
+    if (!table->identity) map_uyvy(table, uyvy, width);
+    video_tone_release(tone, table);
+}
+
+void IRAM_ATTR video_tone_apply_luma(video_tone_t* tone, uint8_t* luma, size_t count) {
+    if (!tone || !luma) return;
+
+    const video_tone_table_t* table = video_tone_acquire(tone);
+    if (!table->identity) map_luma(table, luma, count);
+    video_tone_release(tone, table);
+}
+
+// Apply in place to a UYVY, YUYV or grey view
+void video_tone_apply_image(video_tone_t* tone, const video_image_t* image) {
+    if (!tone || !video_image_is_valid(image)) return;
+
+    // The whole frame is mapped with one table
+    const video_tone_table_t* table = video_tone_acquire(tone);
+    if (table->identity) {
+        video_tone_release(tone, table);
+        return;
+    }
+
+    for (uint16_t row = 0; row < image->height; row++) {
+        uint8_t* p = video_image_row(image, row);
+
+        switch (image->format) {
+            case VIDEO_PIXEL_UYVY:
+                map_uyvy(table, p, image->width);
+                break;
+
+            case VIDEO_PIXEL_GRAY:
+                map_luma(table, p, image->width);
+                break;
+
+            case VIDEO_PIXEL_YUYV:
+                for (uint16_t x = 0; x + 1 < image->width; x += 2, p += 4) {
+                    p[0] = table->luma_lut[p[0]];
+                    p[1] = table->chroma_lut[p[1]];
+                    p[2] = table->luma_lut[p[2]];
+                    p[3] = table->chroma_lut[p[3]];
+                }
+                break;
+
+            default:
+                row = image->height;
+                break;
+        }
+    }
+
+    video_tone_release(tone, table);
+}
+
+// Copy the rows when the stage has its own output, then map them while in cache
+void video_tone_strip(const video_image_t* src, const video_image_t* dst,
+                      uint16_t first_row, uint16_t rows, void* user) {
+    video_image_t out = video_image_rows(dst, first_row, rows);
+    if (src->data != dst->data) {
+        video_image_t in = video_image_rows(src, first_row, rows);
+        video_image_copy(&in, &out);
+    }
+    video_tone_apply_image((video_tone_t*)user, &out);
+}
@@ -0,0 +1,89 @@
+#ifndef VIDEO_TONE_H
+#define VIDEO_TONE_H
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "video_image.h"
+#include "video_strip.h"
+
+// ============================================================================
+// Tone Curve Configuration
+// ============================================================================
+
+// Neutral parameter values
+#define VIDEO_TONE_NEUTRAL         128       // Brightness/contrast/saturation midpoint
+#define VIDEO_TONE_GAMMA_LINEAR    10        // Gamma in tenths (10 = 1.0)
+
+// ============================================================================
+// Data Structures
+// ============================================================================
+
+// Tone curve parameters (same units as video_processing_config_t)
+typedef struct {
+    uint8_t brightness;            // Luma offset, 128 = none
+    uint8_t contrast;              // Luma gain around mid-grey, 128 = 1.0x
+    uint8_t saturation;            // Chroma gain around 128, 128 = 1.0x
+    uint8_t gamma;                 // Gamma in tenths, 10 = linear
+} video_tone_params_t;
+
+// Precomputed tone tables
+typedef struct {
+    uint8_t luma_lut[256];         // Y lookup table
+    uint8_t chroma_lut[256];       // Cb/Cr lookup table
+    video_tone_params_t params;    // Parameters the tables were built from
+    bool identity;                 // Tables are a no-op, skip the pass
+} video_tone_table_t;
+
+// Tone curve stage with double-buffered tables
+// New parameters are built into the idle table and published with a single
+// atomic store, so a line being mapped never sees a half-rebuilt table.
+// Consumers hold a table between acquire and release. While one still holds
+// the idle table (it acquired it before the last swap), a change waits as
+// pending and is built by the next set_params or update call after release.
+typedef struct {
+    video_tone_table_t tables[2];
+    volatile uint8_t active;       // Index of the table consumers read
+    volatile uint32_t readers[2];  // Consumers holding each table
+    volatile uint32_t pending;     // Latest requested parameters, packed (see set_params)
+    volatile uint8_t building;     // A rebuild is in progress (one builder at a time)
+    uint32_t generation;           // Incremented on every table rebuild
+} video_tone_t;
+
+// ============================================================================
+// Function Prototypes
+// ============================================================================
+
+// Core tone curve functions. set_params returns true once the new tables are
+// live, false if nothing changed or the change is pending; call update (e.g.
+// once per frame) to publish a pending change.
+void video_tone_init(video_tone_t* tone, const video_tone_params_t* params);
+bool video_tone_set_params(video_tone_t* tone, const video_tone_params_t* params);
+bool video_tone_update(video_tone_t* tone);
+bool video_tone_is_pending(video_tone_t* tone);
+
+// Hold the live table while using it directly; every acquire needs a release
+const video_tone_table_t* video_tone_acquire(video_tone_t* tone);
+void video_tone_release(video_tone_t* tone, const video_tone_table_t* table);
+
+// Per-line application
+void video_tone_apply_uyvy(video_tone_t* tone, uint8_t* uyvy, uint16_t width);
+void video_tone_apply_luma(video_tone_t* tone, uint8_t* luma, size_t count);
+void video_tone_apply_image(video_tone_t* tone, const video_image_t* image);
+
+// Strip stage for video_strip_add_stage() (no context); user is the video_tone_t
+void video_tone_strip(const video_image_t* src, const video_image_t* dst,
+                      uint16_t first_row, uint16_t rows, void* user);
+
+// ============================================================================
+// Default Configuration
+// ============================================================================
+
+static const video_tone_params_t VIDEO_TONE_DEFAULT_PARAMS = {
+    .brightness = VIDEO_TONE_NEUTRAL,
+    .contrast = VIDEO_TONE_NEUTRAL,
+    .saturation = VIDEO_TONE_NEUTRAL,
+    .gamma = VIDEO_TONE_GAMMA_LINEAR
+};
+
+#endif // VIDEO_TONE_H